@@ -0,0 +1,54 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+/// Micro-benchmark for compressing a multi-megabyte payload with [GZipCodec]
+/// on one and on several threads.
+
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+const payloadSize = 8 * 1024 * 1024;
+
+/// Text-like data that compresses about as well as a typical HTTP response.
+Uint8List makePayload() {
+  final random = math.Random(42);
+  final words = List.generate(
+    512,
+    (_) => List.generate(3 + random.nextInt(8), (_) => 97 + random.nextInt(26)),
+  );
+  final payload = Uint8List(payloadSize);
+  int position = 0;
+  while (position < payloadSize) {
+    for (final byte in words[random.nextInt(words.length)]) {
+      if (position == payloadSize) break;
+      payload[position++] = byte;
+    }
+    if (position < payloadSize) payload[position++] = 32;
+  }
+  return payload;
+}
+
+class GZipEncodeBenchmark extends BenchmarkBase {
+  final Uint8List payload;
+  final GZipCodec codec;
+
+  GZipEncodeBenchmark(this.payload, int threads)
+    : codec = GZipCodec(threads: threads),
+      super('GZipEncode.Threads$threads');
+
+  @override
+  void run() {
+    codec.encode(payload);
+  }
+}
+
+void main() {
+  final payload = makePayload();
+  for (final threads in {1, 4, Platform.numberOfProcessors}) {
+    GZipEncodeBenchmark(payload, threads).report();
+  }
+}
@@ -8,6 +8,7 @@
 // @dart=2.9
 
 import 'dart:async';
+import 'dart:developer';
 import 'dart:typed_data';
 import 'dart:math' as math;
 import 'dart:isolate';
@@ -37,6 +38,72 @@ main() async {
 
   final stats = await statsFuture;
   stats.report('IsolateSendExitLatency');
+
+  // The same amount of objects, sent by several isolates at the same time.
+  for (final senders in const [1, 4, 16, 64]) {
+    await measureConcurrentExits(senders);
+  }
+
+  // How long it takes until results of different shapes arrive.
+  await measureExitTime('Objects', () => List.generate(count, (_) => Object()));
+  await measureExitTime('Doubles', () => List.generate(count, (i) => i + 0.5));
+  await measureExitTime('Points', () => List.generate(count, (i) => Point(i)));
+  await measureExitTime('Strings', () => List.generate(count, (i) => '$i'));
+  await measureExitTime(
+    'Maps',
+    () => List.generate(count ~/ 10, (i) => {i: i}),
+  );
+}
+
+const int count = 1000 * 1000;
+
+class Point {
+  final double x;
+  final double y;
+
+  Point(int i) : x = i.toDouble(), y = -i.toDouble();
+}
+
+Future<void> measureExitTime(String name, List Function() build) async {
+  const rounds = 5;
+  int total = 0;
+  for (int i = 0; i < rounds; i++) {
+    final rp = ReceivePort();
+    final sp = rp.sendPort;
+    await Isolate.spawn((_) {
+      final value = build();
+      Isolate.exit(sp, [Timeline.now, value]);
+    }, null);
+    final result = await rp.first as List;
+    total += Timeline.now - (result[0] as int);
+  }
+  final average = total / rounds / 1000;
+  print('IsolateSendExitLatency.Exit$name(RunTimeRaw): $average ms.');
+}
+
+Future<void> measureConcurrentExits(int senders) async {
+  final statsFuture = measureEventLoopLatency(
+    const Duration(milliseconds: 1),
+    4000,
+  );
+
+  final objectsPerSender = 10 * 1000 * 1000 ~/ senders;
+  final results = await Future.wait([
+    for (int i = 0; i < senders; i++)
+      compute(() {
+        final l = <dynamic>[];
+        for (int j = 0; j < objectsPerSender; ++j) {
+          l.add(Object());
+        }
+        return l;
+      }),
+  ]);
+  for (final result in results) {
+    if (result.length != objectsPerSender) throw 'failed';
+  }
+
+  final stats = await statsFuture;
+  stats.report('IsolateSendExitLatency.Senders$senders');
 }
 
 Future<T> compute<T>(T Function() fun) {
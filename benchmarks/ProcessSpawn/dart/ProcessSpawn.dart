@@ -0,0 +1,51 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measures the latency of Process.run while the spawning process has a large
+// resident heap, which makes starting processes with fork expensive.
+//
+// Usage: ProcessSpawn.dart [heap size in MB, default 512]
+
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+const int numberOfRuns = 200;
+
+Future<void> main(List<String> args) async {
+  final heapMB = args.isEmpty ? 512 : int.parse(args[0]);
+  // Touch every page so that it is resident.
+  final heap = <Uint8List>[];
+  for (int i = 0; i < heapMB; i++) {
+    heap.add(Uint8List(1024 * 1024)..fillRange(0, 1024 * 1024, i));
+  }
+
+  final executable = Platform.isWindows ? 'cmd' : 'true';
+  final arguments = Platform.isWindows ? ['/c', 'exit'] : <String>[];
+  final latencies = Uint64List(numberOfRuns);
+  final sw = Stopwatch()..start();
+  for (int i = 0; i < numberOfRuns; i++) {
+    final start = sw.elapsedMicroseconds;
+    final result = await Process.run(executable, arguments);
+    latencies[i] = sw.elapsedMicroseconds - start;
+    if (result.exitCode != 0) throw 'Unexpected exit code ${result.exitCode}';
+  }
+  // Keep the heap alive until the end.
+  if (heap.length != heapMB) throw 'Unreachable';
+
+  report('ProcessSpawn', latencies);
+}
+
+void report(String name, Uint64List latencies) {
+  latencies.sort();
+  final length = latencies.length;
+  final double avg = latencies.fold(0, (int a, int b) => a + b) / length;
+  print('$name.Min(RunTimeRaw): ${latencies.first / 1000} ms.');
+  print('$name.Avg(RunTimeRaw): ${avg / 1000} ms.');
+  for (final percentile in const [50, 90, 99]) {
+    final value = latencies[math.min(percentile * length ~/ 100, length - 1)];
+    print('$name.Percentile$percentile(RunTimeRaw): ${value / 1000} ms.');
+  }
+  print('$name.Max(RunTimeRaw): ${latencies.last / 1000} ms.');
+}
@@ -7,6 +7,7 @@
 import 'dart:async';
 import 'dart:convert';
 import 'dart:isolate';
+import 'dart:typed_data';
 
 // (Same data as used in our other Json* benchmarks)
 final data =
@@ -254,9 +255,78 @@ Future<void> main(args) async {
     BenchmarkConfig('BinaryTree.10', generateBinaryTreeOfDepth(10)),
     BenchmarkConfig('BinaryTree.12', generateBinaryTreeOfDepth(12)),
     BenchmarkConfig('BinaryTree.14', generateBinaryTreeOfDepth(14)),
+    BenchmarkConfig('Uint8List.1MB', Uint8List(1024 * 1024)),
+    BenchmarkConfig('Uint8List.16MB', Uint8List(16 * 1024 * 1024)),
+    BenchmarkConfig('Uint8List.128MB', Uint8List(128 * 1024 * 1024)),
+    BenchmarkConfig('MapOfUint8Lists.64MB', {
+      for (int i = 0; i < 64; i++) '$i': Uint8List(1024 * 1024),
+    }),
   ];
 
   for (final config in configs) {
     await SendPortBenchmark(config).report();
   }
+
+  for (final senders in const [1, 2, 4, 8, 16, 32, 64]) {
+    await SendPortContentionBenchmark(senders).report();
+  }
+}
+
+// Measures the cost of sending small messages while [senders] isolates are
+// sending at the same time, each to its own port.
+class SendPortContentionBenchmark {
+  static const int messagesPerSender = 100000;
+
+  final int senders;
+
+  SendPortContentionBenchmark(this.senders);
+
+  Future report() async {
+    final results = ReceivePort();
+    final ready = <SendPort>[];
+    final elapsedUs = <int>[];
+    final done = Completer<void>();
+    results.listen((message) {
+      if (message is SendPort) {
+        ready.add(message);
+        // Start all senders at once, after they have been spawned.
+        if (ready.length == senders) {
+          for (final sendPort in ready) {
+            sendPort.send(null);
+          }
+        }
+      } else {
+        elapsedUs.add(message as int);
+        if (elapsedUs.length == senders) done.complete();
+      }
+    });
+    for (int i = 0; i < senders; i++) {
+      await Isolate.spawn(sendMessages, results.sendPort);
+    }
+    await done.future;
+    results.close();
+
+    final usPerSend =
+        elapsedUs.reduce((a, b) => a + b) / (senders * messagesPerSender);
+    print('SendPort.Contention.Senders$senders(RunTimeRaw): $usPerSend us.');
+  }
+
+  static void sendMessages(SendPort results) {
+    final start = RawReceivePort();
+    start.handler = (_) {
+      start.close();
+      final port = RawReceivePort();
+      int received = 0;
+      port.handler = (_) {
+        if (++received == messagesPerSender) port.close();
+      };
+      final sendPort = port.sendPort;
+      final sw = Stopwatch()..start();
+      for (int i = 0; i < messagesPerSender; i++) {
+        sendPort.send(i);
+      }
+      results.send(sw.elapsedMicroseconds);
+    };
+    results.send(start.sendPort);
+  }
 }
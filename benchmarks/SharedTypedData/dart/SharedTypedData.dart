@@ -0,0 +1,109 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measures sending large typed data to a worker isolate and back, comparing
+// ordinary typed data, which is copied, with shared typed data, which is sent
+// by reference.
+
+import 'dart:async';
+import 'dart:concurrent';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+class SendReceiveTypedData extends AsyncBenchmarkBase {
+  SendReceiveTypedData(String name, this.data) : super(name);
+
+  @override
+  Future<void> run() async {
+    await helper.run(data);
+  }
+
+  @override
+  Future<void> setup() async {
+    helper = SendReceiveHelper();
+    await helper.setup();
+  }
+
+  @override
+  Future<void> teardown() async {
+    await helper.finalize();
+  }
+
+  late SendReceiveHelper helper;
+  TypedData data;
+}
+
+class SendReceiveHelper {
+  Future<void> setup() async {
+    final port = ReceivePort();
+    inbox = StreamIterator<dynamic>(port);
+    workerExitedPort = ReceivePort();
+    await Isolate.spawn(
+      isolate,
+      port.sendPort,
+      onExit: workerExitedPort.sendPort,
+    );
+    await inbox.moveNext();
+    outbox = inbox.current;
+  }
+
+  Future<void> finalize() async {
+    outbox.send(null);
+    await workerExitedPort.first;
+    workerExitedPort.close();
+    await inbox.cancel();
+  }
+
+  // Send the data to the worker, get it back, repeat a few times.
+  Future<void> run(TypedData data) async {
+    for (int i = 0; i < 5; i++) {
+      outbox.send(data);
+      await inbox.moveNext();
+      data = inbox.current;
+    }
+  }
+
+  late StreamIterator<dynamic> inbox;
+  late SendPort outbox;
+  late ReceivePort workerExitedPort;
+}
+
+Future<void> isolate(SendPort sendPort) async {
+  final port = ReceivePort();
+  final inbox = StreamIterator<dynamic>(port);
+
+  sendPort.send(port.sendPort);
+  while (true) {
+    await inbox.moveNext();
+    final received = inbox.current;
+    if (received == null) {
+      break;
+    }
+    sendPort.send(received);
+  }
+  port.close();
+}
+
+Future<void> main() async {
+  for (final size in [1024, 1024 * 1024, 16 * 1024 * 1024]) {
+    await SendReceiveTypedData(
+      'SharedTypedData.Uint8List.Copied.$size',
+      Uint8List(size),
+    ).report();
+    await SendReceiveTypedData(
+      'SharedTypedData.Uint8List.Shared.$size',
+      SharedTypedData.uint8List(size),
+    ).report();
+    await SendReceiveTypedData(
+      'SharedTypedData.Float64List.Copied.$size',
+      Float64List(size ~/ 8),
+    ).report();
+    await SendReceiveTypedData(
+      'SharedTypedData.Float64List.Shared.$size',
+      SharedTypedData.float64List(size ~/ 8),
+    ).report();
+  }
+}
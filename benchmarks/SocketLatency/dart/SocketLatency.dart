@@ -0,0 +1,100 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measures the round trip latency of small messages over loopback TCP
+// connections while many isolates keep the event handler busy.
+//
+// Run with --event_handler_threads=<n> to compare a sharded event handler
+// against the default single event handler thread.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+const int numberOfIsolates = 16;
+const int connectionsPerIsolate = 8;
+const int roundTripsPerConnection = 1000;
+
+Future<void> main() async {
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((Socket socket) {
+    socket.setOption(SocketOption.tcpNoDelay, true);
+    socket.listen(socket.add, onDone: socket.destroy);
+  });
+
+  final results = ReceivePort();
+  for (int i = 0; i < numberOfIsolates; i++) {
+    await Isolate.spawn(run, [server.port, results.sendPort]);
+  }
+
+  final latencies = Uint64List(
+    numberOfIsolates * connectionsPerIsolate * roundTripsPerConnection,
+  );
+  int index = 0;
+  await for (final Uint64List result in results) {
+    latencies.setRange(index, index + result.length, result);
+    index += result.length;
+    if (index == latencies.length) break;
+  }
+  results.close();
+  await server.close();
+
+  report('SocketLatency', latencies);
+}
+
+Future<void> run(List args) async {
+  final int port = args[0];
+  final SendPort sendPort = args[1];
+  final futures = <Future<Uint64List>>[];
+  for (int i = 0; i < connectionsPerIsolate; i++) {
+    futures.add(pingPong(port));
+  }
+  for (final latencies in await Future.wait(futures)) {
+    sendPort.send(latencies);
+  }
+}
+
+Future<Uint64List> pingPong(int port) async {
+  final socket = await Socket.connect(InternetAddress.loopbackIPv4, port);
+  socket.setOption(SocketOption.tcpNoDelay, true);
+  final latencies = Uint64List(roundTripsPerConnection);
+  final message = Uint8List(64);
+  final sw = Stopwatch()..start();
+  final done = Completer<void>();
+  int received = 0;
+  int index = 0;
+  int start = sw.elapsedMicroseconds;
+
+  socket.listen((data) {
+    received += data.length;
+    if (received < message.length) return;
+    received -= message.length;
+    latencies[index++] = sw.elapsedMicroseconds - start;
+    if (index == roundTripsPerConnection) {
+      done.complete();
+      return;
+    }
+    start = sw.elapsedMicroseconds;
+    socket.add(message);
+  });
+  socket.add(message);
+  await done.future;
+  await socket.close();
+  return latencies;
+}
+
+void report(String name, Uint64List latencies) {
+  latencies.sort();
+  final length = latencies.length;
+  final double avg = latencies.fold(0, (int a, int b) => a + b) / length;
+  print('$name.Min(RunTimeRaw): ${latencies.first / 1000} ms.');
+  print('$name.Avg(RunTimeRaw): ${avg / 1000} ms.');
+  for (final percentile in const [50, 90, 95, 99]) {
+    final value = latencies[math.min(percentile * length ~/ 100, length - 1)];
+    print('$name.Percentile$percentile(RunTimeRaw): ${value / 1000} ms.');
+  }
+  print('$name.Max(RunTimeRaw): ${latencies.last / 1000} ms.');
+}
@@ -2158,6 +2158,16 @@ class TypeFlowAnalysis
 
   Call? callSite(TreeNode node) => summaryCollector.callSites[node];
 
+  /// Makes [newNode], which replaces [oldNode] in the AST, refer to the call
+  /// site of [oldNode].
+  void replaceCallSite(TreeNode oldNode, TreeNode newNode) {
+    final callSites = summaryCollector.callSites;
+    final callSite = callSites.remove(oldNode);
+    if (callSite != null) {
+      callSites[newNode] = callSite;
+    }
+  }
+
   TypeCheck? explicitCast(AsExpression cast) =>
       summaryCollector.explicitCasts[cast];
 
@@ -409,6 +409,7 @@ class Call extends Statement {
 
   int _flags = 0;
   Type _resultType = emptyType;
+  Type _dynamicReceiverType = emptyType;
 
   static const int kMonomorphic = (1 << 0);
   static const int kPolymorphic = (1 << 1);
@@ -441,6 +442,9 @@ class Call extends Statement {
 
   Type get resultType => _resultType;
 
+  /// Union of receiver types observed at a call with [DynamicSelector].
+  Type get dynamicReceiverType => _dynamicReceiverType;
+
   void setUseCheckedEntry() {
     _flags |= kUseCheckedEntry;
   }
@@ -479,6 +483,12 @@ class Call extends Statement {
     if (receiver is NullableType) {
       _flags |= kNullableReceiver;
     }
+    if (selector is DynamicSelector) {
+      _dynamicReceiverType = _dynamicReceiverType.union(
+        receiver,
+        typeHierarchy,
+      );
+    }
     if (!receiverMayBeInt) {
       final receiverIntIntersect = receiver.intersection(
         typeHierarchy.intType,
@@ -18,6 +18,7 @@ import 'package:kernel/clone.dart' show CloneVisitorNotMembers;
 import 'package:kernel/core_types.dart' show CoreTypes;
 import 'package:kernel/library_index.dart' show LibraryIndex;
 import 'package:kernel/target/targets.dart';
+import 'package:kernel/type_algebra.dart' show containsFreeTypeParameters;
 import 'package:kernel/type_environment.dart';
 import 'package:vm/metadata/closure_id.dart';
 import 'package:vm/metadata/direct_call.dart';
@@ -645,11 +646,19 @@ class AnnotateKernel extends RecursiveVisitor {
     }
 
     // Tell the table selector assigner about the callsite.
+    // Dynamic calls which the tree shaker turned into interface calls are
+    // registered through their new interface target.
     final Selector selector = callSite.selector;
-    if (selector is InterfaceSelector && !_callSiteUsesDirectCall(node)) {
+    Member? tableTarget;
+    if (selector is InterfaceSelector) {
+      tableTarget = selector.member;
+    } else if (selector is DynamicSelector) {
+      tableTarget = interfaceTarget;
+    }
+    if (tableTarget != null && !_callSiteUsesDirectCall(node)) {
       if (node is InstanceGet || node is InstanceTearOff) {
         _tableSelectorAssigner.registerGetterCall(
-          selector.member,
+          tableTarget,
           callSite.isNullableReceiver,
         );
       } else {
@@ -659,7 +668,7 @@ class AnnotateKernel extends RecursiveVisitor {
               node is InstanceSet,
         );
         _tableSelectorAssigner.registerMethodOrSetterCall(
-          selector.member,
+          tableTarget,
           callSite.isNullableReceiver,
         );
       }
@@ -1330,6 +1339,100 @@ class _TreeShakerPass1 extends RemovingTransformer {
     return args;
   }
 
+  /// Returns the member which every receiver of the polymorphic dynamic call
+  /// [node] inherits from a common supertype, or null if there is no such
+  /// member or receivers are not known precisely. Calls through this member
+  /// can use the dispatch table instead of a dynamic lookup.
+  Member? _dynamicCallInterfaceTarget(
+    TreeNode node,
+    Name name, {
+    bool setter = false,
+  }) {
+    if (name.text == 'call' || name.text == '==') return null;
+    final callSite = shaker.typeFlowAnalysis.callSite(node);
+    if (callSite == null || !callSite.isPolymorphic) return null;
+    final receiver = callSite.dynamicReceiverType;
+    final List<TFClass> classes;
+    if (receiver is ConcreteType) {
+      classes = [receiver.cls];
+    } else if (receiver is SetType) {
+      classes = [for (final type in receiver.types) type.cls];
+    } else if (receiver is ConeType) {
+      classes = [receiver.cls];
+    } else {
+      return null;
+    }
+    Set<TFClass>? supertypes;
+    for (final cls in classes) {
+      if (cls.isRecord || cls.hasDynamicallyExtendableSubtypes) return null;
+      if (supertypes == null) {
+        supertypes = cls.supertypes.toSet();
+      } else {
+        supertypes.retainAll(cls.supertypes);
+      }
+    }
+    TFClass? best;
+    Member? target;
+    for (final cls in supertypes!) {
+      if (best != null &&
+          (cls.supertypes.length < best.supertypes.length ||
+              (cls.supertypes.length == best.supertypes.length &&
+                  cls.id > best.id))) {
+        continue;
+      }
+      final member = environment.hierarchy.getInterfaceMember(
+        cls.classNode,
+        name,
+        setter: setter,
+      );
+      if (member != null) {
+        best = cls;
+        target = member;
+      }
+    }
+    return target;
+  }
+
+  bool _isStaticSubtype(Expression arg, DartType type) =>
+      environment.isSubtypeOf(
+        arg.getStaticType(staticTypeContext),
+        type,
+        SubtypeCheckMode.withNullabilities,
+      );
+
+  /// Returns true if [args] are accepted by [function] without checks of
+  /// parameter types at run time.
+  bool _argumentsMatch(FunctionNode function, Arguments args) {
+    if (args.types.isNotEmpty || function.typeParameters.isNotEmpty) {
+      return false;
+    }
+    final positional = args.positional;
+    if (positional.length < function.requiredParameterCount ||
+        positional.length > function.positionalParameters.length) {
+      return false;
+    }
+    for (int i = 0; i < positional.length; i++) {
+      if (!_isStaticSubtype(
+        positional[i],
+        function.positionalParameters[i].type,
+      )) {
+        return false;
+      }
+    }
+    int numRequiredNamed = 0;
+    for (final param in function.namedParameters) {
+      if (param.isRequired) numRequiredNamed++;
+    }
+    for (final arg in args.named) {
+      final param = findNamedParameter(function, arg.name);
+      if (param == null || !_isStaticSubtype(arg.value, param.type)) {
+        return false;
+      }
+      if (param.isRequired) numRequiredNamed--;
+    }
+    return numRequiredNamed == 0;
+  }
+
   bool _isThrowExpression(Expression expr) {
     for (;;) {
       if (expr is Let) {
@@ -1542,6 +1645,30 @@ class _TreeShakerPass1 extends RemovingTransformer {
         _flattenArguments(node.arguments, receiver: node.receiver),
       );
     }
+    if (node.kind == DynamicAccessKind.Dynamic && !node.isImplicitCall) {
+      final target = _dynamicCallInterfaceTarget(node, node.name);
+      if (target is Procedure &&
+          target.kind == ProcedureKind.Method &&
+          _argumentsMatch(target.function, node.arguments)) {
+        final functionType = target.function.computeThisFunctionType(
+          Nullability.nonNullable,
+        );
+        if (!containsFreeTypeParameters(functionType)) {
+          final result = InstanceInvocation(
+            InstanceAccessKind.Instance,
+            node.receiver,
+            node.name,
+            node.arguments,
+            interfaceTarget:
+                fieldMorpher.adjustInstanceCallTarget(target) as Procedure,
+            functionType: functionType,
+          )..fileOffset = node.fileOffset;
+          shaker.typeFlowAnalysis.replaceCallSite(node, result);
+          shaker.addUsedMember(result.interfaceTarget);
+          return result;
+        }
+      }
+    }
     return node;
   }
 
@@ -1634,9 +1761,39 @@ class _TreeShakerPass1 extends RemovingTransformer {
     node.transformOrRemoveChildren(this);
     if (_isUnreachable(node)) {
       return _makeUnreachableCall([node.receiver]);
-    } else {
-      return node;
     }
+    if (node.kind == DynamicAccessKind.Dynamic) {
+      final target = _dynamicCallInterfaceTarget(node, node.name);
+      if (target != null && !containsFreeTypeParameters(target.getterType)) {
+        final Member adjustedTarget = fieldMorpher.adjustInstanceCallTarget(
+          target,
+        )!;
+        final Expression result;
+        if (adjustedTarget is Procedure &&
+            adjustedTarget.kind == ProcedureKind.Method) {
+          result = InstanceTearOff(
+            InstanceAccessKind.Instance,
+            node.receiver,
+            node.name,
+            interfaceTarget: adjustedTarget,
+            resultType: target.getterType,
+          );
+        } else {
+          result = InstanceGet(
+            InstanceAccessKind.Instance,
+            node.receiver,
+            node.name,
+            interfaceTarget: adjustedTarget,
+            resultType: target.getterType,
+          );
+        }
+        result.fileOffset = node.fileOffset;
+        shaker.typeFlowAnalysis.replaceCallSite(node, result);
+        shaker.addUsedMember(adjustedTarget);
+        return result;
+      }
+    }
+    return node;
   }
 
   @override
@@ -1660,9 +1817,32 @@ class _TreeShakerPass1 extends RemovingTransformer {
     node.transformOrRemoveChildren(this);
     if (_isUnreachable(node)) {
       return _makeUnreachableCall([node.receiver, node.value]);
-    } else {
-      return node;
     }
+    if (node.kind == DynamicAccessKind.Dynamic) {
+      final target = _dynamicCallInterfaceTarget(
+        node,
+        node.name,
+        setter: true,
+      );
+      if (target != null &&
+          !containsFreeTypeParameters(target.setterType) &&
+          _isStaticSubtype(node.value, target.setterType)) {
+        final result = InstanceSet(
+          InstanceAccessKind.Instance,
+          node.receiver,
+          node.name,
+          node.value,
+          interfaceTarget: fieldMorpher.adjustInstanceCallTarget(
+            target,
+            isSetter: true,
+          )!,
+        )..fileOffset = node.fileOffset;
+        shaker.typeFlowAnalysis.replaceCallSite(node, result);
+        shaker.addUsedMember(result.interfaceTarget);
+        return result;
+      }
+    }
+    return node;
   }
 
   @override
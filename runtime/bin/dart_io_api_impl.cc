@@ -7,6 +7,7 @@
 #include "bin/crypto.h"
 #include "bin/directory.h"
 #include "bin/eventhandler.h"
+#include "bin/io_buffer.h"
 #include "bin/io_natives.h"
 #include "bin/platform.h"
 #include "bin/process.h"
@@ -22,6 +23,7 @@ namespace bin {
 void BootstrapDartIo() {
   // Bootstrap 'dart:io' event handler.
   TimerUtils::InitOnce();
+  IOBuffer::InitPool();
   Process::Init();
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLFilter::Init();
@@ -36,6 +38,7 @@ void CleanupDartIo() {
   SSLFilter::Cleanup();
 #endif
   Process::Cleanup();
+  IOBuffer::CleanupPool();
 }
 
 void SetSystemTempDirectory(const char* system_temp) {
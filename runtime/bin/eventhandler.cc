@@ -18,6 +18,9 @@ namespace bin {
 static EventHandler* event_handler = nullptr;
 static Monitor* shutdown_monitor = nullptr;
 
+bool EventHandler::use_io_uring_ = false;
+intptr_t EventHandler::thread_count_ = 1;
+
 void EventHandler::Start() {
   // Initialize global socket registry.
   ListeningSocketRegistry::Initialize();
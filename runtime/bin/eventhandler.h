@@ -636,10 +636,27 @@ class EventHandler {
 
   static void SendFromNative(intptr_t id, Dart_Port port, int64_t data);
 
+  // Whether the event handler batches its epoll registrations through
+  // io_uring. Only has an effect on Linux. Must be set before Start.
+  static bool use_io_uring() { return use_io_uring_; }
+  static void set_use_io_uring(bool use_io_uring) {
+    use_io_uring_ = use_io_uring;
+  }
+
+  // The number of threads the event handler polls on. Only has an effect on
+  // Linux. Must be set before Start.
+  static intptr_t thread_count() { return thread_count_; }
+  static void set_thread_count(intptr_t thread_count) {
+    thread_count_ = thread_count;
+  }
+
  private:
   friend class EventHandlerImplementation;
   EventHandlerImplementation delegate_;
 
+  static bool use_io_uring_;
+  static intptr_t thread_count_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandler);
 };
 
@@ -12,11 +12,18 @@
 #include <fcntl.h>        // NOLINT
 #include <pthread.h>      // NOLINT
 #include <stdio.h>        // NOLINT
+#include <stdlib.h>       // NOLINT
 #include <string.h>       // NOLINT
 #include <sys/epoll.h>    // NOLINT
 #include <sys/stat.h>     // NOLINT
 #include <sys/timerfd.h>  // NOLINT
 #include <unistd.h>       // NOLINT
+#if defined(DART_HOST_OS_LINUX)
+#include <linux/io_uring.h>  // NOLINT
+#include <poll.h>            // NOLINT
+#include <sys/mman.h>        // NOLINT
+#include <sys/syscall.h>     // NOLINT
+#endif
 
 #include "bin/dartutils.h"
 #include "bin/fdutils.h"
@@ -43,20 +50,221 @@ intptr_t DescriptorInfo::GetPollEvents() {
   return events;
 }
 
+#if defined(DART_HOST_OS_LINUX)
+IOUring* IOUring::Create(uint32_t entries) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  int fd = NO_RETRY_EXPECTED(syscall(__NR_io_uring_setup, entries, &params));
+  if (fd == -1) {
+    return nullptr;
+  }
+  IOUring* ring = new IOUring();
+  ring->ring_fd_ = fd;
+  // IORING_OP_EPOLL_CTL was added in Linux 5.6, IORING_FEAT_FAST_POLL in
+  // 5.7. Use the latter to reject kernels without the former.
+  if ((params.features & IORING_FEAT_FAST_POLL) == 0) {
+    delete ring;
+    return nullptr;
+  }
+  ring->sq_ring_size_ =
+      params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  ring->cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    ring->sq_ring_size_ = Utils::Maximum(ring->sq_ring_size_,
+                                         ring->cq_ring_size_);
+    ring->cq_ring_size_ = 0;
+  }
+  void* sq_ring = mmap(nullptr, ring->sq_ring_size_, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (sq_ring == MAP_FAILED) {
+    delete ring;
+    return nullptr;
+  }
+  ring->sq_ring_ = sq_ring;
+  void* cq_ring = sq_ring;
+  if (!single_mmap) {
+    cq_ring = mmap(nullptr, ring->cq_ring_size_, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if (cq_ring == MAP_FAILED) {
+      delete ring;
+      return nullptr;
+    }
+    ring->cq_ring_ = cq_ring;
+  }
+  ring->sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(nullptr, ring->sqes_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    delete ring;
+    return nullptr;
+  }
+  ring->sqes_ = reinterpret_cast<struct io_uring_sqe*>(sqes);
+
+  uint8_t* sq = reinterpret_cast<uint8_t*>(sq_ring);
+  ring->sq_head_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+  ring->sq_tail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+  ring->sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+  ring->sq_mask_ = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+  ring->sq_entries_ = params.sq_entries;
+  uint8_t* cq = reinterpret_cast<uint8_t*>(cq_ring);
+  ring->cq_head_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+  ring->cq_tail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+  ring->cq_mask_ = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+  ring->cqes_ =
+      reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+  ring->events_ = new struct epoll_event[params.sq_entries];
+  return ring;
+}
+
+IOUring::~IOUring() {
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ != nullptr) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_ != nullptr) {
+    munmap(sq_ring_, sq_ring_size_);
+  }
+  delete[] events_;
+  close(ring_fd_);
+}
+
+// The ring indices are shared with the kernel: the kernel advances the
+// submission queue head and the completion queue tail, we advance the
+// submission queue tail and the completion queue head.
+struct io_uring_sqe* IOUring::NextSqe() {
+  const uint32_t head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  const uint32_t tail = *sq_tail_;
+  if (tail - head >= sq_entries_) {
+    return nullptr;
+  }
+  const uint32_t index = tail & sq_mask_;
+  struct io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sq_array_[index] = index;
+  return sqe;
+}
+
+bool IOUring::QueueEpollCtl(int epoll_fd,
+                            int op,
+                            int fd,
+                            const struct epoll_event* event,
+                            uint64_t user_data) {
+  struct io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  const uint32_t tail = *sq_tail_;
+  struct epoll_event* copy = &events_[tail & sq_mask_];
+  *copy = *event;
+  sqe->opcode = IORING_OP_EPOLL_CTL;
+  sqe->fd = epoll_fd;
+  sqe->off = fd;
+  sqe->len = op;
+  sqe->addr = reinterpret_cast<uint64_t>(copy);
+  sqe->user_data = user_data;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+bool IOUring::QueuePoll(int fd, uint32_t poll_mask, uint64_t user_data) {
+  struct io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  sqe->poll_events = poll_mask;
+  sqe->user_data = user_data;
+  __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+bool IOUring::QueueRead(int fd,
+                        void* buffer,
+                        uint32_t length,
+                        uint64_t offset,
+                        uint64_t user_data) {
+  struct io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = fd;
+  sqe->off = offset;
+  sqe->addr = reinterpret_cast<uint64_t>(buffer);
+  sqe->len = length;
+  sqe->user_data = user_data;
+  __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+intptr_t IOUring::Submit(uint32_t min_complete) {
+  const uint32_t to_submit =
+      *sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  const uint32_t flags = (min_complete > 0) ? IORING_ENTER_GETEVENTS : 0;
+  // io_uring_enter only fails with EINTR if nothing was submitted, so it is
+  // safe to retry with the same arguments.
+  return TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
+      syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags,
+              nullptr, 0));
+}
+
+bool IOUring::NextCompletion(uint64_t* user_data, int32_t* result) {
+  const uint32_t head = *cq_head_;
+  if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+    return false;
+  }
+  struct io_uring_cqe* cqe = &cqes_[head & cq_mask_];
+  *user_data = cqe->user_data;
+  *result = cqe->res;
+  __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+// Completion tag of the poll on the epoll instance. DescriptorInfo pointers
+// are used as the tags of epoll_ctl completions, so this never clashes.
+static constexpr uint64_t kEpollFdPolled = 0;
+static constexpr uint32_t kIOUringEntries = 64;
+#endif  // defined(DART_HOST_OS_LINUX)
+
 // Unregister the file descriptor for a DescriptorInfo structure with
 // epoll.
-static void RemoveFromEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
+void EventHandlerImplementation::RemoveFromEpollInstance(DescriptorInfo* di) {
+#if defined(DART_HOST_OS_LINUX)
+  // Registrations of this descriptor may still be queued. They must not be
+  // applied after it has been removed (and possibly closed and deleted).
+  if (pending_registrations_ > 0) {
+    FlushPendingRegistrations();
+  }
+#endif
   VOID_NO_RETRY_EXPECTED(
       epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, di->fd(), nullptr));
 }
 
-static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
+void EventHandlerImplementation::AddToEpollInstance(DescriptorInfo* di) {
   struct epoll_event event;
   event.events = EPOLLRDHUP | di->GetPollEvents();
   if (!di->IsListeningSocket()) {
     event.events |= EPOLLET;
   }
   event.data.ptr = di;
+#if defined(DART_HOST_OS_LINUX)
+  if (uring_ != nullptr) {
+    // Submitted with the next wait, see PollWithIOUring. Failures are
+    // handled in HandleCompletions.
+    if (uring_->QueueEpollCtl(epoll_fd_, EPOLL_CTL_ADD, di->fd(), &event,
+                              reinterpret_cast<uint64_t>(di))) {
+      pending_registrations_++;
+      return;
+    }
+    // The submission queue is full. Keep the registrations in order.
+    FlushPendingRegistrations();
+  }
+#endif
   int status =
       NO_RETRY_EXPECTED(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, di->fd(), &event));
   if (status == -1) {
@@ -70,6 +278,58 @@ static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
   }
 }
 
+#if defined(DART_HOST_OS_LINUX)
+void EventHandlerImplementation::HandleCompletions() {
+  uint64_t user_data;
+  int32_t result;
+  while (uring_->NextCompletion(&user_data, &result)) {
+    if (user_data == kEpollFdPolled) {
+      epoll_fd_polled_ = false;
+      continue;
+    }
+    pending_registrations_--;
+    if (result < 0) {
+      // See AddToEpollInstance.
+      DescriptorInfo* di = reinterpret_cast<DescriptorInfo*>(user_data);
+      di->NotifyAllDartPorts(1 << kCloseEvent);
+    }
+  }
+}
+
+void EventHandlerImplementation::FlushPendingRegistrations() {
+  while (pending_registrations_ > 0) {
+    if (uring_->Submit(1) < 0) {
+      FATAL("io_uring_enter failed: %s", strerror(errno));
+    }
+    HandleCompletions();
+  }
+}
+
+intptr_t EventHandlerImplementation::PollWithIOUring(
+    struct epoll_event* events,
+    intptr_t max_events) {
+  if (!epoll_fd_polled_) {
+    if (!uring_->QueuePoll(epoll_fd_, POLLIN, kEpollFdPolled)) {
+      FlushPendingRegistrations();
+      bool queued = uring_->QueuePoll(epoll_fd_, POLLIN, kEpollFdPolled);
+      ASSERT(queued);
+    }
+    epoll_fd_polled_ = true;
+  }
+  // Submit the registrations queued while handling the previous events
+  // and wait for the epoll instance to become readable in one system call.
+  if (uring_->Submit(1) < 0) {
+    return -1;
+  }
+  HandleCompletions();
+  if (epoll_fd_polled_) {
+    // Only registrations completed.
+    return 0;
+  }
+  return NO_RETRY_EXPECTED(epoll_wait(epoll_fd_, events, max_events, 0));
+}
+#endif  // defined(DART_HOST_OS_LINUX)
+
 EventHandlerImplementation::EventHandlerImplementation()
     : socket_map_(&SimpleHashMap::SamePointerValue, 16) {
   intptr_t result;
@@ -119,6 +379,20 @@ EventHandlerImplementation::EventHandlerImplementation()
     FATAL("Failed adding timerfd fd(%i) to epoll instance: %i", timer_fd_,
           errno);
   }
+#if defined(DART_HOST_OS_LINUX)
+  uring_ = nullptr;
+  pending_registrations_ = 0;
+  epoll_fd_polled_ = false;
+  // Falls back to plain epoll if io_uring is not available.
+  if (EventHandler::use_io_uring()) {
+    uring_ = IOUring::Create(kIOUringEntries);
+  }
+#endif
+  shards_ = nullptr;
+  shard_count_ = 1;
+  primary_ = nullptr;
+  shards_monitor_ = nullptr;
+  running_shards_ = 0;
 }
 
 static void DeleteDescriptorInfo(void* info) {
@@ -129,6 +403,9 @@ static void DeleteDescriptorInfo(void* info) {
 
 EventHandlerImplementation::~EventHandlerImplementation() {
   socket_map_.Clear(DeleteDescriptorInfo);
+#if defined(DART_HOST_OS_LINUX)
+  delete uring_;
+#endif
   close(epoll_fd_);
   close(timer_fd_);
   close(interrupt_fds_[0]);
@@ -139,13 +416,13 @@ void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
                                                      DescriptorInfo* di) {
   intptr_t new_mask = di->Mask();
   if ((old_mask != 0) && (new_mask == 0)) {
-    RemoveFromEpollInstance(epoll_fd_, di);
+    RemoveFromEpollInstance(di);
   } else if ((old_mask == 0) && (new_mask != 0)) {
-    AddToEpollInstance(epoll_fd_, di);
+    AddToEpollInstance(di);
   } else if ((old_mask != 0) && (new_mask != 0) && (old_mask != new_mask)) {
     ASSERT(!di->IsListeningSocket());
-    RemoveFromEpollInstance(epoll_fd_, di);
-    AddToEpollInstance(epoll_fd_, di);
+    RemoveFromEpollInstance(di);
+    AddToEpollInstance(di);
   }
 }
 
@@ -388,31 +665,111 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
   }
 }
 
-void EventHandlerImplementation::Poll(uword args) {
+void EventHandlerImplementation::Run() {
   ThreadSignalBlocker signal_blocker(SIGPROF);
   const intptr_t kMaxEvents = 16;
   struct epoll_event events[kMaxEvents];
-  EventHandler* handler = reinterpret_cast<EventHandler*>(args);
-  EventHandlerImplementation* handler_impl = &handler->delegate_;
-  ASSERT(handler_impl != nullptr);
 
-  while (!handler_impl->shutdown_) {
-    intptr_t result = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
-        epoll_wait(handler_impl->epoll_fd_, events, kMaxEvents, -1));
+  while (!shutdown_) {
+    intptr_t result;
+#if defined(DART_HOST_OS_LINUX)
+    if (uring_ != nullptr) {
+      result = PollWithIOUring(events, kMaxEvents);
+    } else {
+      result = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
+          epoll_wait(epoll_fd_, events, kMaxEvents, -1));
+    }
+#else
+    result = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
+        epoll_wait(epoll_fd_, events, kMaxEvents, -1));
+#endif
     ASSERT(EAGAIN == EWOULDBLOCK);
-    if (result <= 0) {
+    if (result < 0) {
       if (errno != EWOULDBLOCK) {
         perror("Poll failed");
       }
-    } else {
-      handler_impl->HandleEvents(events, result);
+    } else if (result > 0) {
+      HandleEvents(events, result);
     }
   }
+}
+
+void EventHandlerImplementation::Poll(uword args) {
+  EventHandler* handler = reinterpret_cast<EventHandler*>(args);
+  EventHandlerImplementation* handler_impl = &handler->delegate_;
+  ASSERT(handler_impl != nullptr);
+  handler_impl->Run();
+  handler_impl->ShutdownShards();
   DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
   handler->NotifyShutdownDone();
 }
 
+void EventHandlerImplementation::PollShard(uword args) {
+  EventHandlerImplementation* shard =
+      reinterpret_cast<EventHandlerImplementation*>(args);
+  shard->Run();
+  EventHandlerImplementation* primary = shard->primary_;
+  MonitorLocker ml(primary->shards_monitor_);
+  primary->running_shards_--;
+  ml.Notify();
+}
+
+void EventHandlerImplementation::StartShards() {
+  const intptr_t kMaxShards = 64;
+  const intptr_t count = EventHandler::thread_count();
+  if (count <= 1) {
+    return;
+  }
+  shard_count_ = Utils::Minimum(count, kMaxShards);
+  shards_ = new EventHandlerImplementation*[shard_count_];
+  shards_monitor_ = new Monitor();
+  shards_[0] = this;
+  for (intptr_t i = 1; i < shard_count_; i++) {
+    shards_[i] = new EventHandlerImplementation();
+    shards_[i]->primary_ = this;
+  }
+  running_shards_ = shard_count_ - 1;
+  for (intptr_t i = 1; i < shard_count_; i++) {
+    Thread::Start("dart:io EventHandler",
+                  &EventHandlerImplementation::PollShard,
+                  reinterpret_cast<uword>(shards_[i]));
+  }
+}
+
+void EventHandlerImplementation::ShutdownShards() {
+  if (shards_ == nullptr) {
+    return;
+  }
+  {
+    MonitorLocker ml(shards_monitor_);
+    for (intptr_t i = 1; i < shard_count_; i++) {
+      shards_[i]->WakeupHandler(kShutdownId, 0, 0);
+    }
+    while (running_shards_ > 0) {
+      ml.Wait();
+    }
+  }
+  for (intptr_t i = 1; i < shard_count_; i++) {
+    delete shards_[i];
+  }
+  delete[] shards_;
+  shards_ = nullptr;
+  shard_count_ = 1;
+  delete shards_monitor_;
+  shards_monitor_ = nullptr;
+}
+
+EventHandlerImplementation* EventHandlerImplementation::ShardFor(intptr_t id) {
+  if ((shards_ == nullptr) || (id == kTimerId) || (id == kShutdownId)) {
+    return this;
+  }
+  // The socket's current descriptor is reset by another thread when it is
+  // closed, so route by the one it was created with.
+  return shards_[reinterpret_cast<Socket*>(id)->initial_fd() % shard_count_];
+}
+
 void EventHandlerImplementation::Start(EventHandler* handler) {
+  StartShards();
   Thread::Start("dart:io EventHandler", &EventHandlerImplementation::Poll,
                 reinterpret_cast<uword>(handler));
 }
@@ -424,7 +781,7 @@ void EventHandlerImplementation::Shutdown() {
 void EventHandlerImplementation::SendData(intptr_t id,
                                           Dart_Port dart_port,
                                           int64_t data) {
-  WakeupHandler(id, dart_port, data);
+  ShardFor(id)->WakeupHandler(id, dart_port, data);
 }
 
 void* EventHandlerImplementation::GetHashmapKeyFromFd(intptr_t fd) {
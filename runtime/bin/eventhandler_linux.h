@@ -16,6 +16,13 @@
 
 #include "platform/hashmap.h"
 #include "platform/signal_blocker.h"
+#include "platform/synchronization.h"
+
+#if defined(DART_HOST_OS_LINUX)
+// Defined in <linux/io_uring.h>.
+struct io_uring_sqe;
+struct io_uring_cqe;
+#endif
 
 namespace dart {
 namespace bin {
@@ -57,6 +64,76 @@ class DescriptorInfoMultiple
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfoMultiple);
 };
 
+#if defined(DART_HOST_OS_LINUX)
+// A minimal io_uring instance. The event handler uses it to batch the
+// epoll_ctl registrations made while handling a round of events and submit
+// them, together with the wait for the next round, in a single io_uring_enter
+// system call instead of one epoll_ctl system call each. File uses it to
+// submit batches of reads.
+class IOUring {
+ public:
+  // Returns nullptr if io_uring is not available, e.g. on kernels older than
+  // 5.6 or when it is disabled by a seccomp filter.
+  static IOUring* Create(uint32_t entries);
+  ~IOUring();
+
+  // Queues an epoll_ctl(epoll_fd, op, fd, event) operation. Returns false if
+  // the submission queue is full. `event` is copied into the ring when the
+  // operation is queued, so it need not outlive the call.
+  bool QueueEpollCtl(int epoll_fd,
+                     int op,
+                     int fd,
+                     const struct epoll_event* event,
+                     uint64_t user_data);
+
+  // Queues a one-shot poll for `poll_mask` on `fd`. Returns false if the
+  // submission queue is full.
+  bool QueuePoll(int fd, uint32_t poll_mask, uint64_t user_data);
+
+  // Queues a read of at most `length` bytes at `offset` in `fd` into
+  // `buffer`. Returns false if the submission queue is full.
+  bool QueueRead(int fd,
+                 void* buffer,
+                 uint32_t length,
+                 uint64_t offset,
+                 uint64_t user_data);
+
+  // Submits all queued operations. If `min_complete` is non-zero, blocks
+  // until at least that many completions are available.
+  intptr_t Submit(uint32_t min_complete);
+
+  // Pops the next completion, if any.
+  bool NextCompletion(uint64_t* user_data, int32_t* result);
+
+ private:
+  IOUring() {}
+
+  struct io_uring_sqe* NextSqe();
+
+  int ring_fd_ = -1;
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  struct io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  struct io_uring_cqe* cqes_ = nullptr;
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  // Copies of the epoll_event arguments, indexed like the submission queue
+  // entries that point at them.
+  struct epoll_event* events_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(IOUring);
+};
+#endif  // defined(DART_HOST_OS_LINUX)
+
 class EventHandlerImplementation {
  public:
   EventHandlerImplementation();
@@ -72,11 +149,22 @@ class EventHandlerImplementation {
   void Shutdown();
 
  private:
+  // Returns the event handler thread responsible for the message.
+  EventHandlerImplementation* ShardFor(intptr_t id);
+  void StartShards();
+  void ShutdownShards();
   void HandleEvents(struct epoll_event* events, int size);
+  void Run();
   static void Poll(uword args);
+  static void PollShard(uword args);
   void WakeupHandler(intptr_t id, Dart_Port dart_port, int64_t data);
   void HandleInterruptFd();
   void UpdateTimerFd();
+  void AddToEpollInstance(DescriptorInfo* di);
+  void RemoveFromEpollInstance(DescriptorInfo* di);
+  intptr_t PollWithIOUring(struct epoll_event* events, intptr_t max_events);
+  void HandleCompletions();
+  void FlushPendingRegistrations();
   void SetPort(intptr_t fd, Dart_Port dart_port, intptr_t mask);
   intptr_t GetPollEvents(intptr_t events, DescriptorInfo* di);
   static void* GetHashmapKeyFromFd(intptr_t fd);
@@ -88,6 +176,29 @@ class EventHandlerImplementation {
   int interrupt_fds_[2];
   int epoll_fd_;
   int timer_fd_;
+#if defined(DART_HOST_OS_LINUX)
+  // Only used when --io_uring is passed and the kernel supports it. Otherwise
+  // all registrations go through epoll_ctl directly.
+  IOUring* uring_;
+  // Number of queued or submitted epoll_ctl operations whose completion has
+  // not been handled yet.
+  intptr_t pending_registrations_;
+  bool epoll_fd_polled_;
+#endif
+
+  // When --event_handler_threads is more than one, the event handler started
+  // by EventHandler::Start (the primary) runs that many threads. Each owns
+  // its own epoll instance, interrupt pipe and descriptor map. Socket
+  // commands are routed by the descriptor the Socket was created with, so
+  // all Socket objects sharing a descriptor are handled by the same thread.
+  // Timers are always handled by the primary.
+  EventHandlerImplementation** shards_;
+  intptr_t shard_count_;
+  // The primary, for additional shards. nullptr for the primary itself.
+  EventHandlerImplementation* primary_;
+  // Used by the primary to wait for the other shards to shut down.
+  Monitor* shards_monitor_;
+  intptr_t running_shards_;
 
   DISALLOW_COPY_AND_ASSIGN(EventHandlerImplementation);
 };
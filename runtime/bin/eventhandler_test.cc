@@ -6,6 +6,12 @@
 #include "platform/assert.h"
 #include "vm/unit_test.h"
 
+#if defined(DART_HOST_OS_LINUX)
+#include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
 namespace dart {
 namespace bin {
 
@@ -79,5 +85,60 @@ VM_UNIT_TEST_CASE(CircularLinkedList) {
   list.Remove(4242);
 }
 
+#if defined(DART_HOST_OS_LINUX)
+VM_UNIT_TEST_CASE(EventHandler_IOUringEpollCtl) {
+  IOUring* ring = IOUring::Create(4);
+  if (ring == nullptr) {
+    // Not supported by this kernel. The event handler falls back to epoll.
+    return;
+  }
+  int fds[2];
+  EXPECT_EQ(0, pipe(fds));
+  int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  EXPECT(epoll_fd >= 0);
+
+  // Registering the same descriptor twice fails the second time.
+  struct epoll_event event;
+  event.events = EPOLLIN;
+  event.data.fd = fds[0];
+  EXPECT(ring->QueueEpollCtl(epoll_fd, EPOLL_CTL_ADD, fds[0], &event, 1));
+  EXPECT(ring->QueueEpollCtl(epoll_fd, EPOLL_CTL_ADD, fds[0], &event, 2));
+  EXPECT(ring->QueuePoll(epoll_fd, POLLIN, 3));
+  EXPECT_EQ(3, ring->Submit(0));
+
+  uint64_t user_data;
+  int32_t result;
+  intptr_t registrations = 0;
+  while (registrations < 2) {
+    EXPECT(ring->Submit(1) >= 0);
+    while (ring->NextCompletion(&user_data, &result)) {
+      if (user_data == 1) {
+        EXPECT_EQ(0, result);
+      } else {
+        EXPECT_EQ(2, static_cast<intptr_t>(user_data));
+        EXPECT_EQ(-EEXIST, result);
+      }
+      registrations++;
+    }
+  }
+
+  // The poll on the epoll instance completes once the pipe is readable.
+  char data = 'x';
+  EXPECT_EQ(1, write(fds[1], &data, 1));
+  EXPECT(ring->Submit(1) >= 0);
+  EXPECT(ring->NextCompletion(&user_data, &result));
+  EXPECT_EQ(3, static_cast<intptr_t>(user_data));
+  EXPECT((result & POLLIN) != 0);
+  EXPECT(!ring->NextCompletion(&user_data, &result));
+  EXPECT_EQ(1, epoll_wait(epoll_fd, &event, 1, 0));
+  EXPECT_EQ(fds[0], event.data.fd);
+
+  delete ring;
+  close(epoll_fd);
+  close(fds[0]);
+  close(fds[1]);
+}
+#endif  // defined(DART_HOST_OS_LINUX)
+
 }  // namespace bin
 }  // namespace dart
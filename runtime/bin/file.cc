@@ -6,6 +6,8 @@
 
 #include <stdio.h>
 
+#include <memory>
+
 #include "bin/builtin.h"
 #include "bin/dartutils.h"
 #include "bin/io_buffer.h"
@@ -1213,6 +1215,174 @@ CObject* File::ReadIntoRequest(const CObjectArray& request) {
   return result;
 }
 
+CObject* File::ReadAtRequest(const CObjectArray& request) {
+  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
+    return CObject::IllegalArgumentError();
+  }
+  File* file = CObjectToFilePointer(request[0]);
+  RefCntReleaseScope<File> rs(file);
+  if ((request.Length() != 3) || !request[1]->IsInt32OrInt64() ||
+      !request[2]->IsInt32OrInt64()) {
+    return CObject::IllegalArgumentError();
+  }
+  if (file->IsClosed()) {
+    return CObject::FileClosedError();
+  }
+  const int64_t position = CObjectInt32OrInt64ToInt64(request[1]);
+  const int64_t length = CObjectInt32OrInt64ToInt64(request[2]);
+  if ((position < 0) || (length < 0)) {
+    return CObject::IllegalArgumentError();
+  }
+  Dart_CObject* io_buffer = CObject::NewIOBuffer(length);
+  if (io_buffer == nullptr) {
+    return CObject::NewOSError();
+  }
+  uint8_t* data = io_buffer->value.as_external_typed_data.data;
+  const int64_t bytes_read = file->ReadAt(data, length, position);
+  if (bytes_read < 0) {
+    CObject* error = CObject::NewOSError();
+    CObject::FreeIOBufferData(io_buffer);
+    return error;
+  }
+  CObject::ShrinkIOBuffer(io_buffer, bytes_read);
+
+  auto external_array = new CObjectExternalUint8Array(io_buffer);
+  CObjectArray* result = new CObjectArray(CObject::NewArray(2));
+  result->SetAt(0, new CObjectIntptr(CObject::NewInt32(0)));
+  result->SetAt(1, external_array);
+  return result;
+}
+
+#if !defined(DART_HOST_OS_LINUX)
+void File::ReadAtBatch(ReadAtOperation* operations, intptr_t count) {
+  for (intptr_t i = 0; i < count; i++) {
+    ReadAtOperation* operation = &operations[i];
+    operation->result = operation->file->ReadAt(
+        operation->buffer, operation->length, operation->position);
+    if (operation->result < 0) {
+      OSError os_error;
+      operation->error = os_error.code();
+    }
+  }
+}
+#endif  // !defined(DART_HOST_OS_LINUX)
+
+// The step of reading a whole file that failed, reported with the error in
+// the response to a ReadFiles request. Must be kept in sync with
+// `_File._readFilesErrorMessages` in sdk/lib/io/file_impl.dart.
+enum ReadFilesStage {
+  kReadFilesOpen = 0,
+  kReadFilesLength = 1,
+  kReadFilesRead = 2,
+};
+
+static CObject* ReadFilesError(ReadFilesStage stage, CObject* error) {
+  CObjectArray* result = new CObjectArray(CObject::NewArray(2));
+  result->SetAt(0, new CObjectInt32(CObject::NewInt32(stage)));
+  result->SetAt(1, error);
+  return result;
+}
+
+static CObject* ReadFilesError(ReadFilesStage stage, int error_code) {
+  OSError os_error;
+  os_error.SetCodeAndMessage(OSError::kSystem, error_code);
+  return ReadFilesError(stage, CObject::NewOSError(&os_error));
+}
+
+// Reads each of the files in the request in full, like `File.readAsBytes`.
+// All files are opened before any is read, so that the reads can be handed
+// to `File::ReadAtBatch` together. The result has one entry per file: the
+// contents, an error, or null if the length of the file is not known in
+// advance (e.g. for character devices) and it has to be read piecewise.
+CObject* File::ReadFilesRequest(const CObjectArray& request) {
+  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
+    return CObject::IllegalArgumentError();
+  }
+  Namespace* namespc = CObjectToNamespacePointer(request[0]);
+  RefCntReleaseScope<Namespace> rs(namespc);
+  const intptr_t count = request.Length() - 1;
+  for (intptr_t i = 0; i < count; i++) {
+    if (!request[i + 1]->IsUint8Array()) {
+      return CObject::IllegalArgumentError();
+    }
+  }
+  CObjectArray* result = new CObjectArray(CObject::NewArray(count));
+  std::unique_ptr<ReadAtOperation[]> operations(new ReadAtOperation[count]);
+  std::unique_ptr<intptr_t[]> indices(new intptr_t[count]);
+  std::unique_ptr<Dart_CObject*[]> buffers(new Dart_CObject*[count]);
+  intptr_t pending = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    CObjectUint8Array filename(request[i + 1]);
+    File* file =
+        File::Open(namespc, reinterpret_cast<const char*>(filename.Buffer()),
+                   File::kRead);
+    if (file == nullptr) {
+      result->SetAt(i, ReadFilesError(kReadFilesOpen, CObject::NewOSError()));
+      continue;
+    }
+    const int64_t length = file->Length();
+    if (length < 0) {
+      result->SetAt(i,
+                    ReadFilesError(kReadFilesLength, CObject::NewOSError()));
+      file->Release();
+      continue;
+    }
+    if (length == 0) {
+      result->SetAt(i, CObject::Null());
+      file->Release();
+      continue;
+    }
+    Dart_CObject* io_buffer = CObject::NewIOBuffer(length);
+    if (io_buffer == nullptr) {
+      result->SetAt(i, ReadFilesError(kReadFilesRead, CObject::NewOSError()));
+      file->Release();
+      continue;
+    }
+    ReadAtOperation* operation = &operations[pending];
+    operation->file = file;
+    operation->buffer = io_buffer->value.as_external_typed_data.data;
+    operation->position = 0;
+    operation->length = length;
+    indices[pending] = i;
+    buffers[pending] = io_buffer;
+    pending++;
+  }
+
+  ReadAtBatch(operations.get(), pending);
+
+  for (intptr_t j = 0; j < pending; j++) {
+    ReadAtOperation* operation = &operations[j];
+    File* file = operation->file;
+    int64_t bytes_read = operation->result;
+    int error = operation->error;
+    // Reads may be short, e.g. if interrupted by a signal. Finish them here.
+    while ((bytes_read > 0) && (bytes_read < operation->length)) {
+      const int64_t result = file->ReadAt(
+          reinterpret_cast<uint8_t*>(operation->buffer) + bytes_read,
+          operation->length - bytes_read, bytes_read);
+      if (result < 0) {
+        OSError os_error;
+        error = os_error.code();
+        bytes_read = -1;
+      } else if (result == 0) {
+        break;
+      } else {
+        bytes_read += result;
+      }
+    }
+    file->Release();
+    if (bytes_read < 0) {
+      CObject::FreeIOBufferData(buffers[j]);
+      result->SetAt(indices[j], ReadFilesError(kReadFilesRead, error));
+      continue;
+    }
+    // The file may have been truncated since its length was taken.
+    CObject::ShrinkIOBuffer(buffers[j], bytes_read);
+    result->SetAt(indices[j], new CObjectExternalUint8Array(buffers[j]));
+  }
+  return result;
+}
+
 static int SizeInBytes(Dart_TypedData_Type type) {
   switch (type) {
     case Dart_TypedData_kInt8:
@@ -1415,6 +1585,38 @@ CObject* File::StatRequest(const CObjectArray& request) {
   return wrapper;
 }
 
+// Stats each of the paths in the request, like `FileStat.stat`. The result
+// has one entry per path: the stat data, or null if it does not exist.
+CObject* File::StatFilesRequest(const CObjectArray& request) {
+  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
+    return CObject::IllegalArgumentError();
+  }
+  Namespace* namespc = CObjectToNamespacePointer(request[0]);
+  RefCntReleaseScope<Namespace> rs(namespc);
+  const intptr_t count = request.Length() - 1;
+  for (intptr_t i = 0; i < count; i++) {
+    if (!request[i + 1]->IsString()) {
+      return CObject::IllegalArgumentError();
+    }
+  }
+  CObjectArray* result = new CObjectArray(CObject::NewArray(count));
+  for (intptr_t i = 0; i < count; i++) {
+    int64_t data[File::kStatSize];
+    CObjectString path(request[i + 1]);
+    File::Stat(namespc, path.CString(), data);
+    if (data[File::kType] == File::kDoesNotExist) {
+      result->SetAt(i, CObject::Null());
+      continue;
+    }
+    CObjectArray* stat = new CObjectArray(CObject::NewArray(File::kStatSize));
+    for (int k = 0; k < File::kStatSize; ++k) {
+      stat->SetAt(k, new CObjectInt64(CObject::NewInt64(data[k])));
+    }
+    result->SetAt(i, stat);
+  }
+  return result;
+}
+
 CObject* File::LockRequest(const CObjectArray& request) {
   if ((request.Length() < 1) || !request[0]->IsIntptr()) {
     return CObject::IllegalArgumentError();
@@ -152,6 +152,26 @@ class File : public ReferenceCounted<File> {
   // bytes read. Zero indicates an attempt to read past the end-of-file. -1
   // indicates an error.
   int64_t Read(void* buffer, int64_t num_bytes);
+  // Read at most 'num_bytes' from the file starting at byte 'position'. The
+  // return value is as for `Read`. The file position is not used, and except
+  // on Windows it is not changed either.
+  int64_t ReadAt(void* buffer, int64_t num_bytes, int64_t position);
+
+  // A positional read performed by `ReadAtBatch`.
+  struct ReadAtOperation {
+    File* file;
+    void* buffer;
+    int64_t position;
+    int64_t length;
+    // The return value of `ReadAt`, and the OS error code if it is -1.
+    int64_t result;
+    int error;
+  };
+
+  // Performs each of 'operations' like `ReadAt`. On Linux the reads are
+  // handed to the kernel together through io_uring when the --io_uring
+  // option is given.
+  static void ReadAtBatch(ReadAtOperation* operations, intptr_t count);
   // Attempt to write 'num_bytes' bytes from 'buffer'. It returns the number
   // of bytes written.
   int64_t Write(const void* buffer, int64_t num_bytes);
@@ -342,6 +362,9 @@ class File : public ReferenceCounted<File> {
   static CObject* IdenticalRequest(const CObjectArray& request);
   static CObject* StatRequest(const CObjectArray& request);
   static CObject* LockRequest(const CObjectArray& request);
+  static CObject* ReadAtRequest(const CObjectArray& request);
+  static CObject* ReadFilesRequest(const CObjectArray& request);
+  static CObject* StatFilesRequest(const CObjectArray& request);
 
  private:
   explicit File(FileHandle* handle)
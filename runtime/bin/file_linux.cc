@@ -17,7 +17,12 @@
 #include <unistd.h>        // NOLINT
 #include <utime.h>         // NOLINT
 
+#include <atomic>
+
 #include "bin/builtin.h"
+#if defined(DART_HOST_OS_LINUX)
+#include "bin/eventhandler.h"
+#endif
 #include "bin/fdutils.h"
 #include "bin/namespace.h"
 #include "platform/signal_blocker.h"
@@ -134,6 +139,111 @@ int64_t File::Read(void* buffer, int64_t num_bytes) {
   return TEMP_FAILURE_RETRY(read(handle_->fd(), buffer, num_bytes));
 }
 
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TEMP_FAILURE_RETRY(
+      pread64(handle_->fd(), buffer, num_bytes, position));
+}
+
+#if defined(DART_HOST_OS_LINUX)
+// io_uring instances for ReadAtBatch that are not in use by any thread. More
+// are created when several IOService threads read batches at the same time.
+static constexpr intptr_t kMaxIdleReadRings = 8;
+static constexpr uint32_t kReadRingEntries = 64;
+static std::atomic<IOUring*> idle_read_rings[kMaxIdleReadRings] = {};
+static std::atomic<bool> read_ring_unavailable = {false};
+
+static IOUring* AcquireReadRing() {
+  for (intptr_t i = 0; i < kMaxIdleReadRings; i++) {
+    IOUring* ring = idle_read_rings[i].exchange(nullptr);
+    if (ring != nullptr) {
+      return ring;
+    }
+  }
+  if (read_ring_unavailable.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  IOUring* ring = IOUring::Create(kReadRingEntries);
+  if (ring == nullptr) {
+    read_ring_unavailable.store(true, std::memory_order_relaxed);
+  }
+  return ring;
+}
+
+static void ReleaseReadRing(IOUring* ring) {
+  for (intptr_t i = 0; i < kMaxIdleReadRings; i++) {
+    IOUring* expected = nullptr;
+    if (idle_read_rings[i].compare_exchange_strong(expected, ring)) {
+      return;
+    }
+  }
+  delete ring;
+}
+
+static void ReadAtEach(File::ReadAtOperation* operations, intptr_t count) {
+  for (intptr_t i = 0; i < count; i++) {
+    File::ReadAtOperation* operation = &operations[i];
+    operation->result = operation->file->ReadAt(
+        operation->buffer, operation->length, operation->position);
+    operation->error = (operation->result < 0) ? errno : 0;
+  }
+}
+
+void File::ReadAtBatch(ReadAtOperation* operations, intptr_t count) {
+  IOUring* ring = nullptr;
+  if ((count > 1) && EventHandler::use_io_uring()) {
+    ring = AcquireReadRing();
+  }
+  if (ring == nullptr) {
+    ReadAtEach(operations, count);
+    return;
+  }
+  // Submit the reads a ring full at a time and wait for all of them to
+  // complete in one io_uring_enter system call. The kernel completes reads
+  // that would block, e.g. on cold files, on its own worker threads.
+  for (intptr_t start = 0; start < count; start += kReadRingEntries) {
+    const intptr_t end =
+        Utils::Minimum(count, start + static_cast<intptr_t>(kReadRingEntries));
+    bool completed[kReadRingEntries] = {};
+    for (intptr_t i = start; i < end; i++) {
+      ReadAtOperation* operation = &operations[i];
+      const uint32_t length = static_cast<uint32_t>(
+          Utils::Minimum<int64_t>(operation->length, kMaxInt32));
+      if (!ring->QueueRead(operation->file->handle_->fd(), operation->buffer,
+                           length, operation->position, i)) {
+        UNREACHABLE();
+      }
+    }
+    intptr_t pending = end - start;
+    while (pending > 0) {
+      // Submit retries io_uring_enter on EINTR. Any other failure leaves
+      // the reads not completed yet to pread, and the ring, which may still
+      // hold them, is not reused.
+      if (ring->Submit(pending) < 0) {
+        for (intptr_t i = start; i < end; i++) {
+          if (!completed[i - start]) {
+            ReadAtEach(&operations[i], 1);
+          }
+        }
+        ReadAtEach(&operations[end], count - end);
+        delete ring;
+        return;
+      }
+      uint64_t index;
+      int32_t result;
+      while (ring->NextCompletion(&index, &result)) {
+        ReadAtOperation* operation = &operations[index];
+        operation->result = (result < 0) ? -1 : result;
+        operation->error = (result < 0) ? -result : 0;
+        completed[index - start] = true;
+        pending--;
+      }
+    }
+  }
+  ReleaseReadRing(ring);
+}
+#endif  // defined(DART_HOST_OS_LINUX)
+
 int64_t File::Write(const void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(write(handle_->fd(), buffer, num_bytes));
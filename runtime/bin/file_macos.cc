@@ -172,6 +172,11 @@ int64_t File::Read(void* buffer, int64_t num_bytes) {
   return TEMP_FAILURE_RETRY(read(handle_->fd(), buffer, num_bytes));
 }
 
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TEMP_FAILURE_RETRY(pread(handle_->fd(), buffer, num_bytes, position));
+}
+
 int64_t File::Write(const void* buffer, int64_t num_bytes) {
   // Invalid argument error will pop if num_bytes exceeds the limit.
   ASSERT(handle_->fd() >= 0 && num_bytes <= kMaxInt32);
@@ -153,6 +153,24 @@ int64_t File::Read(void* buffer, int64_t num_bytes) {
   return Utils::Read(handle_->fd(), buffer, num_bytes);
 }
 
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(handle_->fd()));
+  // A synchronous read at the offset given in an OVERLAPPED structure. Unlike
+  // pread, it leaves the file position after the bytes read.
+  OVERLAPPED overlapped;
+  ZeroMemory(&overlapped, sizeof(overlapped));
+  overlapped.Offset = static_cast<DWORD>(position);
+  overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+  const DWORD length =
+      static_cast<DWORD>(Utils::Minimum<int64_t>(num_bytes, kMaxInt32));
+  DWORD read = 0;
+  if (!ReadFile(handle, buffer, length, &read, &overlapped)) {
+    return (GetLastError() == ERROR_HANDLE_EOF) ? 0 : -1;
+  }
+  return read;
+}
+
 int64_t File::Write(const void* buffer, int64_t num_bytes) {
   int fd = handle_->fd();
   // Avoid narrowing conversion
@@ -6,6 +6,7 @@
 
 #include "bin/dartutils.h"
 #include "bin/io_buffer.h"
+#include "bin/lockers.h"
 
 #include "include/dart_api.h"
 
@@ -122,6 +123,7 @@ void FUNCTION_NAME(Filter_CreateZLibDeflate)(Dart_NativeArguments args) {
   int64_t strategy = DartUtils::GetNativeIntegerArgument(args, 5);
   Dart_Handle dict_obj = Dart_GetNativeArgument(args, 6);
   bool raw = DartUtils::GetNativeBooleanArgument(args, 7);
+  int64_t threads = DartUtils::GetNativeIntegerArgument(args, 8);
 
   Dart_Handle err;
   uint8_t* dictionary = nullptr;
@@ -140,10 +142,25 @@ void FUNCTION_NAME(Filter_CreateZLibDeflate)(Dart_NativeArguments args) {
     }
   }
 
-  ZLibDeflateFilter* filter = new ZLibDeflateFilter(
-      gzip, static_cast<int32_t>(level), static_cast<int32_t>(window_bits),
-      static_cast<int32_t>(mem_level), static_cast<int32_t>(strategy),
-      dictionary, dictionary_length, raw);
+  Filter* filter;
+  intptr_t filter_size;
+  if ((threads > 1) && ((dictionary == nullptr) || gzip || raw)) {
+    // Like ZLibDeflateFilter, gzip and raw streams ignore the dictionary.
+    delete[] dictionary;
+    dictionary = nullptr;
+    dictionary_length = 0;
+    filter = new ParallelDeflateFilter(
+        gzip, static_cast<int32_t>(level), static_cast<int32_t>(window_bits),
+        static_cast<int32_t>(mem_level), static_cast<int32_t>(strategy), raw,
+        static_cast<intptr_t>(threads));
+    filter_size = sizeof(ParallelDeflateFilter);
+  } else {
+    filter = new ZLibDeflateFilter(
+        gzip, static_cast<int32_t>(level), static_cast<int32_t>(window_bits),
+        static_cast<int32_t>(mem_level), static_cast<int32_t>(strategy),
+        dictionary, dictionary_length, raw);
+    filter_size = sizeof(ZLibDeflateFilter);
+  }
   if (filter == nullptr) {
     delete[] dictionary;
     Dart_PropagateError(
@@ -155,7 +172,7 @@ void FUNCTION_NAME(Filter_CreateZLibDeflate)(Dart_NativeArguments args) {
         DartUtils::NewInternalError("Failed to create ZLibDeflateFilter"));
   }
   Dart_Handle result = Filter::SetFilterAndCreateFinalizer(
-      filter_obj, filter, sizeof(*filter) + dictionary_length);
+      filter_obj, filter, filter_size + dictionary_length);
   if (Dart_IsError(result)) {
     delete filter;
     Dart_PropagateError(result);
@@ -363,6 +380,369 @@ intptr_t ZLibDeflateFilter::Processed(uint8_t* buffer,
   return error ? -1 : 0;
 }
 
+// Space reserved in front of and behind the compressed data of a block for
+// the stream header and trailer.
+static constexpr intptr_t kHeaderSpace = 10;
+static constexpr intptr_t kTrailerSpace = 8;
+// Space for the empty stored block that ends a sync flush, on top of
+// deflateBound.
+static constexpr intptr_t kFlushSpace = 16;
+
+struct ParallelDeflateFilter::Block {
+  ~Block() {
+    delete[] input;
+    delete[] output;
+  }
+
+  // The dictionary, followed by the data to compress.
+  uint8_t* input;
+  intptr_t dictionary_length;
+  intptr_t length;
+  bool last;
+
+  uint8_t* output;
+  intptr_t output_start;
+  intptr_t output_end;
+  // The CRC-32 or Adler-32 of the data.
+  uint32_t check;
+  bool done;
+  bool error;
+  // Whether the output of the block has started to be returned.
+  bool started;
+  ParallelDeflateFilter* filter;
+  Block* next;
+};
+
+ParallelDeflateFilter::ParallelDeflateFilter(bool gzip,
+                                             int32_t level,
+                                             int32_t window_bits,
+                                             int32_t mem_level,
+                                             int32_t strategy,
+                                             bool raw,
+                                             intptr_t threads)
+    : gzip_(gzip),
+      level_(level),
+      // See ZLibDeflateFilter::Init.
+      window_bits_(window_bits == 8 ? 9 : window_bits),
+      mem_level_(mem_level),
+      strategy_(strategy),
+      raw_(raw),
+      threads_(threads),
+      port_(ILLEGAL_PORT),
+      input_(nullptr),
+      input_length_(0),
+      input_position_(0),
+      current_(nullptr),
+      head_(nullptr),
+      tail_(nullptr),
+      queued_(0),
+      ended_(false),
+      header_written_(false),
+      check_(gzip ? crc32(0, Z_NULL, 0) : adler32(0, Z_NULL, 0)),
+      total_length_(0),
+      pending_(0) {}
+
+ParallelDeflateFilter::~ParallelDeflateFilter() {
+  {
+    // Blocks still being compressed refer to this filter.
+    MonitorLocker ml(&monitor_);
+    while (pending_ > 0) {
+      ml.Wait();
+    }
+  }
+  if (port_ != ILLEGAL_PORT) {
+    Dart_CloseNativePort(port_);
+  }
+  while (head_ != nullptr) {
+    Block* next = head_->next;
+    delete head_;
+    head_ = next;
+  }
+  delete current_;
+  delete[] input_;
+}
+
+bool ParallelDeflateFilter::Init() {
+  port_ = Dart_NewConcurrentNativePort("ParallelDeflateFilter", CompressBlock,
+                                       threads_);
+  if (port_ == ILLEGAL_PORT) {
+    return false;
+  }
+  current_ = NewBlock(nullptr);
+  set_initialized(true);
+  return true;
+}
+
+ParallelDeflateFilter::Block* ParallelDeflateFilter::NewBlock(
+    Block* previous) {
+  const intptr_t window = static_cast<intptr_t>(1) << window_bits_;
+  Block* block = new Block();
+  block->filter = this;
+  block->input = new uint8_t[window + kBlockSize];
+  if (previous != nullptr) {
+    const intptr_t available = previous->dictionary_length + previous->length;
+    block->dictionary_length = Utils::Minimum(window, available);
+    memmove(block->input,
+            previous->input + available - block->dictionary_length,
+            block->dictionary_length);
+  }
+  return block;
+}
+
+void ParallelDeflateFilter::Append(Block* block) {
+  if (tail_ == nullptr) {
+    head_ = block;
+  } else {
+    tail_->next = block;
+  }
+  tail_ = block;
+  queued_++;
+}
+
+void ParallelDeflateFilter::Submit(bool last) {
+  Block* block = current_;
+  block->last = last;
+  // The next block copies its dictionary before [block] can be freed.
+  current_ = last ? nullptr : NewBlock(block);
+  Append(block);
+  {
+    MonitorLocker ml(&monitor_);
+    pending_++;
+  }
+  if (!Dart_PostInteger(port_, reinterpret_cast<intptr_t>(block))) {
+    Compress(block);
+  }
+}
+
+void ParallelDeflateFilter::CompressBlock(Dart_Port port,
+                                          Dart_CObject* message) {
+  int64_t address = message->type == Dart_CObject_kInt32
+                        ? message->value.as_int32
+                        : message->value.as_int64;
+  ASSERT(message->type == Dart_CObject_kInt32 ||
+         message->type == Dart_CObject_kInt64);
+  Block* block = reinterpret_cast<Block*>(static_cast<intptr_t>(address));
+  // The filter waits for its pending blocks before it is deleted.
+  block->filter->Compress(block);
+}
+
+void ParallelDeflateFilter::Compress(Block* block) {
+  uint8_t* data = block->input + block->dictionary_length;
+  z_stream stream;
+  stream.next_in = Z_NULL;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  // Raw deflate, as the blocks are joined under a single header.
+  int result = deflateInit2(&stream, level_, Z_DEFLATED, -window_bits_,
+                            mem_level_, strategy_);
+  if (result == Z_OK) {
+    if (block->dictionary_length > 0) {
+      result = deflateSetDictionary(&stream, block->input,
+                                    block->dictionary_length);
+    }
+    if (result == Z_OK) {
+      const intptr_t size = kHeaderSpace +
+                            deflateBound(&stream, block->length) +
+                            kFlushSpace + kTrailerSpace;
+      block->output = new uint8_t[size];
+      block->output_start = kHeaderSpace;
+      stream.next_in = data;
+      stream.avail_in = block->length;
+      stream.next_out = block->output + kHeaderSpace;
+      stream.avail_out = size - kHeaderSpace - kTrailerSpace;
+      // All blocks but the last end byte aligned, so they can be joined.
+      result = deflate(&stream, block->last ? Z_FINISH : Z_SYNC_FLUSH);
+      if (stream.avail_in != 0) {
+        result = Z_BUF_ERROR;
+      }
+      block->output_end = size - kTrailerSpace - stream.avail_out;
+    }
+    deflateEnd(&stream);
+  }
+  if (!raw_) {
+    block->check = gzip_ ? crc32(0, data, block->length)
+                         : adler32(1, data, block->length);
+  }
+
+  MonitorLocker ml(&monitor_);
+  block->error = result != (block->last ? Z_STREAM_END : Z_OK);
+  block->done = true;
+  pending_--;
+  ml.NotifyAll();
+}
+
+// The operating system code that zlib writes into gzip headers. It depends
+// on the platform zlib was built for, so ask zlib for it.
+static uint8_t GZipOperatingSystem() {
+  static const uint8_t os = []() {
+    // Unix, in case zlib fails.
+    uint8_t result = 3;
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + 9, 1,
+                     Z_DEFAULT_STRATEGY) == Z_OK) {
+      // An empty gzip stream is a 10 byte header, an empty block and an 8
+      // byte trailer.
+      uint8_t output[32];
+      stream.next_out = output;
+      stream.avail_out = sizeof(output);
+      if (deflate(&stream, Z_FINISH) == Z_STREAM_END) {
+        result = output[9];
+      }
+      deflateEnd(&stream);
+    }
+    return result;
+  }();
+  return os;
+}
+
+void ParallelDeflateFilter::WriteHeader(Block* block) {
+  if (raw_) {
+    return;
+  }
+  // Mirrors the header written by deflate.
+  const int32_t level = level_ == Z_DEFAULT_COMPRESSION ? 6 : level_;
+  const bool fast = (strategy_ >= Z_HUFFMAN_ONLY) || (level < 2);
+  uint8_t header[kHeaderSpace];
+  intptr_t length;
+  if (gzip_) {
+    // No name, comment or modification time.
+    memset(header, 0, sizeof(header));
+    header[0] = 0x1f;
+    header[1] = 0x8b;
+    header[2] = Z_DEFLATED;
+    header[8] = level == 9 ? 2 : (fast ? 4 : 0);
+    header[9] = GZipOperatingSystem();
+    length = 10;
+  } else {
+    const intptr_t level_flags =
+        fast ? 0 : (level < 6 ? 1 : (level == 6 ? 2 : 3));
+    uint32_t value = (Z_DEFLATED + ((window_bits_ - 8) << 4)) << 8;
+    value |= level_flags << 6;
+    value += 31 - (value % 31);
+    header[0] = static_cast<uint8_t>(value >> 8);
+    header[1] = static_cast<uint8_t>(value);
+    length = 2;
+  }
+  block->output_start -= length;
+  memmove(block->output + block->output_start, header, length);
+}
+
+void ParallelDeflateFilter::WriteTrailer(Block* block) {
+  if (raw_) {
+    return;
+  }
+  uint8_t* trailer = block->output + block->output_end;
+  if (gzip_) {
+    for (intptr_t i = 0; i < 4; i++) {
+      trailer[i] = static_cast<uint8_t>(check_ >> (8 * i));
+      trailer[4 + i] = static_cast<uint8_t>(total_length_ >> (8 * i));
+    }
+    block->output_end += 8;
+  } else {
+    for (intptr_t i = 0; i < 4; i++) {
+      trailer[i] = static_cast<uint8_t>(check_ >> (24 - 8 * i));
+    }
+    block->output_end += 4;
+  }
+}
+
+bool ParallelDeflateFilter::Process(uint8_t* data, intptr_t length) {
+  if ((current_ == nullptr) || (input_ != nullptr)) {
+    return false;
+  }
+  input_ = data;
+  input_length_ = length;
+  input_position_ = 0;
+  return true;
+}
+
+// Adds input to blocks until all of it has been added or the maximum number
+// of blocks is queued.
+void ParallelDeflateFilter::Fill() {
+  while ((input_ != nullptr) && (queued_ < 2 * threads_)) {
+    uint8_t* end =
+        current_->input + current_->dictionary_length + current_->length;
+    const intptr_t count = Utils::Minimum(kBlockSize - current_->length,
+                                          input_length_ - input_position_);
+    memmove(end, input_ + input_position_, count);
+    current_->length += count;
+    input_position_ += count;
+    if (input_position_ == input_length_) {
+      delete[] input_;
+      input_ = nullptr;
+    }
+    if (current_->length == kBlockSize) {
+      Submit(false);
+    }
+  }
+}
+
+intptr_t ParallelDeflateFilter::Processed(uint8_t* buffer,
+                                          intptr_t length,
+                                          bool flush,
+                                          bool end) {
+  Fill();
+  if (input_ == nullptr) {
+    if (end && !ended_) {
+      ended_ = true;
+      Submit(true);
+    } else if (flush && (current_ != nullptr) && (current_->length > 0)) {
+      Submit(false);
+    }
+  }
+  while (head_ != nullptr) {
+    Block* block = head_;
+    {
+      MonitorLocker ml(&monitor_);
+      // Only wait when all output is asked for, or when the queue is full
+      // and input is left over. The input must be consumed before Process
+      // can be called again.
+      while (!block->done && (flush || end || (input_ != nullptr))) {
+        ml.Wait();
+      }
+      if (!block->done) {
+        return 0;
+      }
+    }
+    if (block->error) {
+      return -1;
+    }
+    if (!block->started) {
+      block->started = true;
+      if (!raw_) {
+        check_ = gzip_ ? crc32_combine(check_, block->check, block->length)
+                       : adler32_combine(check_, block->check, block->length);
+        total_length_ += static_cast<uint32_t>(block->length);
+      }
+      if (!header_written_) {
+        header_written_ = true;
+        WriteHeader(block);
+      }
+      if (block->last) {
+        WriteTrailer(block);
+      }
+    }
+    const intptr_t count =
+        Utils::Minimum(length, block->output_end - block->output_start);
+    memmove(buffer, block->output + block->output_start, count);
+    block->output_start += count;
+    if (block->output_start == block->output_end) {
+      head_ = block->next;
+      if (head_ == nullptr) {
+        tail_ = nullptr;
+      }
+      queued_--;
+      delete block;
+    }
+    if (count > 0) {
+      return count;
+    }
+  }
+  return 0;
+}
+
 ZLibInflateFilter::~ZLibInflateFilter() {
   delete[] dictionary_;
   delete[] current_buffer_;
@@ -7,6 +7,8 @@
 
 #include "bin/builtin.h"
 #include "bin/utils.h"
+#include "include/dart_native_api.h"
+#include "platform/synchronization.h"
 
 #include "zlib/zlib.h"
 
@@ -27,7 +29,7 @@ class Filter {
   virtual bool Process(uint8_t* data, intptr_t length) = 0;
   virtual intptr_t Processed(uint8_t* buffer,
                              intptr_t length,
-                             bool finish,
+                             bool flush,
                              bool end) = 0;
 
   static Dart_Handle SetFilterAndCreateFinalizer(Dart_Handle filter,
@@ -77,7 +79,7 @@ class ZLibDeflateFilter : public Filter {
   virtual bool Process(uint8_t* data, intptr_t length);
   virtual intptr_t Processed(uint8_t* buffer,
                              intptr_t length,
-                             bool finish,
+                             bool flush,
                              bool end);
 
  private:
@@ -95,6 +97,77 @@ class ZLibDeflateFilter : public Filter {
   DISALLOW_COPY_AND_ASSIGN(ZLibDeflateFilter);
 };
 
+// Compresses independent blocks of the input on a concurrent native port,
+// like pigz. Each block is primed with the end of the previous block as its
+// dictionary, so the compression ratio stays close to that of a single
+// deflate stream, and the compressed blocks form one gzip, zlib or raw
+// deflate stream. Preset dictionaries are not supported.
+//
+// Like ZLibDeflateFilter, the input passed to Process is consumed by the
+// following calls to Processed. At most two blocks per thread are held at a
+// time, so a large input does not queue an unbounded number of blocks.
+class ParallelDeflateFilter : public Filter {
+ public:
+  ParallelDeflateFilter(bool gzip,
+                        int32_t level,
+                        int32_t window_bits,
+                        int32_t mem_level,
+                        int32_t strategy,
+                        bool raw,
+                        intptr_t threads);
+  virtual ~ParallelDeflateFilter();
+
+  virtual bool Init();
+  virtual bool Process(uint8_t* data, intptr_t length);
+  virtual intptr_t Processed(uint8_t* buffer,
+                             intptr_t length,
+                             bool flush,
+                             bool end);
+
+ private:
+  struct Block;
+
+  static constexpr intptr_t kBlockSize = 128 * KB;
+
+  static void CompressBlock(Dart_Port port, Dart_CObject* message);
+  void Compress(Block* block);
+  Block* NewBlock(Block* previous);
+  void Fill();
+  void Submit(bool last);
+  void Append(Block* block);
+  void WriteHeader(Block* block);
+  void WriteTrailer(Block* block);
+
+  const bool gzip_;
+  const int32_t level_;
+  const int32_t window_bits_;
+  const int32_t mem_level_;
+  const int32_t strategy_;
+  const bool raw_;
+  const intptr_t threads_;
+  Dart_Port port_;
+  // The input passed to Process that has not been added to a block yet.
+  uint8_t* input_;
+  intptr_t input_length_;
+  intptr_t input_position_;
+  // The block that input is currently added to.
+  Block* current_;
+  // Blocks whose output has not been returned yet, in stream order.
+  Block* head_;
+  Block* tail_;
+  intptr_t queued_;
+  bool ended_;
+  bool header_written_;
+  uint32_t check_;
+  uint32_t total_length_;
+
+  // Protects the completion state of blocks and [pending_].
+  Monitor monitor_;
+  intptr_t pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelDeflateFilter);
+};
+
 class ZLibInflateFilter : public Filter {
  public:
   ZLibInflateFilter(bool gzip,
@@ -114,7 +187,7 @@ class ZLibInflateFilter : public Filter {
   virtual bool Process(uint8_t* data, intptr_t length);
   virtual intptr_t Processed(uint8_t* buffer,
                              intptr_t length,
-                             bool finish,
+                             bool flush,
                              bool end);
 
  private:
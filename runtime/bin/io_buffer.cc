@@ -4,11 +4,143 @@
 
 #include "bin/io_buffer.h"
 
+#include "bin/lockers.h"
 #include "platform/memory_sanitizer.h"
+#include "platform/synchronization.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
 
+// Pooled buffers are preceded by this header. Sizes up to 64 KB are
+// rounded up to a power of two. Each size class keeps a free list, and
+// at most kMaxCachedBytesPerClass bytes stay cached per class. The free
+// lists are shared by all isolates because finalizers can run on any
+// thread.
+struct PooledBufferHeader {
+  intptr_t size_class;
+  intptr_t capacity;
+  PooledBufferHeader* next;
+};
+
+static constexpr intptr_t kMinPooledSizeLog2 = 10;
+static constexpr intptr_t kMaxPooledSizeLog2 = 16;
+static constexpr intptr_t kNumSizeClasses =
+    kMaxPooledSizeLog2 - kMinPooledSizeLog2 + 1;
+static constexpr intptr_t kUnpooled = -1;
+static constexpr intptr_t kMaxCachedBytesPerClass = 1 * MB;
+static constexpr intptr_t kPooledHeaderSize =
+    Utils::RoundUp(sizeof(PooledBufferHeader), 16);
+
+// Created by the first InitPool and never deleted, so that finalizers which
+// release buffers after CleanupPool can still take it. The other fields are
+// guarded by it.
+static Mutex* pool_mutex = nullptr;
+static bool pool_enabled = false;
+static PooledBufferHeader* free_lists[kNumSizeClasses] = {};
+static intptr_t free_counts[kNumSizeClasses] = {};
+
+static PooledBufferHeader* HeaderOf(uint8_t* buffer) {
+  return reinterpret_cast<PooledBufferHeader*>(buffer - kPooledHeaderSize);
+}
+
+static uint8_t* DataOf(PooledBufferHeader* header) {
+  return reinterpret_cast<uint8_t*>(header) + kPooledHeaderSize;
+}
+
+static void PooledBufferFinalizer(void* isolate_callback_data, void* peer) {
+  IOBuffer::FreePooled(reinterpret_cast<uint8_t*>(peer));
+}
+
+static intptr_t SizeClassFor(intptr_t size) {
+  if (size > (static_cast<intptr_t>(1) << kMaxPooledSizeLog2)) {
+    return kUnpooled;
+  }
+  const intptr_t rounded = Utils::RoundUpToPowerOfTwo(
+      Utils::Maximum(size, static_cast<intptr_t>(1) << kMinPooledSizeLog2));
+  return Utils::ShiftForPowerOfTwo(rounded) - kMinPooledSizeLog2;
+}
+
+void IOBuffer::InitPool() {
+  // Called during embedder initialization, before any buffer is allocated.
+  if (pool_mutex == nullptr) {
+    pool_mutex = new Mutex();
+  }
+  MutexLocker ml(pool_mutex);
+  pool_enabled = true;
+}
+
+void IOBuffer::CleanupPool() {
+  if (pool_mutex == nullptr) {
+    return;
+  }
+  MutexLocker ml(pool_mutex);
+  pool_enabled = false;
+  for (intptr_t i = 0; i < kNumSizeClasses; i++) {
+    while (free_lists[i] != nullptr) {
+      PooledBufferHeader* header = free_lists[i];
+      free_lists[i] = header->next;
+      free(header);
+    }
+    free_counts[i] = 0;
+  }
+}
+
+uint8_t* IOBuffer::AllocatePooled(intptr_t size) {
+  const intptr_t size_class = SizeClassFor(size);
+  if ((size_class != kUnpooled) && (pool_mutex != nullptr)) {
+    MutexLocker ml(pool_mutex);
+    PooledBufferHeader* header = free_lists[size_class];
+    if (header != nullptr) {
+      free_lists[size_class] = header->next;
+      free_counts[size_class]--;
+      return DataOf(header);
+    }
+  }
+  const intptr_t capacity =
+      (size_class == kUnpooled)
+          ? size
+          : static_cast<intptr_t>(1) << (size_class + kMinPooledSizeLog2);
+  PooledBufferHeader* header = reinterpret_cast<PooledBufferHeader*>(
+      malloc(kPooledHeaderSize + capacity));
+  if (header == nullptr) {
+    return nullptr;
+  }
+  header->size_class = size_class;
+  header->capacity = capacity;
+  header->next = nullptr;
+  return DataOf(header);
+}
+
+Dart_Handle IOBuffer::WrapPooled(uint8_t* buffer, intptr_t length) {
+  PooledBufferHeader* header = HeaderOf(buffer);
+  ASSERT(length <= header->capacity);
+  Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kUint8, buffer, length, buffer, header->capacity,
+      PooledBufferFinalizer);
+  if (Dart_IsError(result)) {
+    FreePooled(buffer);
+    Dart_PropagateError(result);
+  }
+  return result;
+}
+
+void IOBuffer::FreePooled(uint8_t* buffer) {
+  PooledBufferHeader* header = HeaderOf(buffer);
+  const intptr_t size_class = header->size_class;
+  if ((size_class != kUnpooled) && (pool_mutex != nullptr)) {
+    MutexLocker ml(pool_mutex);
+    if (pool_enabled && ((free_counts[size_class] + 1) * header->capacity <=
+                         kMaxCachedBytesPerClass)) {
+      header->next = free_lists[size_class];
+      free_lists[size_class] = header;
+      free_counts[size_class]++;
+      return;
+    }
+  }
+  free(header);
+}
+
 Dart_Handle IOBuffer::Allocate(intptr_t size, uint8_t** buffer) {
   uint8_t* data = Allocate(size);
   if (data == nullptr) {
@@ -32,6 +32,27 @@ class IOBuffer {
     Free(buffer);
   }
 
+  // Allocate storage for reading up to `size` bytes. Buffers of up to 64 KB
+  // are taken from a pool of previously released buffers when possible.
+  // The storage is not zeroed. It must be passed to either WrapPooled or
+  // FreePooled.
+  static uint8_t* AllocatePooled(intptr_t size);
+
+  // Create a Uint8List of `length` bytes backed by storage from
+  // AllocatePooled, which is returned to the pool when the list is
+  // collected. `length` can be less than the size that was requested, so
+  // short reads need neither a second buffer nor a copy.
+  static Dart_Handle WrapPooled(uint8_t* buffer, intptr_t length);
+
+  // Return storage from AllocatePooled to the pool.
+  static void FreePooled(uint8_t* buffer);
+
+  // Enable and disable pooling. Buffers released while pooling is disabled,
+  // including ones released by finalizers after CleanupPool, are freed
+  // directly. Both may be called more than once.
+  static void InitPool();
+  static void CleanupPool();
+
  private:
   DISALLOW_ALLOCATION();
   DISALLOW_IMPLICIT_CONSTRUCTORS(IOBuffer);
@@ -0,0 +1,62 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/io_buffer.h"
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+namespace bin {
+
+VM_UNIT_TEST_CASE(IOBuffer_Pooled) {
+  // Without a pool buffers are freed directly.
+  uint8_t* buffer = IOBuffer::AllocatePooled(100);
+  EXPECT(buffer != nullptr);
+  IOBuffer::FreePooled(buffer);
+
+  IOBuffer::InitPool();
+
+  // Sizes in the same size class share buffers.
+  uint8_t* small = IOBuffer::AllocatePooled(100);
+  EXPECT(small != nullptr);
+  memset(small, 0xab, 1024);
+  IOBuffer::FreePooled(small);
+  EXPECT(IOBuffer::AllocatePooled(1000) == small);
+
+  // Different size classes do not.
+  uint8_t* large = IOBuffer::AllocatePooled(60 * KB);
+  EXPECT(large != nullptr);
+  EXPECT(large != small);
+  memset(large, 0xcd, 64 * KB);
+  IOBuffer::FreePooled(large);
+  IOBuffer::FreePooled(small);
+  EXPECT(IOBuffer::AllocatePooled(64 * KB) == large);
+  EXPECT(IOBuffer::AllocatePooled(1) == small);
+  IOBuffer::FreePooled(small);
+  IOBuffer::FreePooled(large);
+
+  // Buffers larger than the largest size class are not cached.
+  uint8_t* huge = IOBuffer::AllocatePooled(1 * MB);
+  EXPECT(huge != nullptr);
+  memset(huge, 0xef, 1 * MB);
+  IOBuffer::FreePooled(huge);
+
+  IOBuffer::CleanupPool();
+
+  // Buffers released after cleanup, e.g. by finalizers, are freed directly.
+  small = IOBuffer::AllocatePooled(100);
+  EXPECT(small != nullptr);
+  IOBuffer::FreePooled(small);
+
+  // The pool can be enabled again.
+  IOBuffer::InitPool();
+  small = IOBuffer::AllocatePooled(100);
+  IOBuffer::FreePooled(small);
+  EXPECT(IOBuffer::AllocatePooled(100) == small);
+  IOBuffer::FreePooled(small);
+  IOBuffer::CleanupPool();
+}
+
+}  // namespace bin
+}  // namespace dart
@@ -78,7 +78,7 @@ namespace bin {
   V(FileSystemWatcher_ReadEvents, 2)                                           \
   V(FileSystemWatcher_UnwatchPath, 2)                                          \
   V(FileSystemWatcher_WatchPath, 5)                                            \
-  V(Filter_CreateZLibDeflate, 8)                                               \
+  V(Filter_CreateZLibDeflate, 9)                                               \
   V(Filter_CreateZLibInflate, 5)                                               \
   V(Filter_Process, 4)                                                         \
   V(Filter_Processed, 3)                                                       \
@@ -120,6 +120,7 @@ namespace bin {
   V(RawSocketOption_GetOptionValue, 1)                                         \
   V(SecureSocket_Connect, 7)                                                   \
   V(SecureSocket_Destroy, 1)                                                   \
+  V(SecureSocket_EnableKernelTLS, 2)                                           \
   V(SecureSocket_FilterPointer, 1)                                             \
   V(SecureSocket_GetSelectedProtocol, 1)                                       \
   V(SecureSocket_Handshake, 2)                                                 \
@@ -164,14 +165,16 @@ namespace bin {
   V(Socket_JoinMulticast, 4)                                                   \
   V(Socket_LeaveMulticast, 4)                                                  \
   V(Socket_Read, 2)                                                            \
-  V(Socket_RecvFrom, 1)                                                        \
+  V(Socket_RecvFromBatch, 1)                                                   \
   V(Socket_ReceiveMessage, 2)                                                  \
   V(Socket_SendMessage, 5)                                                     \
+  V(Socket_SendFile, 4)                                                        \
   V(Socket_SendTo, 6)                                                          \
   V(Socket_SetOption, 4)                                                       \
   V(Socket_SetRawOption, 4)                                                    \
   V(Socket_SetSocketId, 3)                                                     \
   V(Socket_WriteList, 4)                                                       \
+  V(Socket_WriteGather, 2)                                                     \
   V(Socket_HasPendingWrite, 1)                                                 \
   V(SocketControlMessage_fromHandles, 2)                                       \
   V(SocketControlMessageImpl_extractHandles, 1)                                \
@@ -61,7 +61,10 @@ namespace bin {
   V(Directory, ListStart, 39)                                                  \
   V(Directory, ListNext, 40)                                                   \
   V(Directory, ListStop, 41)                                                   \
-  V(Directory, Rename, 42)
+  V(Directory, Rename, 42)                                                     \
+  V(File, ReadAt, 44)                                                          \
+  V(File, ReadFiles, 45)                                                       \
+  V(File, StatFiles, 46)
 
 #define DECLARE_REQUEST(type, method, id) k##type##method##Request = id,
 
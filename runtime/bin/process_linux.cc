@@ -7,15 +7,20 @@
 
 #include "bin/process.h"
 
+#include <dlfcn.h>         // NOLINT
 #include <errno.h>         // NOLINT
 #include <fcntl.h>         // NOLINT
 #include <poll.h>          // NOLINT
+#include <spawn.h>         // NOLINT
 #include <stdio.h>         // NOLINT
 #include <stdlib.h>        // NOLINT
 #include <string.h>        // NOLINT
 #include <sys/resource.h>  // NOLINT
 #include <sys/wait.h>      // NOLINT
 #include <unistd.h>        // NOLINT
+#if defined(__GLIBC__)
+#include <gnu/libc-version.h>  // NOLINT
+#endif
 
 #include "bin/dartutils.h"
 #include "bin/directory.h"
@@ -71,8 +76,16 @@ class ProcessInfoList {
   static void Init();
   static void Cleanup();
 
+  static Mutex* mutex() { return mutex_; }
+
   static void AddProcess(pid_t pid, intptr_t fd) {
     MutexLocker locker(mutex_);
+    AddProcessLocked(pid, fd);
+  }
+
+  // Like AddProcess, for callers that already hold mutex().
+  static void AddProcessLocked(pid_t pid, intptr_t fd) {
+    ASSERT(mutex_->IsOwnedByCurrentThread());
     ProcessInfo* info = new ProcessInfo(pid, fd);
     info->set_next(active_processes_);
     active_processes_ = info;
@@ -135,21 +148,25 @@ class ExitCodeHandler {
 
   // Notify the ExitCodeHandler that another process exists.
   static void ProcessStarted() {
-    // Multiple isolates could be starting processes at the same
-    // time. Make sure that only one ExitCodeHandler thread exists.
     MonitorLocker locker(monitor_);
-    process_count_++;
-
-    monitor_->Notify();
+    ProcessStartedLocked();
+  }
 
-    if (running_) {
-      return;
+  // Notify the ExitCodeHandler of the process started by |spawn| before
+  // starting it, the same way ProcessStarted is called for a forked child
+  // before it may exec. The monitor stays held while spawning, so the exit
+  // code handler thread cannot call wait() before the child exists. |spawn|
+  // returns 0 on success or an error number, in which case the process is
+  // not counted.
+  template <typename Spawn>
+  static int SpawnProcess(Spawn spawn) {
+    MonitorLocker locker(monitor_);
+    ProcessStartedLocked();
+    int err = spawn();
+    if (err != 0) {
+      process_count_--;
     }
-
-    // Start thread that handles process exits when wait returns.
-    Thread::Start("dart:io Process.start", ExitCodeHandlerEntry, 0);
-
-    running_ = true;
+    return err;
   }
 
   static void TerminateExitCodeThread() {
@@ -178,6 +195,23 @@ class ExitCodeHandler {
   }
 
  private:
+  static void ProcessStartedLocked() {
+    // Multiple isolates could be starting processes at the same
+    // time. Make sure that only one ExitCodeHandler thread exists.
+    process_count_++;
+
+    monitor_->Notify();
+
+    if (running_) {
+      return;
+    }
+
+    // Start thread that handles process exits when wait returns.
+    Thread::Start("dart:io Process.start", ExitCodeHandlerEntry, 0);
+
+    running_ = true;
+  }
+
   // Entry point for the separate exit code handler thread started by
   // the ExitCodeHandler.
   static void ExitCodeHandlerEntry(uword param) {
@@ -282,6 +316,32 @@ static bool PathInNamespace(char* realpath,
   return true;
 }
 
+#if defined(__GLIBC__)
+typedef int (*SpawnAddChdir)(posix_spawn_file_actions_t* actions,
+                             const char* path);
+
+// posix_spawn_file_actions_addchdir_np is only available from glibc 2.29 on,
+// so it is looked up when first needed. Returns nullptr if it is missing.
+static SpawnAddChdir LookupSpawnAddChdir() {
+  static const SpawnAddChdir add_chdir = reinterpret_cast<SpawnAddChdir>(
+      dlsym(RTLD_DEFAULT, "posix_spawn_file_actions_addchdir_np"));
+  return add_chdir;
+}
+
+// From glibc 2.24 on posix_spawn is implemented with
+// clone(CLONE_VM | CLONE_VFORK) and reports exec errors to the caller.
+// Before that it forks and exits the child with 127 if exec fails.
+static bool SpawnReportsExecErrors() {
+  static const bool reports_exec_errors = []() {
+    int major = 0;
+    int minor = 0;
+    sscanf(gnu_get_libc_version(), "%d.%d", &major, &minor);
+    return (major > 2) || ((major == 2) && (minor >= 24));
+  }();
+  return reports_exec_errors;
+}
+#endif  // defined(__GLIBC__)
+
 class ProcessStarter {
  public:
   ProcessStarter(Namespace* namespc,
@@ -343,6 +403,51 @@ class ProcessStarter {
       return err;
     }
 
+    pid_t pid;
+    if (CanSpawn()) {
+      err = SpawnProcess(&pid);
+    } else {
+      err = ForkProcess(&pid);
+    }
+    if (err != 0) {
+      return err;
+    }
+
+    if (Process::ModeHasStdio(mode_)) {
+      // Connect stdio, stdout and stderr.
+      FDUtils::SetNonBlocking(read_in_[0]);
+      *in_ = read_in_[0];
+      close(read_in_[1]);
+      FDUtils::SetNonBlocking(write_out_[1]);
+      *out_ = write_out_[1];
+      close(write_out_[0]);
+      FDUtils::SetNonBlocking(read_err_[0]);
+      *err_ = read_err_[0];
+      close(read_err_[1]);
+    } else {
+      // Close all fds.
+      close(read_in_[0]);
+      close(read_in_[1]);
+      ASSERT(write_out_[0] == -1);
+      ASSERT(write_out_[1] == -1);
+      ASSERT(read_err_[0] == -1);
+      ASSERT(read_err_[1] == -1);
+    }
+    ASSERT(exec_control_[0] == -1);
+    ASSERT(exec_control_[1] == -1);
+
+    *id_ = pid;
+    return 0;
+  }
+
+ private:
+  static constexpr int kErrorBufferSize = 1024;
+
+  // Starts the process with fork and exec. The child waits for the parent
+  // to register it before calling exec, and reports errors through the exec
+  // control pipe.
+  int ForkProcess(pid_t* pid_result) {
+    int err;
     // Fork to create the new process.
     pid_t pid = TEMP_FAILURE_RETRY(fork());
     if (pid < 0) {
@@ -402,36 +507,118 @@ class ProcessStarter {
       return err;
     }
 
-    if (Process::ModeHasStdio(mode_)) {
-      // Connect stdio, stdout and stderr.
-      FDUtils::SetNonBlocking(read_in_[0]);
-      *in_ = read_in_[0];
-      close(read_in_[1]);
-      FDUtils::SetNonBlocking(write_out_[1]);
-      *out_ = write_out_[1];
-      close(write_out_[0]);
-      FDUtils::SetNonBlocking(read_err_[0]);
-      *err_ = read_err_[0];
-      close(read_err_[1]);
+    *pid_result = pid;
+    return 0;
+  }
+
+  // Whether the process can be started with posix_spawn, which avoids
+  // copying the page tables of this process. Detached processes still need
+  // the double fork so they are not our children, and working directories in
+  // non-default namespaces are resolved by the forked child.
+  bool CanSpawn() {
+#if defined(__GLIBC__)
+    if (!Process::ModeIsAttached(mode_) || !Namespace::IsDefault(namespc_) ||
+        !SpawnReportsExecErrors()) {
+      return false;
+    }
+    if ((working_directory_ != nullptr) && (LookupSpawnAddChdir() == nullptr)) {
+      return false;
+    }
+    return SamePathSearch();
+#else
+    return false;
+#endif
+  }
+
+  // posix_spawnp searches the PATH of this process, whereas execvp in the
+  // forked child searches the PATH of the new environment. Returns whether
+  // the two searches are the same.
+  bool SamePathSearch() {
+    if ((program_environment_ == nullptr) || (strchr(path_, '/') != nullptr)) {
+      return true;
+    }
+    const char* child_path = nullptr;
+    for (char** entry = program_environment_; *entry != nullptr; entry++) {
+      if (strncmp(*entry, "PATH=", 5) == 0) {
+        child_path = *entry + 5;
+        break;
+      }
+    }
+    const char* parent_path = getenv("PATH");
+    if ((child_path == nullptr) || (parent_path == nullptr)) {
+      return child_path == parent_path;
+    }
+    return strcmp(child_path, parent_path) == 0;
+  }
+
+  // Starts the process with posix_spawn. Errors from setting up the child and
+  // from exec are returned by posix_spawn itself, so the exec control pipe is
+  // not used.
+  int SpawnProcess(pid_t* pid) {
+#if defined(__GLIBC__)
+    ClosePipe(exec_control_);
+
+    posix_spawn_file_actions_t actions;
+    int err = posix_spawn_file_actions_init(&actions);
+    if (err != 0) {
+      errno = err;
+      return CleanupAndReturnError();
+    }
+    if (mode_ == kNormal) {
+      err = posix_spawn_file_actions_adddup2(&actions, write_out_[0],
+                                             STDIN_FILENO);
+      if (err == 0) {
+        err = posix_spawn_file_actions_adddup2(&actions, read_in_[1],
+                                               STDOUT_FILENO);
+      }
+      if (err == 0) {
+        err = posix_spawn_file_actions_adddup2(&actions, read_err_[1],
+                                               STDERR_FILENO);
+      }
     } else {
-      // Close all fds.
-      close(read_in_[0]);
-      close(read_in_[1]);
-      ASSERT(write_out_[0] == -1);
-      ASSERT(write_out_[1] == -1);
-      ASSERT(read_err_[0] == -1);
-      ASSERT(read_err_[1] == -1);
+      ASSERT(mode_ == kInheritStdio);
+    }
+    if ((err == 0) && (working_directory_ != nullptr)) {
+      err = LookupSpawnAddChdir()(&actions, working_directory_);
     }
-    ASSERT(exec_control_[0] == -1);
-    ASSERT(exec_control_[1] == -1);
 
-    *id_ = pid;
+    // The child is not held back until it is registered like a forked one,
+    // so count it before spawning and register it while holding the process
+    // list lock. The exit code handler then cannot look up the pid before it
+    // has been added.
+    int event_fds[2] = {-1, -1};
+    if ((err == 0) && (TEMP_FAILURE_RETRY(pipe2(event_fds, O_CLOEXEC)) < 0)) {
+      err = errno;
+    }
+    if (err == 0) {
+      char** envp =
+          (program_environment_ != nullptr) ? program_environment_ : environ;
+      err = ExitCodeHandler::SpawnProcess([&]() {
+        MutexLocker locker(ProcessInfoList::mutex());
+        int result =
+            posix_spawnp(pid, path_, &actions, nullptr,
+                         const_cast<char* const*>(program_arguments_), envp);
+        if (result == 0) {
+          ProcessInfoList::AddProcessLocked(*pid, event_fds[1]);
+        }
+        return result;
+      });
+    }
+    posix_spawn_file_actions_destroy(&actions);
+    if (err != 0) {
+      ClosePipe(event_fds);
+      errno = err;
+      return CleanupAndReturnError();
+    }
+    *exit_event_ = event_fds[0];
+    FDUtils::SetNonBlocking(event_fds[0]);
     return 0;
+#else
+    UNREACHABLE();
+    return ENOSYS;
+#endif
   }
 
- private:
-  static constexpr int kErrorBufferSize = 1024;
-
   int CreatePipes() {
     int result;
     result = TEMP_FAILURE_RETRY(pipe2(exec_control_, O_CLOEXEC));
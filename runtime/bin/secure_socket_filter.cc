@@ -7,12 +7,21 @@
 #include "bin/secure_socket_filter.h"
 
 #include <openssl/bio.h>
+#include <openssl/hkdf.h>
+#include <openssl/mem.h>
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 
+#if defined(DART_HOST_OS_LINUX)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
 #include "bin/lockers.h"
 #include "bin/secure_socket_utils.h"
 #include "bin/security_context.h"
+#include "bin/socket.h"
 #include "bin/socket_base.h"
 #include "platform/syslog.h"
 #include "platform/text_buffer.h"
@@ -32,6 +41,7 @@ namespace bin {
 bool SSLFilter::library_initialized_ = false;
 // To protect library initialization.
 Mutex* SSLFilter::mutex_ = nullptr;
+bool SSLFilter::use_kernel_tls_ = false;
 int SSLFilter::filter_ssl_index;
 int SSLFilter::ssl_cert_context_index;
 
@@ -175,6 +185,13 @@ void FUNCTION_NAME(SecureSocket_GetSelectedProtocol)(
   GetFilter(args)->GetSelectedProtocol(args);
 }
 
+void FUNCTION_NAME(SecureSocket_EnableKernelTLS)(Dart_NativeArguments args) {
+  SSLFilter* filter = GetFilter(args);
+  Socket* socket = Socket::GetSocketIdNativeField(
+      ThrowIfError(Dart_GetNativeArgument(args, 1)));
+  Dart_SetBooleanReturnValue(args, filter->EnableKernelTLS(socket->fd()));
+}
+
 void FUNCTION_NAME(SecureSocket_RegisterHandshakeCompleteCallback)(
     Dart_NativeArguments args) {
   Dart_Handle handshake_complete =
@@ -665,6 +682,161 @@ void SSLFilter::GetSelectedProtocol(Dart_NativeArguments args) {
   }
 }
 
+#if defined(DART_HOST_OS_LINUX)
+#if !defined(SOL_TLS)
+#define SOL_TLS 282
+#endif
+#if !defined(TCP_ULP)
+#define TCP_ULP 31
+#endif
+
+// Stores the low [length] bytes of [value] in big-endian order.
+static void StoreBigEndian(uint64_t value, uint8_t* out, intptr_t length) {
+  for (intptr_t i = length - 1; i >= 0; i--) {
+    out[i] = static_cast<uint8_t>(value);
+    value >>= 8;
+  }
+}
+
+// HKDF-Expand-Label from RFC 8446, section 7.1, with an empty context.
+static bool ExpandLabel(uint8_t* out,
+                        size_t out_length,
+                        const EVP_MD* digest,
+                        const uint8_t* secret,
+                        size_t secret_length,
+                        const char* label) {
+  static const char kPrefix[] = "tls13 ";
+  const size_t prefix_length = strlen(kPrefix);
+  const size_t label_length = strlen(label);
+  uint8_t info[4 + 255];
+  size_t length = 0;
+  info[length++] = static_cast<uint8_t>(out_length >> 8);
+  info[length++] = static_cast<uint8_t>(out_length);
+  info[length++] = static_cast<uint8_t>(prefix_length + label_length);
+  memcpy(info + length, kPrefix, prefix_length);
+  length += prefix_length;
+  memcpy(info + length, label, label_length);
+  length += label_length;
+  info[length++] = 0;
+  return HKDF_expand(out, out_length, digest, secret, secret_length, info,
+                     length) == 1;
+}
+
+template <typename CryptoInfo>
+static bool SetKernelTLSKeys(intptr_t fd,
+                             uint16_t version,
+                             uint16_t cipher_type,
+                             const uint8_t* key,
+                             const uint8_t* iv,
+                             const uint8_t* sequence) {
+  CryptoInfo info;
+  memset(&info, 0, sizeof(info));
+  info.info.version = version;
+  info.info.cipher_type = cipher_type;
+  memcpy(info.key, key, sizeof(info.key));
+  memcpy(info.salt, iv, sizeof(info.salt));
+  memcpy(info.iv, iv + sizeof(info.salt), sizeof(info.iv));
+  memcpy(info.rec_seq, sequence, sizeof(info.rec_seq));
+  const bool result =
+      setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info)) == 0;
+  OPENSSL_cleanse(&info, sizeof(info));
+  return result;
+}
+#endif  // defined(DART_HOST_OS_LINUX)
+
+bool SSLFilter::EnableKernelTLS(intptr_t fd) {
+#if defined(DART_HOST_OS_LINUX)
+  // Opt-in while the kernel support is still young.
+  if (!use_kernel_tls_ || in_handshake_ ||
+      BIO_ctrl_pending(socket_side_) != 0) {
+    return false;
+  }
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl_);
+  if (cipher == nullptr) {
+    return false;
+  }
+  uint16_t cipher_type;
+  size_t key_length;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+    case NID_aes_128_gcm:
+      cipher_type = TLS_CIPHER_AES_GCM_128;
+      key_length = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+      break;
+    case NID_aes_256_gcm:
+      cipher_type = TLS_CIPHER_AES_GCM_256;
+      key_length = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+      break;
+    default:
+      return false;
+  }
+
+  // The AES-GCM nonce is a 4 byte salt followed by 8 bytes of IV.
+  const size_t kSaltLength = 4;
+  uint8_t key[TLS_CIPHER_AES_GCM_256_KEY_SIZE];
+  uint8_t iv[12];
+  uint8_t sequence[8];
+  const uint64_t write_sequence = SSL_get_write_sequence(ssl_);
+  StoreBigEndian(write_sequence, sequence, sizeof(sequence));
+  uint16_t version;
+  bool keys_ready = false;
+  switch (SSL_version(ssl_)) {
+    case TLS1_2_VERSION: {
+      version = TLS_1_2_VERSION;
+      // The key block holds the client and server keys followed by the
+      // client and server salts. AEAD ciphers have no MAC keys.
+      uint8_t block[2 * (TLS_CIPHER_AES_GCM_256_KEY_SIZE + kSaltLength)];
+      const size_t block_length = SSL_get_key_block_len(ssl_);
+      if (block_length == 2 * (key_length + kSaltLength) &&
+          SSL_generate_key_block(ssl_, block, block_length)) {
+        const intptr_t side = is_server_ ? 1 : 0;
+        memcpy(key, block + side * key_length, key_length);
+        memcpy(iv, block + 2 * key_length + side * kSaltLength, kSaltLength);
+        // BoringSSL uses the record sequence number as the explicit nonce,
+        // which the kernel continues from.
+        StoreBigEndian(write_sequence, iv + kSaltLength, 8);
+        keys_ready = true;
+      }
+      OPENSSL_cleanse(block, sizeof(block));
+      break;
+    }
+    case TLS1_3_VERSION: {
+      version = TLS_1_3_VERSION;
+      bssl::Span<const uint8_t> read_secret;
+      bssl::Span<const uint8_t> write_secret;
+      const EVP_MD* digest = SSL_CIPHER_get_handshake_digest(cipher);
+      keys_ready =
+          bssl::SSL_get_traffic_secrets(ssl_, &read_secret, &write_secret) &&
+          ExpandLabel(key, key_length, digest, write_secret.data(),
+                      write_secret.size(), "key") &&
+          ExpandLabel(iv, sizeof(iv), digest, write_secret.data(),
+                      write_secret.size(), "iv");
+      break;
+    }
+    default:
+      return false;
+  }
+
+  bool result = false;
+  if (keys_ready &&
+      setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0) {
+    // Without TLS_TX the socket keeps sending data as it is, so a failure
+    // here leaves the connection on the user space path.
+    if (cipher_type == TLS_CIPHER_AES_GCM_128) {
+      result = SetKernelTLSKeys<tls12_crypto_info_aes_gcm_128>(
+          fd, version, cipher_type, key, iv, sequence);
+    } else {
+      result = SetKernelTLSKeys<tls12_crypto_info_aes_gcm_256>(
+          fd, version, cipher_type, key, iv, sequence);
+    }
+  }
+  OPENSSL_cleanse(key, sizeof(key));
+  OPENSSL_cleanse(iv, sizeof(iv));
+  return result;
+#else
+  return false;
+#endif  // defined(DART_HOST_OS_LINUX)
+}
+
 void SSLFilter::FreeResources() {
   if (ssl_ != nullptr) {
     SSL_free(ssl_);
@@ -85,6 +85,14 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
   void MarkAsTrusted(Dart_NativeArguments args);
   int Handshake(Dart_Port reply_port);
   void GetSelectedProtocol(Dart_NativeArguments args);
+  // Hands record encryption for data written to the socket [fd] over to the
+  // kernel. Only possible once every record BoringSSL produced has been
+  // written out. Returns false if the connection stays in user space.
+  bool EnableKernelTLS(intptr_t fd);
+  // Whether EnableKernelTLS may hand encryption over to the kernel. Set by
+  // the --kernel_tls option.
+  static bool use_kernel_tls() { return use_kernel_tls_; }
+  static void set_use_kernel_tls(bool value) { use_kernel_tls_ = value; }
   void RegisterHandshakeCompleteCallback(Dart_Handle handshake_complete);
   void RegisterBadCertificateCallback(Dart_Handle callback);
   void RegisterKeyLogPort(Dart_Port key_log_port);
@@ -123,6 +131,7 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
   static const intptr_t kInternalBIOSize;
   static bool library_initialized_;
   static Mutex* mutex_;  // To protect library initialization.
+  static bool use_kernel_tls_;
 
   SSL* ssl_;
   BIO* socket_side_;
@@ -538,38 +538,27 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
     if (Socket::short_socket_read()) {
       length = (length + 1) / 2;
     }
-    uint8_t* buffer = nullptr;
-    Dart_Handle result = IOBuffer::Allocate(length, &buffer);
-    if (Dart_IsNull(result)) {
+    uint8_t* buffer = IOBuffer::AllocatePooled(length);
+    if (buffer == nullptr) {
       Dart_ThrowException(DartUtils::NewDartOSError());
     }
-    if (Dart_IsError(result)) {
-      Dart_PropagateError(result);
-    }
-    ASSERT(buffer != nullptr);
     intptr_t bytes_read =
         SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
-    if (bytes_read == length) {
-      Dart_SetReturnValue(args, result);
-    } else if (bytes_read > 0) {
-      uint8_t* new_buffer = nullptr;
-      Dart_Handle new_result = IOBuffer::Allocate(bytes_read, &new_buffer);
-      if (Dart_IsNull(new_result)) {
-        Dart_ThrowException(DartUtils::NewDartOSError());
-      }
-      if (Dart_IsError(new_result)) {
-        Dart_PropagateError(new_result);
-      }
-      ASSERT(new_buffer != nullptr);
-      memmove(new_buffer, buffer, bytes_read);
-      Dart_SetReturnValue(args, new_result);
+    if (bytes_read > 0) {
+      // A short read is returned in the same buffer.
+      Dart_SetReturnValue(args, IOBuffer::WrapPooled(buffer, bytes_read));
     } else if (bytes_read == 0) {
       // On MacOS when reading from a tty Ctrl-D will result in reading one
       // less byte then reported as available.
+      IOBuffer::FreePooled(buffer);
       Dart_SetReturnValue(args, Dart_Null());
     } else {
       ASSERT(bytes_read == -1);
-      Dart_ThrowException(DartUtils::NewDartOSError());
+      // Extract OSError before we release the buffer, as it may override the
+      // error.
+      Dart_Handle error = DartUtils::NewDartOSError();
+      IOBuffer::FreePooled(buffer);
+      Dart_ThrowException(error);
     }
   } else {
     Dart_Handle exception;
@@ -582,64 +571,58 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
   }
 }
 
-void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
-  // TODO(sgjesse): Use a MTU value here. Only the loopback adapter can
-  // handle 64k datagrams.
-  const int kReceiveBufferLen = 65536;
-  Socket* socket =
-      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+// TODO(sgjesse): Use a MTU value here. Only the loopback adapter can
+// handle 64k datagrams.
+static constexpr intptr_t kReceiveBufferLen = 65536;
+// Maximum number of datagrams received by Socket_RecvFromBatch.
+static constexpr intptr_t kMaxDatagramBatch = 8;
 
-  // Ensure that a receive buffer for the UDP socket exists.
+// Ensure that a receive buffer for the UDP socket with room for
+// kMaxDatagramBatch datagrams of kReceiveBufferLen bytes each exists.
+// Returns nullptr if it cannot be allocated.
+static uint8_t* EnsureUdpReceiveBuffer(Socket* socket) {
   ASSERT(socket != nullptr);
   uint8_t* recv_buffer = socket->udp_receive_buffer();
   if (recv_buffer == nullptr) {
-    recv_buffer = reinterpret_cast<uint8_t*>(malloc(kReceiveBufferLen));
+    recv_buffer = reinterpret_cast<uint8_t*>(
+        malloc(kReceiveBufferLen * kMaxDatagramBatch));
     socket->set_udp_receive_buffer(recv_buffer);
   }
+  return recv_buffer;
+}
 
-  // Read data into the buffer.
-  RawAddr addr;
-  const intptr_t bytes_read = SocketBase::RecvFrom(
-      socket->fd(), recv_buffer, kReceiveBufferLen, &addr, SocketBase::kAsync);
-  if (bytes_read == 0) {
-    Dart_SetReturnValue(args, Dart_Null());
-    return;
-  }
-  if (bytes_read < 0) {
-    ASSERT(bytes_read == -1);
-    Dart_ThrowException(DartUtils::NewDartOSError());
-  }
-
+// Creates a Datagram object with a copy of the data and the sender address
+// and port.
+static Dart_Handle NewDatagram(Dart_Handle io_lib,
+                               const uint8_t* recv_buffer,
+                               intptr_t bytes_read,
+                               RawAddr* addr) {
   // Datagram data read. Copy into buffer of the exact size,
   ASSERT(bytes_read >= 0);
-  uint8_t* data_buffer = nullptr;
-  Dart_Handle data = IOBuffer::Allocate(bytes_read, &data_buffer);
-  if (Dart_IsNull(data)) {
+  uint8_t* data_buffer = IOBuffer::AllocatePooled(bytes_read);
+  if (data_buffer == nullptr) {
     Dart_ThrowException(DartUtils::NewDartOSError());
   }
-  if (Dart_IsError(data)) {
-    Dart_PropagateError(data);
-  }
-  ASSERT(data_buffer != nullptr);
   memmove(data_buffer, recv_buffer, bytes_read);
+  Dart_Handle data = IOBuffer::WrapPooled(data_buffer, bytes_read);
 
   // Get the port and clear it in the sockaddr structure.
-  int port = SocketAddress::GetAddrPort(addr);
+  int port = SocketAddress::GetAddrPort(*addr);
   // TODO(21403): Add checks for AF_UNIX, if unix domain sockets
   // are used in SOCK_DGRAM.
   enum internet_type { IPv4, IPv6 };
   internet_type type;
-  if (addr.addr.sa_family == AF_INET) {
-    addr.in.sin_port = 0;
+  if (addr->addr.sa_family == AF_INET) {
+    addr->in.sin_port = 0;
     type = IPv4;
   } else {
-    ASSERT(addr.addr.sa_family == AF_INET6);
-    addr.in6.sin6_port = 0;
+    ASSERT(addr->addr.sa_family == AF_INET6);
+    addr->in6.sin6_port = 0;
     type = IPv6;
   }
   // Format the address to a string using the numeric format.
   char numeric_address[INET6_ADDRSTRLEN];
-  SocketBase::FormatNumericAddress(addr, numeric_address, INET6_ADDRSTRLEN);
+  SocketBase::FormatNumericAddress(*addr, numeric_address, INET6_ADDRSTRLEN);
 
   // Create a Datagram object with the data and sender address and port.
   const int kNumArgs = 5;
@@ -649,20 +632,62 @@ void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
   if (Dart_IsError(dart_args[1])) {
     Dart_PropagateError(dart_args[1]);
   }
-  dart_args[2] = SocketAddress::ToTypedData(addr);
+  dart_args[2] = SocketAddress::ToTypedData(*addr);
   dart_args[3] = Dart_NewInteger(port);
   dart_args[4] = Dart_NewInteger(type);
   if (Dart_IsError(dart_args[3])) {
     Dart_PropagateError(dart_args[3]);
   }
-  // TODO(sgjesse): Cache the _makeDatagram function somewhere.
-  Dart_Handle io_lib = Dart_LookupLibrary(DartUtils::NewString("dart:io"));
-  if (Dart_IsError(io_lib)) {
-    Dart_PropagateError(io_lib);
+  return Dart_Invoke(io_lib, DartUtils::NewString("_makeDatagram"), kNumArgs,
+                     dart_args);
+}
+
+void FUNCTION_NAME(Socket_RecvFromBatch)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  uint8_t* recv_buffer = EnsureUdpReceiveBuffer(socket);
+  if (recv_buffer == nullptr) {
+    Dart_ThrowException(DartUtils::NewDartOSError());
+  }
+
+  // Read up to kMaxDatagramBatch datagrams into the buffer. The count
+  // returned tells how many slots were filled.
+  intptr_t lengths[kMaxDatagramBatch];
+  RawAddr addrs[kMaxDatagramBatch];
+  const intptr_t count = SocketBase::RecvFromBatch(
+      socket->fd(), recv_buffer, kReceiveBufferLen, kMaxDatagramBatch,
+      lengths, addrs, SocketBase::kAsync);
+  if (count == 0) {
+    Dart_SetReturnValue(args, Dart_Null());
+    return;
   }
-  Dart_Handle result = Dart_Invoke(
-      io_lib, DartUtils::NewString("_makeDatagram"), kNumArgs, dart_args);
-  Dart_SetReturnValue(args, result);
+  if (count < 0) {
+    ASSERT(count == -1);
+    Dart_ThrowException(DartUtils::NewDartOSError());
+  }
+
+  // Empty datagrams are consumed but not returned.
+  intptr_t non_empty = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    if (lengths[i] > 0) non_empty++;
+  }
+  if (non_empty == 0) {
+    Dart_SetReturnValue(args, Dart_Null());
+    return;
+  }
+
+  Dart_Handle io_lib =
+      ThrowIfError(Dart_LookupLibrary(DartUtils::NewString("dart:io")));
+  Dart_Handle list = ThrowIfError(Dart_NewList(non_empty));
+  intptr_t index = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    if (lengths[i] == 0) continue;
+    Dart_Handle datagram =
+        ThrowIfError(NewDatagram(io_lib, recv_buffer + i * kReceiveBufferLen,
+                                 lengths[i], &addrs[i]));
+    ThrowIfError(Dart_ListSetAt(list, index++, datagram));
+  }
+  Dart_SetReturnValue(args, list);
 }
 
 void FUNCTION_NAME(Socket_ReceiveMessage)(Dart_NativeArguments args) {
@@ -782,6 +807,90 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
   }
 }
 
+void FUNCTION_NAME(Socket_WriteGather)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  // List of triples <buffer, start, length> arranged to minimize dart api use
+  // in native methods.
+  Dart_Handle buffers_list = ThrowIfError(Dart_GetNativeArgument(args, 1));
+  ASSERT(Dart_IsList(buffers_list));
+  intptr_t num_pieces;
+  ThrowIfError(Dart_ListLength(buffers_list, &num_pieces));
+  const intptr_t kMaxBuffers = 32;
+  intptr_t count = Utils::Minimum(num_pieces / 3, kMaxBuffers);
+  ASSERT(count > 0);
+  Dart_Handle buffer_objs[kMaxBuffers];
+  intptr_t starts[kMaxBuffers];
+  intptr_t lengths[kMaxBuffers];
+  const uint8_t* buffers[kMaxBuffers];
+  intptr_t total_length = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    buffer_objs[i] = ThrowIfError(Dart_ListGetAt(buffers_list, i * 3));
+    starts[i] = DartUtils::GetIntptrValue(
+        ThrowIfError(Dart_ListGetAt(buffers_list, i * 3 + 1)));
+    lengths[i] = DartUtils::GetIntptrValue(
+        ThrowIfError(Dart_ListGetAt(buffers_list, i * 3 + 2)));
+    total_length += lengths[i];
+  }
+  bool short_write = false;
+  if (Socket::short_socket_write()) {
+    if (total_length > 1) {
+      short_write = true;
+    }
+    // Only write the first half of the data.
+    intptr_t remaining = (total_length + 1) / 2;
+    for (intptr_t i = 0; i < count; i++) {
+      if (lengths[i] >= remaining) {
+        lengths[i] = remaining;
+        count = i + 1;
+        break;
+      }
+      remaining -= lengths[i];
+    }
+  }
+  // Acquiring the data of several objects at once is fine as long as no
+  // object is acquired twice, which the caller guarantees.
+  for (intptr_t i = 0; i < count; i++) {
+    Dart_TypedData_Type type;
+    uint8_t* buffer = nullptr;
+    intptr_t len;
+    Dart_Handle result = Dart_TypedDataAcquireData(
+        buffer_objs[i], &type, reinterpret_cast<void**>(&buffer), &len);
+    if (Dart_IsError(result)) {
+      for (intptr_t j = 0; j < i; j++) {
+        Dart_TypedDataReleaseData(buffer_objs[j]);
+      }
+      Dart_PropagateError(result);
+    }
+    ASSERT((starts[i] + lengths[i]) <= len);
+    buffers[i] = buffer + starts[i];
+  }
+  intptr_t bytes_written = SocketBase::WriteGather(
+      socket->fd(), buffers, lengths, count, SocketBase::kAsync);
+  if (bytes_written >= 0) {
+    for (intptr_t i = 0; i < count; i++) {
+      Dart_TypedDataReleaseData(buffer_objs[i]);
+    }
+    if (short_write) {
+      // See Socket_WriteList.
+      Dart_SetIntegerReturnValue(args, -bytes_written);
+    } else {
+      Dart_SetIntegerReturnValue(args, bytes_written);
+    }
+  } else {
+    // Extract OSError before we release data, as it may override the error.
+    Dart_Handle error;
+    {
+      OSError os_error;
+      for (intptr_t i = 0; i < count; i++) {
+        Dart_TypedDataReleaseData(buffer_objs[i]);
+      }
+      error = DartUtils::NewDartOSError(&os_error);
+    }
+    Dart_ThrowException(error);
+  }
+}
+
 void FUNCTION_NAME(Socket_SendMessage)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
@@ -846,6 +955,28 @@ void FUNCTION_NAME(Socket_SendMessage)(Dart_NativeArguments args) {
   Dart_SetIntegerReturnValue(args, bytes_written);
 }
 
+void FUNCTION_NAME(Socket_SendFile)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  intptr_t file_fd = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 1));
+  int64_t offset = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 2), 0, kMaxInt64);
+  intptr_t length = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 3));
+  if (Socket::short_socket_write() && (length > 1)) {
+    length = (length + 1) / 2;
+  }
+  intptr_t bytes_sent =
+      SocketBase::SendFile(socket->fd(), file_fd, offset, length);
+  if (bytes_sent >= 0) {
+    Dart_SetIntegerReturnValue(args, bytes_sent);
+  } else if (errno == EWOULDBLOCK) {
+    // The socket cannot take more data. Wait for a write event.
+    Dart_SetReturnValue(args, Dart_Null());
+  } else {
+    Dart_ThrowException(DartUtils::NewDartOSError());
+  }
+}
+
 void FUNCTION_NAME(Socket_SendTo)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
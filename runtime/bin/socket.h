@@ -51,6 +51,10 @@ class Socket : public ReferenceCounted<Socket> {
 
   intptr_t fd() const { return fd_; }
 
+  // The descriptor the socket was created with. Unlike fd(), it does not
+  // change when the socket is closed, so any thread may read it.
+  intptr_t initial_fd() const { return initial_fd_; }
+
   // Close fd and may need to decrement the count of handle by calling
   // release().
   void CloseFd();
@@ -125,6 +129,7 @@ class Socket : public ReferenceCounted<Socket> {
   static bool short_socket_write_;
 
   intptr_t fd_;
+  const intptr_t initial_fd_;
   Dart_Port isolate_port_;
   Dart_Port port_;
   uint8_t* udp_receive_buffer_;
@@ -345,6 +345,42 @@ intptr_t SocketBase::Write(intptr_t fd,
 
   return num_bytes - num_bytes_left;
 }
+
+intptr_t SocketBase::WriteGather(intptr_t fd,
+                                 const uint8_t* const* buffers,
+                                 const intptr_t* lengths,
+                                 intptr_t count,
+                                 SocketOpKind sync) {
+  // As in Write, write until EAGAIN to keep getting edge-triggered events.
+  intptr_t total_written = 0;
+  intptr_t index = 0;
+  intptr_t offset = 0;
+  while (true) {
+    // Skip the buffers that have been written completely.
+    while ((index < count) && (offset >= lengths[index])) {
+      offset -= lengths[index];
+      index++;
+    }
+    if (index == count) {
+      break;
+    }
+    intptr_t written_bytes = WriteGatherImpl(
+        fd, buffers + index, lengths + index, count - index, offset, sync);
+    static_assert(EAGAIN == EWOULDBLOCK);
+    if (written_bytes == -1) {
+      if ((sync == kAsync) && (errno == EWOULDBLOCK)) {
+        break;
+      }
+
+      return -1;  // Error occurred.
+    }
+
+    total_written += written_bytes;
+    offset += written_bytes;
+  }
+
+  return total_written;
+}
 #endif
 
 }  // namespace bin
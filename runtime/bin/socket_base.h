@@ -196,6 +196,22 @@ class SocketBase : public AllStatic {
                         const void* buffer,
                         intptr_t num_bytes,
                         SocketOpKind sync);
+  // Writes `count` buffers as if they were one contiguous buffer, using a
+  // single system call where the platform supports it. Returns the total
+  // number of bytes written.
+  static intptr_t WriteGather(intptr_t fd,
+                              const uint8_t* const* buffers,
+                              const intptr_t* lengths,
+                              intptr_t count,
+                              SocketOpKind sync);
+  // Send up to `length` bytes of the file `file_fd` starting at `offset` to
+  // the socket without copying them to user space. The file position is not
+  // changed. Returns the number of bytes sent, 0 at the end of the file or
+  // -1 on error. errno is EWOULDBLOCK if the socket cannot take more data.
+  static intptr_t SendFile(intptr_t fd,
+                           intptr_t file_fd,
+                           int64_t offset,
+                           intptr_t length);
 
   // Send data on a socket. The port to send to is specified in the port
   // component of the passed RawAddr structure. The RawAddr structure is only
@@ -217,6 +233,17 @@ class SocketBase : public AllStatic {
                            intptr_t num_bytes,
                            RawAddr* addr,
                            SocketOpKind sync);
+  // Receive up to `max_count` datagrams with as few system calls as the
+  // platform allows. Datagram i is stored at buffer + i * slot_size, its
+  // length in lengths[i] and its sender in addrs[i]. Returns the number of
+  // datagrams received, 0 if none is available, or -1 on error.
+  static intptr_t RecvFromBatch(intptr_t fd,
+                                uint8_t* buffer,
+                                intptr_t slot_size,
+                                intptr_t max_count,
+                                intptr_t* lengths,
+                                RawAddr* addrs,
+                                SocketOpKind sync);
   static intptr_t ReceiveMessage(intptr_t fd,
                                  void* buffer,
                                  int64_t* p_buffer_num_bytes,
@@ -294,6 +321,14 @@ class SocketBase : public AllStatic {
                             const void* buffer,
                             intptr_t num_bytes,
                             SocketOpKind sync);
+  // Writes as much as possible of the buffers, skipping the first `offset`
+  // bytes of the first one.
+  static intptr_t WriteGatherImpl(intptr_t fd,
+                                  const uint8_t* const* buffers,
+                                  const intptr_t* lengths,
+                                  intptr_t count,
+                                  intptr_t offset,
+                                  SocketOpKind sync);
 #endif
 
   DISALLOW_ALLOCATION();
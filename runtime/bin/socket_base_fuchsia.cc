@@ -123,6 +123,17 @@ intptr_t SocketBase::RecvFrom(intptr_t fd,
   return -1;
 }
 
+intptr_t SocketBase::RecvFromBatch(intptr_t fd,
+                                   uint8_t* buffer,
+                                   intptr_t slot_size,
+                                   intptr_t max_count,
+                                   intptr_t* lengths,
+                                   RawAddr* addrs,
+                                   SocketOpKind sync) {
+  errno = ENOSYS;
+  return -1;
+}
+
 bool SocketControlMessage::is_file_descriptors_control_message() {
   return false;
 }
@@ -162,6 +173,24 @@ intptr_t SocketBase::WriteImpl(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::WriteGatherImpl(intptr_t fd,
+                                     const uint8_t* const* buffers,
+                                     const intptr_t* lengths,
+                                     intptr_t count,
+                                     intptr_t offset,
+                                     SocketOpKind sync) {
+  // IOHandle has no gather write; WriteGather calls this once per buffer.
+  return WriteImpl(fd, buffers[0] + offset, lengths[0] - offset, sync);
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              intptr_t file_fd,
+                              int64_t offset,
+                              intptr_t length) {
+  errno = ENOSYS;
+  return -1;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -14,13 +14,19 @@
 #include <stdlib.h>       // NOLINT
 #include <string.h>       // NOLINT
 #include <sys/stat.h>     // NOLINT
+#include <sys/types.h>    // NOLINT
+#include <sys/uio.h>      // NOLINT
 #include <unistd.h>       // NOLINT
+#if !defined(DART_HOST_OS_MACOS)
+#include <sys/sendfile.h>  // NOLINT
+#endif
 
 #include "bin/fdutils.h"
 #include "bin/file.h"
 #include "bin/ifaddrs.h"
 #include "bin/socket_base_macos.h"
 #include "platform/signal_blocker.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
@@ -98,6 +104,55 @@ intptr_t SocketBase::RecvFrom(intptr_t fd,
   return read_bytes;
 }
 
+intptr_t SocketBase::RecvFromBatch(intptr_t fd,
+                                   uint8_t* buffer,
+                                   intptr_t slot_size,
+                                   intptr_t max_count,
+                                   intptr_t* lengths,
+                                   RawAddr* addrs,
+                                   SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  ASSERT(max_count > 0);
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  const intptr_t kMaxBatch = 16;
+  ASSERT(max_count <= kMaxBatch);
+  struct mmsghdr messages[kMaxBatch];
+  struct iovec iovs[kMaxBatch];
+  memset(messages, 0, max_count * sizeof(messages[0]));
+  for (intptr_t i = 0; i < max_count; i++) {
+    iovs[i].iov_base = buffer + i * slot_size;
+    iovs[i].iov_len = slot_size;
+    messages[i].msg_hdr.msg_name = &addrs[i].addr;
+    messages[i].msg_hdr.msg_namelen = sizeof(addrs[i].ss);
+    messages[i].msg_hdr.msg_iov = &iovs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+  // MSG_WAITFORONE returns what is queued once the first datagram is in
+  // rather than waiting for max_count datagrams.
+  const int count = TEMP_FAILURE_RETRY(
+      recvmmsg(fd, messages, max_count, MSG_WAITFORONE, nullptr));
+  if (count == -1) {
+    // If the read would block we need to retry and therefore return 0
+    // as the number of datagrams read.
+    return ((sync == kAsync) && (errno == EWOULDBLOCK)) ? 0 : -1;
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    lengths[i] = messages[i].msg_len;
+  }
+  return count;
+#else
+  // No recvmmsg, so read a single datagram.
+  socklen_t addr_len = sizeof(addrs[0].ss);
+  ssize_t read_bytes = TEMP_FAILURE_RETRY(
+      recvfrom(fd, buffer, slot_size, 0, &addrs[0].addr, &addr_len));
+  if (read_bytes == -1) {
+    return ((sync == kAsync) && (errno == EWOULDBLOCK)) ? 0 : -1;
+  }
+  lengths[0] = read_bytes;
+  return 1;
+#endif
+}
+
 bool SocketControlMessage::is_file_descriptors_control_message() {
   return level_ == SOL_SOCKET && type_ == SCM_RIGHTS;
 }
@@ -200,6 +255,44 @@ intptr_t SocketBase::WriteImpl(intptr_t fd,
   return TEMP_FAILURE_RETRY(write(fd, buffer, num_bytes));
 }
 
+intptr_t SocketBase::WriteGatherImpl(intptr_t fd,
+                                     const uint8_t* const* buffers,
+                                     const intptr_t* lengths,
+                                     intptr_t count,
+                                     intptr_t offset,
+                                     SocketOpKind sync) {
+  const intptr_t kMaxIovecs = 64;
+  struct iovec iov[kMaxIovecs];
+  const intptr_t iovcnt = Utils::Minimum(count, kMaxIovecs);
+  for (intptr_t i = 0; i < iovcnt; i++) {
+    iov[i].iov_base = const_cast<uint8_t*>(buffers[i]);
+    iov[i].iov_len = lengths[i];
+  }
+  ASSERT(offset < lengths[0]);
+  iov[0].iov_base = const_cast<uint8_t*>(buffers[0] + offset);
+  iov[0].iov_len = lengths[0] - offset;
+  return TEMP_FAILURE_RETRY(writev(fd, iov, iovcnt));
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              intptr_t file_fd,
+                              int64_t offset,
+                              intptr_t length) {
+  ASSERT(fd >= 0);
+#if defined(DART_HOST_OS_MACOS)
+  off_t sent = length;
+  int result = sendfile(file_fd, fd, offset, &sent, nullptr, 0);
+  if ((result == -1) && (sent == 0)) {
+    return -1;
+  }
+  // A partial send fails with EAGAIN but still reports the bytes sent.
+  return sent;
+#else
+  off64_t position = offset;
+  return TEMP_FAILURE_RETRY(sendfile64(fd, file_fd, &position, length));
+#endif
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
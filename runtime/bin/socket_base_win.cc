@@ -100,6 +100,23 @@ intptr_t SocketBase::RecvFrom(intptr_t fd,
   return handle->RecvFrom(buffer, num_bytes, &addr->addr, addr_len);
 }
 
+intptr_t SocketBase::RecvFromBatch(intptr_t fd,
+                                   uint8_t* buffer,
+                                   intptr_t slot_size,
+                                   intptr_t max_count,
+                                   intptr_t* lengths,
+                                   RawAddr* addrs,
+                                   SocketOpKind sync) {
+  // The overlapped receive only ever has a single datagram pending.
+  ASSERT(max_count > 0);
+  intptr_t bytes_read = RecvFrom(fd, buffer, slot_size, &addrs[0], sync);
+  if (bytes_read <= 0) {
+    return bytes_read;
+  }
+  lengths[0] = bytes_read;
+  return 1;
+}
+
 bool SocketControlMessage::is_file_descriptors_control_message() {
   return false;
 }
@@ -134,6 +151,25 @@ intptr_t SocketBase::Write(intptr_t fd,
   return handle->Write(buffer, num_bytes);
 }
 
+intptr_t SocketBase::WriteGather(intptr_t fd,
+                                 const uint8_t* const* buffers,
+                                 const intptr_t* lengths,
+                                 intptr_t count,
+                                 SocketOpKind sync) {
+  // Overlapped IO allows only one pending write per handle, so only the
+  // first buffer is written.
+  ASSERT(count > 0);
+  return Write(fd, buffers[0], lengths[0], sync);
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              intptr_t file_fd,
+                              int64_t offset,
+                              intptr_t length) {
+  SetLastError(ERROR_NOT_SUPPORTED);
+  return -1;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
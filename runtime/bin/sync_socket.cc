@@ -219,28 +219,21 @@ void FUNCTION_NAME(SynchronousSocket_Read)(Dart_NativeArguments args) {
                                   "First parameter must be an integer."));
     return;
   }
-  uint8_t* buffer = nullptr;
-  result = IOBuffer::Allocate(length, &buffer);
-  if (Dart_IsNull(result)) {
+  uint8_t* buffer = IOBuffer::AllocatePooled(length);
+  if (buffer == nullptr) {
     Dart_SetReturnValue(args, DartUtils::NewDartOSError());
     return;
   }
-  ASSERT(buffer != nullptr);
   intptr_t bytes_read = SynchronousSocket::Read(socket->fd(), buffer, length);
-  if (bytes_read == length) {
-    Dart_SetReturnValue(args, result);
-  } else if (bytes_read > 0) {
-    uint8_t* new_buffer = nullptr;
-    Dart_Handle new_result = IOBuffer::Allocate(bytes_read, &new_buffer);
-    if (Dart_IsNull(new_result)) {
-      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-      return;
-    }
-    ASSERT(new_buffer != nullptr);
-    memmove(new_buffer, buffer, bytes_read);
-    Dart_SetReturnValue(args, new_result);
+  if (bytes_read > 0) {
+    // A short read is returned in the same buffer.
+    Dart_SetReturnValue(args, IOBuffer::WrapPooled(buffer, bytes_read));
   } else if (bytes_read == -1) {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    Dart_Handle error = DartUtils::NewDartOSError();
+    IOBuffer::FreePooled(buffer);
+    Dart_SetReturnValue(args, error);
+  } else {
+    IOBuffer::FreePooled(buffer);
   }
 }
 
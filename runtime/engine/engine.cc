@@ -333,11 +333,11 @@ void Engine::NotifyMessage(Dart_Isolate isolate) {
     // completion (which happens in samples/embedder/run_timer_async), and
     // another thread calls Engine::Shutdown, the deadlock may occur:
     //
-    // 1. MessageNotifyCallback thread owns PortMap::mutex_ (through
+    // 1. MessageNotifyCallback thread owns a PortMap lock (through
     // PortMap::PostMessage) and wants to lock an isolate (via
     // Engine::LockIsolate).
-    // 2. Shutdown thread owns an isolate lock and wants to lock PortMap::mutex_
-    // (inside Dart_ShutdownIsolate call).
+    // 2. Shutdown thread owns an isolate lock and wants to lock the same
+    // PortMap lock (inside Dart_ShutdownIsolate call).
     //
     // This mutex is used to prevent it:
     // - Engine::Shutdown locks it.
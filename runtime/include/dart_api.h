@@ -837,7 +837,7 @@ typedef Dart_Handle (*Dart_GetVMServiceAssetsArchive)(void);
  * The current version of the Dart_InitializeFlags. Should be incremented every
  * time Dart_InitializeFlags changes in a binary incompatible way.
  */
-#define DART_INITIALIZE_PARAMS_CURRENT_VERSION (0x00000009)
+#define DART_INITIALIZE_PARAMS_CURRENT_VERSION (0x0000000A)
 
 /** Forward declaration */
 struct Dart_CodeObserver;
@@ -941,6 +941,13 @@ typedef struct {
    */
   Dart_CodeObserver* code_observer;
 
+  /**
+   * The maximum number of threads on which the isolates of an isolate group
+   * run Dart code at the same time. If 0, the VM chooses a limit based on
+   * the size of the new generation.
+   */
+  intptr_t max_isolate_threads;
+
 #if defined(__Fuchsia__)
   /**
    * The resource needed to use zx_vmo_replace_as_executable. Can be
@@ -55,7 +55,35 @@ typedef void (*Dart_NativeMessageHandler_DL)(Dart_Port_DL dest_port_id,
   F(Dart_NewNativePort, Dart_Port_DL,                                          \
     (const char* name, Dart_NativeMessageHandler_DL handler,                   \
      bool handle_concurrently))                                                \
-  F(Dart_CloseNativePort, bool, (Dart_Port_DL native_port_id))
+  F(Dart_CloseNativePort, bool, (Dart_Port_DL native_port_id))                 \
+  F(Dart_SetPortQueueLimit, bool,                                              \
+    (Dart_Port_DL port_id, intptr_t limit, Dart_PortQueuePolicy policy))       \
+  F(Dart_NewMessageBuilder, Dart_MessageBuilder, (void))                       \
+  F(Dart_DeleteMessageBuilder, void, (Dart_MessageBuilder builder))            \
+  F(Dart_MessageBuilderAddNull, Dart_MessageObject,                            \
+    (Dart_MessageBuilder builder))                                             \
+  F(Dart_MessageBuilderAddBool, Dart_MessageObject,                            \
+    (Dart_MessageBuilder builder, bool value))                                 \
+  F(Dart_MessageBuilderAddInt64, Dart_MessageObject,                           \
+    (Dart_MessageBuilder builder, int64_t value))                              \
+  F(Dart_MessageBuilderAddDouble, Dart_MessageObject,                          \
+    (Dart_MessageBuilder builder, double value))                               \
+  F(Dart_MessageBuilderAddString, Dart_MessageObject,                          \
+    (Dart_MessageBuilder builder, const char* utf8, intptr_t length))          \
+  F(Dart_MessageBuilderAddTypedData, Dart_MessageObject,                       \
+    (Dart_MessageBuilder builder, Dart_TypedData_Type type, intptr_t length,   \
+     uint8_t** data))                                                          \
+  F(Dart_MessageBuilderAddExternalTypedData, Dart_MessageObject,               \
+    (Dart_MessageBuilder builder, Dart_TypedData_Type type, uint8_t * data,    \
+     intptr_t length, void* peer, Dart_HandleFinalizer callback))              \
+  F(Dart_MessageBuilderAddArray, Dart_MessageObject,                           \
+    (Dart_MessageBuilder builder, intptr_t length))                            \
+  F(Dart_MessageBuilderSetArrayElement, bool,                                  \
+    (Dart_MessageBuilder builder, Dart_MessageObject array, intptr_t index,    \
+     Dart_MessageObject element))                                              \
+  F(Dart_PostMessageBuilder, bool,                                             \
+    (Dart_Port_DL port_id, Dart_MessageBuilder builder,                        \
+     Dart_MessageObject root))
 
 // dart_api.h symbols can only be called on Dart threads.
 #define DART_API_DL_SYMBOLS(F)                                                 \
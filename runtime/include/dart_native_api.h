@@ -32,6 +32,9 @@
  * the caller. The ownership of data for kExternalTyped is passed to the VM on
  * message send and returned when the VM invokes the
  * Dart_HandleFinalizer callback; a non-NULL callback must be provided.
+ * External typed data is not copied: the receiving isolate sees it as
+ * external typed data over the same memory. Large kTypedData is copied only
+ * once, into memory the receiving isolate takes over in the same way.
  *
  * Note that Dart_CObject_kNativePointer is intended for internal use by
  * dart:io implementation and has no connection to dart:ffi Pointer class.
@@ -136,6 +139,168 @@ DART_EXPORT bool Dart_PostCObject(Dart_Port port_id, Dart_CObject* message);
  */
 DART_EXPORT bool Dart_PostInteger(Dart_Port port_id, int64_t message);
 
+/**
+ * A builder that writes a message object by object, directly in the format
+ * the receiving isolate reads. Unlike Dart_PostCObject, no Dart_CObject graph
+ * has to be built first and the message is not serialized again afterwards.
+ *
+ * Objects added to a builder are identified by the Dart_MessageObject values
+ * returned when adding them. Adding an object fails, returning
+ * ILLEGAL_MESSAGE_OBJECT, if its arguments are invalid.
+ *
+ * A builder must only be used by one thread at a time. It may be used on any
+ * thread when the VM is running.
+ */
+typedef struct _Dart_MessageBuilder* Dart_MessageBuilder;
+typedef intptr_t Dart_MessageObject;
+#define ILLEGAL_MESSAGE_OBJECT ((Dart_MessageObject)-1)
+
+/**
+ * Creates a new, empty message builder.
+ */
+DART_EXPORT Dart_MessageBuilder Dart_NewMessageBuilder(void);
+
+/**
+ * Deletes a message builder that has not been posted.
+ *
+ * Ownership of external typed data added to the builder remains with the
+ * caller. Typed data allocated by the builder is freed.
+ */
+DART_EXPORT void Dart_DeleteMessageBuilder(Dart_MessageBuilder builder);
+
+/**
+ * Adds null, a boolean, an integer or a double.
+ */
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddNull(Dart_MessageBuilder builder);
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddBool(Dart_MessageBuilder builder, bool value);
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddInt64(Dart_MessageBuilder builder, int64_t value);
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddDouble(Dart_MessageBuilder builder, double value);
+
+/**
+ * Adds a string. It is decoded from UTF-8 straight into the message.
+ *
+ * \param utf8 The UTF-8 encoded string.
+ * \param length The length of the string in bytes.
+ */
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddString(Dart_MessageBuilder builder,
+                             const char* utf8,
+                             intptr_t length);
+
+/**
+ * Adds typed data and allocates memory for its contents, which the caller
+ * writes through 'data' until the builder is posted or deleted. The receiving
+ * isolate sees external typed data over this memory, so the contents are
+ * never copied.
+ *
+ * \param type The type of the typed data.
+ * \param length The length of the typed data in elements.
+ * \param data Set to the uninitialized contents of the typed data.
+ */
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddTypedData(Dart_MessageBuilder builder,
+                                Dart_TypedData_Type type,
+                                intptr_t length,
+                                uint8_t** data);
+
+/**
+ * Adds external typed data, like Dart_CObject_kExternalTypedData. Ownership
+ * of 'data' passes to the VM when the builder is posted, and is returned
+ * when the VM invokes 'callback' with 'peer'.
+ */
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddExternalTypedData(Dart_MessageBuilder builder,
+                                        Dart_TypedData_Type type,
+                                        uint8_t* data,
+                                        intptr_t length,
+                                        void* peer,
+                                        Dart_HandleFinalizer callback);
+
+/**
+ * Adds an array whose elements are null until set with
+ * Dart_MessageBuilderSetArrayElement.
+ */
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddArray(Dart_MessageBuilder builder, intptr_t length);
+
+/**
+ * Sets an element of an array added to the builder. Any object of the builder
+ * can be an element, including the array itself.
+ *
+ * \return True if 'array' is an array of the builder, 'index' is in range and
+ *   'element' is an object of the builder.
+ */
+DART_EXPORT bool Dart_MessageBuilderSetArrayElement(
+    Dart_MessageBuilder builder,
+    Dart_MessageObject array,
+    intptr_t index,
+    Dart_MessageObject element);
+
+/**
+ * Posts the message built by 'builder' on some port, and deletes the builder.
+ * The message is the object graph rooted in 'root'.
+ *
+ * As with Dart_PostCObject, if true is returned, finalizers for external
+ * typed data will eventually run. If false is returned, ownership of external
+ * typed data remains with the caller.
+ *
+ * \param port_id The destination port.
+ * \param builder The builder of the message.
+ * \param root The object sent.
+ *
+ * \return True if the message was posted.
+ */
+DART_EXPORT bool Dart_PostMessageBuilder(Dart_Port port_id,
+                                         Dart_MessageBuilder builder,
+                                         Dart_MessageObject root);
+
+/**
+ * What happens to a message posted to a port whose queue is full, see
+ * Dart_SetPortQueueLimit.
+ */
+typedef enum {
+  /**
+   * The poster waits until the receiver has taken messages off the queue or
+   * the port is closed. Threads waiting this way do not hold up garbage
+   * collection. An isolate posting to its own port does not wait.
+   */
+  Dart_PortQueuePolicy_kBlock = 0,
+  /**
+   * The message is discarded. Posting it still succeeds, and finalizers for
+   * external typed data in it run.
+   */
+  Dart_PortQueuePolicy_kDrop,
+  /**
+   * The message is discarded and posting it fails: Dart_PostCObject and
+   * similar return false, and SendPort.send throws a StateError.
+   */
+  Dart_PortQueuePolicy_kNotify,
+} Dart_PortQueuePolicy;
+
+/**
+ * Limits the number of messages that can be queued for a port and not yet
+ * taken off the queue by its receiver. Out-of-band control messages, such as
+ * those sent by Isolate.kill, are not limited.
+ *
+ * The depth of each port's queue, how many messages were posted to it and
+ * dropped and how long the oldest one has been waiting are reported by the
+ * service protocol, and summed up for each isolate in the isolate.messages.*
+ * metrics.
+ *
+ * \param port_id The port, of an isolate or a native port.
+ * \param limit The maximum number of queued messages, or 0 for no limit.
+ * \param policy What happens to messages posted while the queue is full.
+ *
+ * \return True if the port exists and the limit was set.
+ */
+DART_EXPORT bool Dart_SetPortQueueLimit(Dart_Port port_id,
+                                        intptr_t limit,
+                                        Dart_PortQueuePolicy policy);
+
 /**
  * A native message handler.
  *
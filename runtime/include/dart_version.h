@@ -11,6 +11,6 @@
 // On backwards compatible changes the minor version is increased.
 // The versioning covers the symbols exposed in dart_api_dl.h
 #define DART_API_DL_MAJOR_VERSION 2
-#define DART_API_DL_MINOR_VERSION 6
+#define DART_API_DL_MINOR_VERSION 7
 
 #endif /* RUNTIME_INCLUDE_DART_VERSION_H_ */ /* NOLINT */
@@ -4,7 +4,11 @@
 
 #include "include/dart_api.h"
 #include "vm/bootstrap_natives.h"
+#include "vm/dart_api_impl.h"
+#include "vm/object.h"
 #include "vm/os_thread.h"
+#include "vm/shared_typed_data.h"
+#include "vm/thread.h"
 
 namespace dart {
 
@@ -110,4 +114,52 @@ DEFINE_FFI_NATIVE_ENTRY(ConditionVariable_NotifyAll,
   condvar->NotifyAll();
 }
 
+static intptr_t SharedTypedDataClassId(Dart_TypedData_Type type) {
+  switch (type) {
+    case Dart_TypedData_kUint8:
+      return kExternalTypedDataUint8ArrayCid;
+    case Dart_TypedData_kInt32:
+      return kExternalTypedDataInt32ArrayCid;
+    case Dart_TypedData_kInt64:
+      return kExternalTypedDataInt64ArrayCid;
+    case Dart_TypedData_kFloat32:
+      return kExternalTypedDataFloat32ArrayCid;
+    case Dart_TypedData_kFloat64:
+      return kExternalTypedDataFloat64ArrayCid;
+    default:
+      UNREACHABLE();
+      return kIllegalCid;
+  }
+}
+
+DEFINE_FFI_NATIVE_ENTRY(SharedTypedData_Allocate,
+                        Dart_Handle,
+                        (intptr_t type, intptr_t length)) {
+  // The length has been checked to be non-negative.
+  const auto typed_data_type = static_cast<Dart_TypedData_Type>(type);
+  const intptr_t cid = SharedTypedDataClassId(typed_data_type);
+  if (length > ExternalTypedData::MaxElements(cid)) {
+    // The caller throws a RangeError.
+    return Dart_Null();
+  }
+  SharedTypedDataStore* store = SharedTypedDataStore::New(
+      length * ExternalTypedData::ElementSizeInBytes(cid));
+  if (store == nullptr) {
+    // The caller throws an OutOfMemoryError.
+    return Dart_False();
+  }
+  Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+      typed_data_type, store->data(), length, store, store->length_in_bytes(),
+      SharedTypedDataStore::Finalizer);
+  if (Dart_IsError(result)) {
+    store->Release();
+    Dart_PropagateError(result);
+  }
+  Thread* thread = Thread::Current();
+  TransitionNativeToVM transition(thread);
+  SharedTypedDataStore::Attach(
+      ExternalTypedData::RawCast(Api::UnwrapHandle(result)), store);
+  return result;
+}
+
 }  // namespace dart
@@ -123,9 +123,15 @@ DEFINE_NATIVE_ENTRY(SendPort_sendInternal_, 0, 2) {
   }
 #endif
 
-  // TODO(turnidge): Throw an exception when the return value is false?
+  bool queue_full = false;
   PortMap::PostMessage(WriteMessage(same_group, obj, destination_port_id,
-                                    Message::kNormalPriority));
+                                    Message::kNormalPriority),
+                       /*before_events=*/false, &queue_full);
+  if (queue_full) {
+    const String& error = String::Handle(
+        String::New("the receiving port's message queue is full"));
+    Exceptions::ThrowStateError(error);
+  }
   return Object::null();
 }
 
@@ -320,8 +326,42 @@ class MessageValidator : private WorkSet {
   explicit MessageValidator(Thread* thread)
       : WorkSet(thread),
         value_(PassiveObject::Handle()),
+        klass_(Class::Handle()),
         class_table_(thread->isolate()->group()->class_table()) {}
 
+  // Whether [obj] can be sent without looking at the objects it refers to.
+  static bool IsTriviallySendable(ObjectPtr obj) {
+    if (!obj->IsHeapObject() || obj->untag()->IsCanonical() ||
+        obj->untag()->IsImmutable()) {
+      return true;
+    }
+    switch (obj->untag()->GetClassId()) {
+      case kTransferableTypedDataCid:
+#define CASE(clazz)                                                            \
+  case kTypedData##clazz##Cid:                                                 \
+  case kTypedData##clazz##ViewCid:                                             \
+  case kExternalTypedData##clazz##Cid:                                         \
+  case kUnmodifiableTypedData##clazz##ViewCid:
+        CLASS_LIST_TYPED_DATA(CASE)
+#undef CASE
+      case kByteDataViewCid:
+      case kUnmodifiableByteDataViewCid:
+      case kByteBufferCid:
+      // Leaves without pointers to other objects.
+      case kMintCid:
+      case kDoubleCid:
+      case kFloat32x4Cid:
+      case kFloat64x2Cid:
+      case kInt32x4Cid:
+      case kOneByteStringCid:
+      case kTwoByteStringCid:
+      case kSendPortCid:
+      case kCapabilityCid:
+        return true;
+    }
+    return false;
+  }
+
   ObjectPtr Validate(Thread* thread, const Object& root) {
     TIMELINE_DURATION(thread, Isolate, "ValidateMessageObject");
     Visit(root.ptr());
@@ -451,28 +491,49 @@ class MessageValidator : private WorkSet {
   }
 
   void Visit(ObjectPtr obj) {
-    if (!obj->IsHeapObject() || obj->untag()->IsCanonical() ||
-        obj->untag()->IsImmutable()) {
+    if (IsTriviallySendable(obj)) {
       return;
     }
-    switch (obj->untag()->GetClassId()) {
-      case kTransferableTypedDataCid:
-#define CASE(clazz)                                                            \
-  case kTypedData##clazz##Cid:                                                 \
-  case kTypedData##clazz##ViewCid:                                             \
-  case kExternalTypedData##clazz##Cid:                                         \
-  case kUnmodifiableTypedData##clazz##ViewCid:
-        CLASS_LIST_TYPED_DATA(CASE)
-#undef CASE
-      case kByteDataViewCid:
-      case kUnmodifiableByteDataViewCid:
-      case kByteBufferCid:
-        return;
+    // Instances without pointer fields are common in large results (e.g. a
+    // list of small objects) and are not worth a work set entry each.
+    const intptr_t cid = obj->untag()->GetClassId();
+    if ((cid == kInstanceCid || cid >= kNumPredefinedCids) &&
+        IsSendableLeafClass(cid)) {
+      return;
     }
     value_ = obj;
     Push(value_);
   }
 
+  // Whether instances of [cid] may be sent and have no pointer fields, in
+  // which case they need not be visited. Computed once per class.
+  bool IsSendableLeafClass(intptr_t cid) {
+    while (leaf_classes_.length() <= cid) {
+      leaf_classes_.Add(kUnknown);
+    }
+    if (leaf_classes_[cid] == kUnknown) {
+      leaf_classes_[cid] = ComputeIsSendableLeafClass(cid) ? kLeaf : kNotLeaf;
+    }
+    return leaf_classes_[cid] == kLeaf;
+  }
+
+  bool ComputeIsSendableLeafClass(intptr_t cid) {
+    klass_ = class_table_->At(cid);
+    if (klass_.is_isolate_unsendable()) {
+      return false;
+    }
+    const auto bitmap = class_table_->GetUnboxedFieldsMapAt(cid);
+    const intptr_t size = klass_.host_instance_size();
+    intptr_t bit = kWordSize >> kCompressedWordSizeLog2;
+    for (intptr_t offset = kWordSize; offset < size;
+         offset += kCompressedWordSize) {
+      if (!bitmap.Get(bit++)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   ObjectPtr Error(const Object& illegal_object,
                   const char* exception_message,
                   const Object& root) {
@@ -495,8 +556,12 @@ class MessageValidator : private WorkSet {
   }
 
  private:
+  enum LeafClassState : int8_t { kUnknown, kLeaf, kNotLeaf };
+
   PassiveObject& value_;
+  Class& klass_;
   ClassTable* class_table_;
+  MallocGrowableArray<int8_t> leaf_classes_;
 };
 
 // TODO(http://dartbug.com/47777): Add support for Finalizers.
@@ -522,7 +587,9 @@ DEFINE_NATIVE_ENTRY(Isolate_exit_, 0, 2) {
 
     Object& validated_result = Object::Handle(zone);
     const Object& msg_obj = Object::Handle(zone, obj.ptr());
-    {
+    // Results from the same group are already in the receiver's heap, so
+    // only their sendability needs checking.
+    if (!MessageValidator::IsTriviallySendable(obj.ptr())) {
       MessageValidator validator(thread);
       validated_result = validator.Validate(thread, obj);
     }
@@ -760,6 +827,42 @@ static void ThrowIsolateSpawnException(const String& message) {
   Exceptions::ThrowByType(Exceptions::kIsolateSpawn, args);
 }
 
+// Fills the isolate group's pool of idle isolates, see
+// IsolateGroup::TakePooledIsolate.
+class RefillIsolatePoolTask : public ThreadPool::Task {
+ public:
+  // Holding a spawn on [parent_isolate] keeps it, and with it the group and
+  // any isolate we add to the pool, alive until we are done.
+  explicit RefillIsolatePoolTask(Isolate* parent_isolate)
+      : parent_isolate_(parent_isolate) {
+    parent_isolate->IncrementSpawnCount();
+  }
+
+  ~RefillIsolatePoolTask() override { parent_isolate_->DecrementSpawnCount(); }
+
+  void Run() override {
+    IsolateGroup* group = parent_isolate_->group();
+    while (true) {
+      char* error = nullptr;
+      Isolate* isolate = CreatePooledIsolate(group, &error);
+      if (isolate == nullptr) {
+        free(error);
+        group->FinishIsolatePoolRefill();
+        return;
+      }
+      Dart_ExitIsolate();
+      if (!group->AddPooledIsolate(isolate)) {
+        return;
+      }
+    }
+  }
+
+ private:
+  Isolate* parent_isolate_;
+
+  DISALLOW_COPY_AND_ASSIGN(RefillIsolatePoolTask);
+};
+
 class SpawnIsolateTask : public ThreadPool::Task {
  public:
   SpawnIsolateTask(Isolate* parent_isolate,
@@ -846,7 +949,17 @@ class SpawnIsolateTask : public ThreadPool::Task {
     char* error = nullptr;
 
     auto group = state_->isolate_group();
-    Isolate* isolate = CreateWithinExistingIsolateGroup(group, name, &error);
+    Isolate* isolate = group->TakePooledIsolate();
+    if (isolate != nullptr) {
+      Dart_EnterIsolate(Api::CastIsolate(isolate));
+      isolate->ClaimFromPool(name);
+    } else {
+      isolate = CreateWithinExistingIsolateGroup(group, name, &error);
+    }
+    if (group->StartIsolatePoolRefill() &&
+        !Dart::thread_pool()->Run<RefillIsolatePoolTask>(parent_isolate_)) {
+      group->FinishIsolatePoolRefill();
+    }
     parent_isolate_->DecrementSpawnCount();
     parent_isolate_ = nullptr;
 
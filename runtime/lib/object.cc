@@ -309,6 +309,10 @@ DEFINE_NATIVE_ENTRY(Internal_deoptimizeFunctionsOnStack, 0, 0) {
   return Object::null();
 }
 
+DEFINE_NATIVE_ENTRY(Internal_isolatePoolHits, 0, 0) {
+  return Integer::New(isolate->group()->GetIsolatePoolHitsMetric()->value());
+}
+
 DEFINE_NATIVE_ENTRY(Internal_allocateObjectInstructionsStart, 0, 0) {
   auto& stub = Code::Handle(
       zone, isolate->group()->object_store()->allocate_object_stub());
@@ -0,0 +1,100 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies that polymorphic dynamic calls whose receivers all implement the
+// called member use the dispatch table in AOT mode when the arguments need no
+// checks, and that dynamic calls which do need checks still perform them.
+
+import 'package:expect/expect.dart';
+import 'package:vm/testing/il_matchers.dart';
+
+abstract class Shape {
+  double width = 1.0;
+
+  double area();
+  double grow(double by, {double extra = 0.0});
+}
+
+class Square extends Shape {
+  @pragma('vm:never-inline')
+  double area() => width * width;
+
+  @pragma('vm:never-inline')
+  double grow(double by, {double extra = 0.0}) => width += by + extra;
+}
+
+class Circle extends Shape {
+  @pragma('vm:never-inline')
+  double area() => 3.0 * width * width;
+
+  @pragma('vm:never-inline')
+  double grow(double by, {double extra = 0.0}) => width += 2 * (by + extra);
+}
+
+@pragma('vm:never-inline')
+@pragma('vm:testing:print-flow-graph')
+double callArea(dynamic shape) => shape.area();
+
+@pragma('vm:never-inline')
+@pragma('vm:testing:print-flow-graph')
+double callGrow(dynamic shape) => shape.grow(1.0, extra: 0.5);
+
+@pragma('vm:never-inline')
+@pragma('vm:testing:print-flow-graph')
+Object tearOffArea(dynamic shape) => shape.area;
+
+@pragma('vm:never-inline')
+dynamic callGrowWith(dynamic shape, dynamic by) => shape.grow(by);
+
+void matchIL$callArea(FlowGraph graph) {
+  graph.match([
+    match.block('Graph'),
+    match.block('Function', [
+      'shape' << match.Parameter(index: 0),
+      'cid' << match.LoadClassId('shape'),
+      match.DispatchTableCall('cid'),
+    ]),
+  ]);
+}
+
+void matchIL$callGrow(FlowGraph graph) {
+  graph.match([
+    match.block('Graph'),
+    match.block('Function', [
+      'shape' << match.Parameter(index: 0),
+      'cid' << match.LoadClassId('shape'),
+      match.DispatchTableCall('cid'),
+    ]),
+  ]);
+}
+
+void matchIL$tearOffArea(FlowGraph graph) {
+  graph.match([
+    match.block('Graph'),
+    match.block('Function', [
+      'shape' << match.Parameter(index: 0),
+      'cid' << match.LoadClassId('shape'),
+      match.DispatchTableCall('cid'),
+    ]),
+  ]);
+}
+
+List<Object> shapes = [Square(), Circle()];
+
+void main() {
+  final square = shapes[0];
+  final circle = shapes[1];
+  Expect.equals(1.0, callArea(square));
+  Expect.equals(3.0, callArea(circle));
+  Expect.equals(2.5, callGrow(square));
+  Expect.equals(4.0, callGrow(circle));
+  Expect.equals(6.25, (tearOffArea(square) as double Function())());
+  Expect.equals(48.0, (tearOffArea(circle) as double Function())());
+
+  // Arguments which are not statically known to match the parameter types
+  // are still checked.
+  Expect.equals(3.5, callGrowWith(square, 1.0));
+  Expect.throwsTypeError(() => callGrowWith(circle, 'big'));
+  Expect.throwsNoSuchMethodError(() => callGrowWith(Object(), 1.0));
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests that results of Isolate.exit made up of objects without pointer
+// fields arrive intact, and that unsendable ones among them are still found.
+
+import 'dart:isolate';
+
+import 'package:expect/expect.dart';
+
+class Point {
+  final double x;
+  final double y;
+
+  Point(this.x, this.y);
+}
+
+@pragma('vm:isolate-unsendable')
+class Locked {}
+
+Future<Object?> exitWith(Object? Function() build) async {
+  final port = ReceivePort();
+  final sendPort = port.sendPort;
+  await Isolate.spawn((_) => Isolate.exit(sendPort, build()), null);
+  return await port.first;
+}
+
+Future<void> main() async {
+  final port = ReceivePort();
+  final result =
+      await exitWith(
+            () => [
+              for (int i = 0; i < 100000; i++) ...[
+                Object(),
+                Point(i.toDouble(), -i.toDouble()),
+                i + 0.5,
+                '$i',
+                1 << 40 + (i % 20),
+              ],
+              port.sendPort,
+            ],
+          )
+          as List;
+  Expect.equals(500001, result.length);
+  for (int i = 0; i < 100000; i++) {
+    final point = result[5 * i + 1] as Point;
+    Expect.equals(i.toDouble(), point.x);
+    Expect.equals(-i.toDouble(), point.y);
+    Expect.equals(i + 0.5, result[5 * i + 2]);
+    Expect.equals('$i', result[5 * i + 3]);
+    Expect.equals(1 << 40 + (i % 20), result[5 * i + 4]);
+  }
+  Expect.equals(port.sendPort, result.last);
+  port.close();
+
+  // An unsendable object after many that are not checked one by one.
+  final error = await exitWith(() {
+    final list = <Object>[for (int i = 0; i < 100000; i++) Object(), Locked()];
+    try {
+      Isolate.exit(ReceivePort().sendPort, list);
+    } on ArgumentError catch (e) {
+      return '$e';
+    }
+  });
+  Expect.contains('unsendable object', error as String);
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--isolate-pool-size=0
+// VMOptions=--isolate-pool-size=1
+// VMOptions=--isolate-pool-size=4
+
+// Tests that Isolate.spawn claims isolates from the pool of idle isolates
+// when it has one, and that claimed isolates behave like freshly created ones.
+
+import 'dart:_internal' show VMInternalsForTesting;
+import 'dart:io';
+import 'dart:isolate';
+
+import 'package:expect/expect.dart';
+
+int counter = 0;
+final List<int> log = <int>[];
+
+void child(List args) {
+  final SendPort port = args[0];
+  final int id = args[1];
+  // Globals start out with their initial values in every isolate.
+  final result = [Isolate.current.debugName, counter, log.length];
+  counter += id;
+  log.add(id);
+  port.send(result);
+}
+
+Future<void> main() async {
+  counter = 42;
+  log.add(-1);
+
+  for (int round = 0; round < 3; round++) {
+    final futures = <Future>[];
+    for (int i = 0; i < 8; i++) {
+      final port = ReceivePort();
+      final id = round * 8 + i + 1;
+      await Isolate.spawn(child, [port.sendPort, id], debugName: 'child-$id');
+      futures.add(
+        port.first.then((result) {
+          Expect.listEquals(['child-$id', 0, 0], result as List);
+        }),
+      );
+    }
+    await Future.wait(futures);
+  }
+
+  Expect.equals(42, counter);
+  Expect.listEquals([-1], log);
+
+  // The pool is refilled in the background, so spawn until it served one.
+  final hasPool = !Platform.executableArguments.contains(
+    '--isolate-pool-size=0',
+  );
+  if (hasPool) {
+    for (int i = 0; VMInternalsForTesting.isolatePoolHits() == 0; i++) {
+      Expect.isTrue(i < 100, 'no isolate was taken from the pool');
+      await Future.delayed(const Duration(milliseconds: 10));
+      final port = ReceivePort();
+      await Isolate.spawn(child, [port.sendPort, 0]);
+      await port.first;
+    }
+  }
+  Expect.equals(hasPool, VMInternalsForTesting.isolatePoolHits() > 0);
+}
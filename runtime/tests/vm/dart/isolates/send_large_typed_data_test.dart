@@ -0,0 +1,69 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--no-enable-fast-object-copy
+// VMOptions=--enable-fast-object-copy
+// VMOptions=--no-enable-fast-object-copy --no-parallel-typed-data-copy
+// VMOptions=--enable-fast-object-copy --no-parallel-typed-data-copy
+
+// Tests that the contents of large typed data, which are copied on several
+// threads, arrive intact.
+
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+// Content that differs between any two chunks of the copy.
+Uint8List makeContent(Uint8List list) {
+  for (int i = 0; i < list.length; i++) {
+    list[i] = (i * 31 + (i >> 12)) & 0xff;
+  }
+  return list;
+}
+
+void expectContent(Uint8List list, int length) {
+  Expect.equals(length, list.length);
+  for (int i = 0; i < length; i++) {
+    if (list[i] != ((i * 31 + (i >> 12)) & 0xff)) {
+      Expect.fail('Unexpected byte at $i');
+    }
+  }
+}
+
+Future<Object?> sendToSelf(Object? message) async {
+  final port = ReceivePort();
+  port.sendPort.send(message);
+  final result = await port.first;
+  port.close();
+  return result;
+}
+
+Future<void> main() async {
+  final directory = Directory.systemTemp.createTempSync('large_typed_data');
+  try {
+    for (final length in [4 * 1024 * 1024, 20 * 1024 * 1024 + 123]) {
+      final internal = makeContent(Uint8List(length));
+      expectContent(await sendToSelf(internal) as Uint8List, length);
+
+      final file = File('${directory.path}/$length');
+      file.writeAsBytesSync(internal);
+      final external = file.readAsBytesSync();
+      expectContent(await sendToSelf(external) as Uint8List, length);
+
+      // Several large typed data in one message.
+      final list = await sendToSelf([internal, 1, external]) as List;
+      expectContent(list[0] as Uint8List, length);
+      expectContent(list[2] as Uint8List, length);
+
+      // A view on large typed data copies the whole backing store.
+      final view = Uint8List.sublistView(internal, 1000);
+      final copiedView = await sendToSelf(view) as Uint8List;
+      expectContent(copiedView.buffer.asUint8List(), length);
+    }
+  } finally {
+    directory.deleteSync(recursive: true);
+  }
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--experimental-shared-data --no-enable-fast-object-copy
+// VMOptions=--experimental-shared-data --enable-fast-object-copy
+
+// Tests that shared typed data sent to other isolates refers to the same
+// memory instead of a copy.
+
+import 'dart:concurrent';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+@pragma('vm:shared')
+late Mutex mutex;
+@pragma('vm:shared')
+late ConditionVariable condition;
+@pragma('vm:shared')
+int produced = 0;
+
+const int consumers = 4;
+const int rounds = 10;
+
+// Fills the list with the value of `produced` on each round.
+void producer(Float64List list) {
+  for (int round = 1; round <= rounds; round++) {
+    mutex.runLocked(() {
+      for (int i = 0; i < list.length; i++) {
+        list[i] = round.toDouble();
+      }
+      produced = round;
+      condition.notifyAll();
+    });
+  }
+}
+
+// Checks that every round's values become visible.
+void consumer(List args) {
+  final Float64List list = args[0];
+  final SendPort done = args[1];
+  int seen = 0;
+  while (seen < rounds) {
+    mutex.runLocked(() {
+      while (produced == seen) {
+        condition.wait(mutex);
+      }
+      seen = produced;
+      for (int i = 0; i < list.length; i++) {
+        Expect.equals(seen.toDouble(), list[i]);
+      }
+    });
+  }
+  done.send(seen);
+}
+
+void writer(List args) {
+  final Uint8List list = args[0];
+  final Uint8List view = args[1];
+  final SendPort done = args[2];
+  for (int i = 0; i < list.length; i++) {
+    list[i] = i & 0xff;
+  }
+  view[0] = 42;
+  done.send(null);
+}
+
+Future<void> testWritesAreVisible() async {
+  final list = SharedTypedData.uint8List(1 << 20);
+  Expect.isTrue(list.every((byte) => byte == 0));
+  final view = Uint8List.sublistView(list, 1000, 2000);
+
+  final done = ReceivePort();
+  await Isolate.spawn(writer, [list, view, done.sendPort]);
+  await done.first;
+
+  for (int i = 0; i < list.length; i++) {
+    if (i == 1000) {
+      Expect.equals(42, list[i]);
+    } else {
+      Expect.equals(i & 0xff, list[i]);
+    }
+  }
+}
+
+Future<void> testSendToSelf() async {
+  final list = SharedTypedData.int64List(1000);
+  final port = ReceivePort();
+  port.sendPort.send(list);
+  final received = await port.first as Int64List;
+  received[7] = 7;
+  Expect.equals(7, list[7]);
+}
+
+Future<void> testProducerConsumers() async {
+  mutex = Mutex();
+  condition = ConditionVariable();
+  final list = SharedTypedData.float64List(1 << 16);
+
+  final done = ReceivePort();
+  for (int i = 0; i < consumers; i++) {
+    await Isolate.spawn(consumer, [list, done.sendPort]);
+  }
+  await Isolate.spawn(producer, list);
+  final results = await done.take(consumers).toList();
+  Expect.listEquals(List.filled(consumers, rounds), results);
+  done.close();
+}
+
+Future<void> main() async {
+  await testWritesAreVisible();
+  await testSendToSelf();
+  await testProducerConsumers();
+  Expect.throwsRangeError(() => SharedTypedData.float32List(-1));
+  Expect.throwsRangeError(() => SharedTypedData.int64List(1 << 62));
+}
@@ -273,6 +273,7 @@ namespace dart {
   V(Internal_writeIntoOneByteString, 3)                                        \
   V(Internal_writeIntoTwoByteString, 3)                                        \
   V(Internal_deoptimizeFunctionsOnStack, 0)                                    \
+  V(Internal_isolatePoolHits, 0)                                               \
   V(Internal_allocateObjectInstructionsStart, 0)                               \
   V(Internal_allocateObjectInstructionsEnd, 0)                                 \
   V(InvocationMirror_unpackTypeArguments, 2)                                   \
@@ -374,7 +375,8 @@ namespace dart {
   V(Mutex_Initialize, void, (Dart_Handle))                                     \
   V(Mutex_RunLocked, Dart_Handle, (Dart_Handle, Dart_Handle))                  \
   V(Pointer_asTypedListFinalizerAllocateData, void*, ())                       \
-  V(Pointer_asTypedListFinalizerCallbackPointer, void*, ())
+  V(Pointer_asTypedListFinalizerCallbackPointer, void*, ())                    \
+  V(SharedTypedData_Allocate, Dart_Handle, (intptr_t, intptr_t))
 
 class BootstrapNatives : public AllStatic {
  public:
@@ -129,6 +129,9 @@ class SelectorRow {
 
   void FillTable(ClassTable* class_table, const Array& entries);
 
+  // Adds the distinct functions implementing this selector to [targets].
+  void CollectTargets(GrowableArray<const Function*>* targets) const;
+
  private:
   TableSelector* selector_;
   int32_t total_size_ = 0;
@@ -263,6 +266,24 @@ void SelectorRow::FillTable(ClassTable* class_table, const Array& entries) {
   }
 }
 
+void SelectorRow::CollectTargets(
+    GrowableArray<const Function*>* targets) const {
+  // All class ranges of a function share the same handle.
+  const intptr_t start = targets->length();
+  for (intptr_t i = 0; i < class_ranges_.length(); i++) {
+    const Function* function = class_ranges_[i].function();
+    if (function == nullptr) continue;
+    bool seen = false;
+    for (intptr_t j = start; j < targets->length(); j++) {
+      if (targets->At(j) == function) {
+        seen = true;
+        break;
+      }
+    }
+    if (!seen) targets->Add(function);
+  }
+}
+
 void RowFitter::FitAndAllocate(SelectorRow* row,
                                int32_t min_offset,
                                int32_t max_offset) {
@@ -657,10 +678,12 @@ void DispatchTableGenerator::ComputeSelectorOffsets() {
   };
   table_rows_.Sort(SizeSorter::Compare);
 
-  // Allocate remaining rows at large offsets.
-  const int32_t min_large_offset = DispatchTable::kLargestSmallOffset + 1;
+  // Allocate remaining rows at large offsets. These are not restricted to be
+  // positive: a row whose classes all have high class ids can start at a
+  // negative offset and fill the holes left at the start of the table.
   for (intptr_t i = 0; i < table_rows_.length(); i++) {
-    fitter.FitAndAllocate(table_rows_[i], min_large_offset);
+    SelectorRow* row = table_rows_[i];
+    fitter.FitAndAllocate(row, -row->ranges()[0].begin());
   }
 
   table_size_ = fitter.TableSize();
@@ -675,6 +698,70 @@ ArrayPtr DispatchTableGenerator::BuildCodeArray() {
   return entries.ptr();
 }
 
+void DispatchTableGenerator::PrintStats(intptr_t num_table_calls,
+                                        intptr_t num_switchable_calls) {
+  intptr_t num_used_selectors = 0;
+  intptr_t num_torn_off_selectors = 0;
+  for (intptr_t i = 0; i < num_selectors_; i++) {
+    const TableSelector& selector = selector_map_.selectors_[i];
+    if (selector.IsUsed()) num_used_selectors++;
+    if (selector.torn_off) num_torn_off_selectors++;
+  }
+
+  intptr_t num_call_sites = 0;
+  intptr_t num_occupied_entries = 0;
+  intptr_t num_small_offset_rows = 0;
+  intptr_t num_negative_offset_rows = 0;
+  GrowableArray<const Function*> targets(zone_, 0);
+  for (intptr_t i = 0; i < table_rows_.length(); i++) {
+    SelectorRow* row = table_rows_[i];
+    num_call_sites += row->CallCount();
+    num_occupied_entries += row->total_size();
+    const int32_t offset = row->selector()->offset;
+    if (offset < 0) {
+      num_negative_offset_rows++;
+    } else if (offset <= DispatchTable::kLargestSmallOffset) {
+      num_small_offset_rows++;
+    }
+    row->CollectTargets(&targets);
+  }
+
+  intptr_t targets_code_size = 0;
+  auto& code = Code::Handle(Z);
+  for (intptr_t i = 0; i < targets.length(); i++) {
+    if (!targets[i]->HasCode()) continue;
+    code = targets[i]->CurrentCode();
+    targets_code_size += code.Size();
+  }
+
+  const intptr_t table_size_in_bytes =
+      table_size_ * compiler::target::kWordSize;
+  THR_Print("Dispatch table statistics:\n");
+  THR_Print("  selectors:           %" Pd " (%" Pd " used, %" Pd
+            " torn off)\n",
+            static_cast<intptr_t>(num_selectors_), num_used_selectors,
+            num_torn_off_selectors);
+  THR_Print("  rows:                %" Pd " (%" Pd " at small offsets, %" Pd
+            " at negative offsets)\n",
+            table_rows_.length(), num_small_offset_rows,
+            num_negative_offset_rows);
+  THR_Print("  table call sites:    %" Pd "\n", num_call_sites);
+  const intptr_t num_instance_calls = num_table_calls + num_switchable_calls;
+  THR_Print("  instance calls:      %" Pd " (%" Pd " table, %" Pd
+            " switchable, %.1f%% table)\n",
+            num_instance_calls, num_table_calls, num_switchable_calls,
+            num_instance_calls == 0
+                ? 0.0
+                : (100.0 * num_table_calls) / num_instance_calls);
+  THR_Print("  table entries:       %" Pd " (%" Pd " occupied, %.1f%%)\n",
+            static_cast<intptr_t>(table_size_), num_occupied_entries,
+            table_size_ == 0 ? 0.0
+                             : (100.0 * num_occupied_entries) / table_size_);
+  THR_Print("  table size:          %" Pd " bytes\n", table_size_in_bytes);
+  THR_Print("  target functions:    %" Pd " (%" Pd " bytes of code)\n",
+            targets.length(), targets_code_size);
+}
+
 }  // namespace compiler
 }  // namespace dart
 
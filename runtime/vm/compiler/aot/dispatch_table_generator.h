@@ -66,7 +66,8 @@ class SelectorMap {
  private:
   static constexpr int32_t kInvalidSelectorId =
       kernel::ProcedureAttributesMetadata::kInvalidSelectorId;
-  static constexpr int32_t kInvalidSelectorOffset = -1;
+  // Offsets of rows allocated at large offsets can be negative.
+  static constexpr int32_t kInvalidSelectorOffset = kMinInt32;
 
   int32_t SelectorId(const Function& interface_target) const;
 
@@ -99,6 +100,12 @@ class DispatchTableGenerator {
   // deserialized as a DispatchTable at runtime.
   ArrayPtr BuildCodeArray();
 
+  // Print how many selectors and call sites use table dispatch, what share of
+  // the instance calls in the generated code they make up, how densely the
+  // rows are packed and how the size of the table compares to the size of the
+  // code it dispatches to.
+  void PrintStats(intptr_t num_table_calls, intptr_t num_switchable_calls);
+
  private:
   void ReadTableSelectorInfo();
   void NumberSelectors();
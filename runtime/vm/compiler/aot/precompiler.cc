@@ -71,6 +71,10 @@ DEFINE_FLAG(bool,
             false,
             "Print per-phase breakdown of time spent precompiling");
 DEFINE_FLAG(bool, print_unique_targets, false, "Print unique dynamic targets");
+DEFINE_FLAG(bool,
+            print_dispatch_table_stats,
+            false,
+            "Print coverage and size statistics of the dispatch table");
 DEFINE_FLAG(charp,
             print_object_layout_to,
             nullptr,
@@ -1457,6 +1461,12 @@ void Precompiler::AddTableSelector(const compiler::TableSelector* selector) {
   changed_ = true;
 }
 
+void Precompiler::AddInstanceCallCounts(intptr_t num_table_calls,
+                                        intptr_t num_switchable_calls) {
+  num_table_calls_ += num_table_calls;
+  num_switchable_calls_ += num_switchable_calls;
+}
+
 bool Precompiler::IsHitByTableSelector(const Function& function) {
   const int32_t selector_id = selector_map()->SelectorId(function);
   if (selector_id == compiler::SelectorMap::kInvalidSelectorId) return false;
@@ -2049,6 +2059,10 @@ void Precompiler::FinalizeDispatchTable() {
   const auto& entries =
       Array::Handle(Z, dispatch_table_generator_->BuildCodeArray());
   IG->object_store()->set_dispatch_table_code_entries(entries);
+  if (FLAG_print_dispatch_table_stats) {
+    dispatch_table_generator_->PrintStats(num_table_calls_,
+                                          num_switchable_calls_);
+  }
   // Delete the dispatch table generator to ensure there's no attempt
   // to add new entries after this point.
   delete dispatch_table_generator_;
@@ -3538,6 +3552,8 @@ bool PrecompileParsedFunctionHelper::GenerateCode(FlowGraph* flow_graph) {
         for (intptr_t i = 0; i < call_selectors.length(); i++) {
           precompiler_->AddTableSelector(call_selectors[i]);
         }
+        precompiler_->AddInstanceCallCounts(
+            call_selectors.length(), graph_compiler.num_switchable_calls());
       } else {
         // We should not be generating code outside of these two specific
         // precompilation phases.
@@ -264,6 +264,10 @@ class Precompiler : public ValueObject {
 
   void AddField(const Field& field);
   void AddTableSelector(const compiler::TableSelector* selector);
+  // Record how many of the instance calls in a function compiled during the
+  // fixpoint use the dispatch table and how many use switchable calls.
+  void AddInstanceCallCounts(intptr_t num_table_calls,
+                             intptr_t num_switchable_calls);
 
   enum class Phase {
     kPreparation,
@@ -409,6 +413,9 @@ class Precompiler : public ValueObject {
 
   bool get_runtime_type_is_unique_;
 
+  intptr_t num_table_calls_ = 0;
+  intptr_t num_switchable_calls_ = 0;
+
   Phase phase_ = Phase::kPreparation;
   PrecompilerTracer* tracer_ = nullptr;
   RetainedReasonsWriter* retained_reasons_writer_ = nullptr;
@@ -401,6 +401,7 @@ class FlowGraphCompiler : public ValueObject {
   dispatch_table_call_targets() const {
     return dispatch_table_call_targets_;
   }
+  intptr_t num_switchable_calls() const { return num_switchable_calls_; }
 
   // If 'ForcedOptimization()' returns 'true', we are compiling in optimized
   // mode for a function which cannot deoptimize. Certain optimizations, e.g.
@@ -1205,6 +1206,9 @@ class FlowGraphCompiler : public ValueObject {
   GrowableArray<StaticCallsStruct*> static_calls_target_table_;
   // The table selectors of all dispatch table calls in the current function.
   GrowableArray<const compiler::TableSelector*> dispatch_table_call_targets_;
+  // The number of instance calls in the current function which go through a
+  // switchable call instead of the dispatch table.
+  intptr_t num_switchable_calls_ = 0;
   GrowableArray<IndirectGotoInstr*> indirect_gotos_;
   bool is_optimizing_;
   // Set to true if optimized code has IC calls.
@@ -1134,7 +1134,8 @@ void BackgroundCompiler::Run() {
   {
     MonitorLocker ml(&monitor_);
     if (running_ && !function_queue()->IsEmpty() &&
-        Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+        Dart::thread_pool()->RunWithPriority<BackgroundCompilerTask>(
+            ThreadPool::kCompilerPriority, this)) {
       // Successfully scheduled a new task.
     } else {
       // Background compiler done. This notification must happen after the
@@ -1161,7 +1162,8 @@ bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
     // `IsolateGroup::mutator_pool()` we would need to ensure the BG compiler
     // stops when it's idle - otherwise the [MutatorThreadPool]-based idle
     // notification would not work anymore.
-    if (!Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+    if (!Dart::thread_pool()->RunWithPriority<BackgroundCompilerTask>(
+            ThreadPool::kCompilerPriority, this)) {
       running_ = false;
       done_ = true;
       return false;
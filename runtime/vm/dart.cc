@@ -59,6 +59,7 @@
 namespace dart {
 
 DECLARE_FLAG(bool, print_class_table);
+DECLARE_FLAG(int, max_isolate_threads);
 DEFINE_FLAG(bool, trace_shutdown, false, "Trace VM shutdown on stderr");
 
 Isolate* Dart::vm_isolate_ = nullptr;
@@ -307,6 +308,9 @@ char* Dart::DartInit(const Dart_InitializeParams* params) {
   SetFileCallbacks(params->file_open, params->file_read, params->file_write,
                    params->file_close);
   set_entropy_source_callback(params->entropy_source);
+  if (params->max_isolate_threads > 0) {
+    FLAG_max_isolate_threads = params->max_isolate_threads;
+  }
   OS::Init();
   NOT_IN_PRODUCT(CodeObservers::Init());
   if (params->code_observer != nullptr) {
@@ -986,10 +990,14 @@ ErrorPtr Dart::InitializeIsolate(Thread* T,
   }
 #endif  // !defined(PRODUCT)
 
-  ServiceIsolate::SendIsolateStartupMessage();
+  // Pooled isolates are announced when they are claimed, see
+  // Isolate::ClaimFromPool.
+  if (!I->is_pooled()) {
+    ServiceIsolate::SendIsolateStartupMessage();
 #if !defined(PRODUCT)
-  I->debugger()->NotifyIsolateCreated();
+    I->debugger()->NotifyIsolateCreated();
 #endif
+  }
 
   // Create tag table.
   I->set_tag_table(GrowableObjectArray::Handle(GrowableObjectArray::New()));
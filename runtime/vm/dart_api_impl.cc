@@ -1222,7 +1222,8 @@ static Dart_Isolate CreateIsolate(IsolateGroup* group,
                                   bool is_new_group,
                                   const char* name,
                                   void* isolate_data,
-                                  char** error) {
+                                  char** error,
+                                  bool is_pooled = false) {
   CHECK_NO_ISOLATE(Isolate::Current());
 
   auto source = group->source();
@@ -1233,6 +1234,9 @@ static Dart_Isolate CreateIsolate(IsolateGroup* group,
     }
     return static_cast<Dart_Isolate>(nullptr);
   }
+  if (is_pooled) {
+    I->MarkPooled();
+  }
 
   Thread* T = Thread::Current();
   bool success = false;
@@ -1310,6 +1314,15 @@ Isolate* CreateWithinExistingIsolateGroup(IsolateGroup* group,
   return isolate;
 }
 
+Isolate* CreatePooledIsolate(IsolateGroup* group, char** error) {
+  API_TIMELINE_DURATION(Thread::Current());
+  CHECK_NO_ISOLATE(Isolate::Current());
+
+  return reinterpret_cast<Isolate*>(
+      CreateIsolate(group, /*is_new_group=*/false, "isolate-pool",
+                    /*isolate_data=*/nullptr, error, /*is_pooled=*/true));
+}
+
 DART_EXPORT void Dart_IsolateFlagsInitialize(Dart_IsolateFlags* flags) {
   Isolate::FlagsInitialize(flags);
 }
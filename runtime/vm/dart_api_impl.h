@@ -356,6 +356,10 @@ Isolate* CreateWithinExistingIsolateGroup(IsolateGroup* group,
                                           const char* name,
                                           char** error);
 
+// Creates a new isolate in [group] for its pool of idle isolates, see
+// Isolate::is_pooled.
+Isolate* CreatePooledIsolate(IsolateGroup* group, char** error);
+
 }  // namespace dart.
 
 #endif  // RUNTIME_VM_DART_API_IMPL_H_
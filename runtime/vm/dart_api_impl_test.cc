@@ -8414,6 +8414,27 @@ TEST_CASE(DartAPI_PostCObject_DoesNotRunFinalizerOnFailure) {
   free(my_str);  // Never a double-free.
 }
 
+TEST_CASE(DartAPI_PostMessageBuilder_DoesNotRunFinalizerOnFailure) {
+  char* my_str =
+      Utils::StrDup("Ownership of this memory remains with the caller");
+
+  Dart_MessageBuilder builder = Dart_NewMessageBuilder();
+  Dart_MessageObject array = Dart_MessageBuilderAddArray(builder, 2);
+  Dart_MessageObject external = Dart_MessageBuilderAddExternalTypedData(
+      builder, Dart_TypedData_kUint8, reinterpret_cast<uint8_t*>(my_str),
+      strlen(my_str), my_str, UnreachableFinalizer);
+  uint8_t* data = nullptr;
+  Dart_MessageObject typed_data = Dart_MessageBuilderAddTypedData(
+      builder, Dart_TypedData_kUint8, 10, &data);
+  EXPECT(Dart_MessageBuilderSetArrayElement(builder, array, 0, external));
+  EXPECT(Dart_MessageBuilderSetArrayElement(builder, array, 1, typed_data));
+
+  bool success = Dart_PostMessageBuilder(ILLEGAL_PORT, builder, array);
+  EXPECT(!success);
+
+  free(my_str);  // Never a double-free.
+}
+
 VM_UNIT_TEST_CASE(DartAPI_NewNativePort) {
   // Create a port with a bogus handler.
   Dart_Port error_port = Dart_NewNativePort("Foo", nullptr, true);
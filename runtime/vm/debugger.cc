@@ -267,7 +267,7 @@ ActivationFrame::ActivationFrame(Kind kind)
 
 bool Debugger::NeedsIsolateEvents() {
   ASSERT(isolate_ == Isolate::Current());
-  return !Isolate::IsSystemIsolate(isolate_) &&
+  return !Isolate::IsSystemIsolate(isolate_) && !isolate_->is_pooled() &&
          Service::isolate_stream.enabled();
 }
 
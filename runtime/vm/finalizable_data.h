@@ -16,6 +16,9 @@ struct FinalizableData {
   void* peer;
   Dart_HandleFinalizer callback;
   Dart_HandleFinalizer successful_write_callback;
+  // Whether the VM allocated the data for the message, rather than the sender
+  // handing it over.
+  bool owned;
 };
 
 class MessageFinalizableData {
@@ -42,10 +45,29 @@ class MessageFinalizableData {
     finalizable_data.peer = peer;
     finalizable_data.callback = callback;
     finalizable_data.successful_write_callback = successful_write_callback;
+    finalizable_data.owned = false;
     records_.Add(finalizable_data);
     external_size_ += external_size;
   }
 
+  /// Like [Put], for [data] the VM allocated for this message. Its [callback]
+  /// still runs when the finalizers are dropped, since no sender owns it.
+  void PutOwned(intptr_t external_size,
+                void* data,
+                Dart_HandleFinalizer callback) {
+    PutOwned(external_size, data, data, callback);
+  }
+
+  /// Like [PutOwned], for [data] kept alive by [peer], e.g. a reference the
+  /// VM took on a shared backing store for this message.
+  void PutOwned(intptr_t external_size,
+                void* data,
+                void* peer,
+                Dart_HandleFinalizer callback) {
+    Put(external_size, data, peer, callback);
+    records_.Last().owned = true;
+  }
+
   // Retrieve the next FinalizableData, but still run its finalizer when |this|
   // is destroyed.
   FinalizableData Get() {
@@ -69,6 +91,11 @@ class MessageFinalizableData {
   }
 
   void DropFinalizers() {
+    for (intptr_t i = take_position_; i < records_.length(); i++) {
+      if (records_[i].owned) {
+        records_[i].callback(nullptr, records_[i].peer);
+      }
+    }
     records_.Clear();
     get_position_ = 0;
     take_position_ = 0;
@@ -48,6 +48,7 @@ class Heap {
     kCanonicalHashes,
     kObjectIds,
     kLoadingUnits,
+    kSharedTypedDataStores,
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
     kHeapSamplingData,
 #endif
@@ -209,6 +210,17 @@ class Heap {
     return GetWeakEntry(raw_obj, kLoadingUnits);
   }
 
+  // Associate a SharedTypedDataStore with external typed data over its memory,
+  // see vm/shared_typed_data.h. A nonexistent store is equal to nullptr.
+  void SetSharedTypedDataStore(ObjectPtr raw_obj, void* store) {
+    SetWeakEntry(raw_obj, kSharedTypedDataStores,
+                 reinterpret_cast<intptr_t>(store));
+  }
+  void* GetSharedTypedDataStore(ObjectPtr raw_obj) const {
+    return reinterpret_cast<void*>(
+        GetWeakEntry(raw_obj, kSharedTypedDataStores));
+  }
+
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
   void SetHeapSamplingData(ObjectPtr obj, void* data) {
     SetWeakEntry(obj, kHeapSamplingData, reinterpret_cast<intptr_t>(data));
@@ -870,6 +870,7 @@ void GCMarker::ProcessWeakTables(Thread* thread) {
 #endif
     WeakTable* table =
         heap_->GetWeakTable(Heap::kOld, static_cast<Heap::WeakSelector>(sel));
+    table->FreeRetiredDataExclusive();
     intptr_t size = table->size();
     for (intptr_t i = 0; i < size; i++) {
       if (table->IsValidEntryAtExclusive(i)) {
@@ -885,6 +886,7 @@ void GCMarker::ProcessWeakTables(Thread* thread) {
     }
     table =
         heap_->GetWeakTable(Heap::kNew, static_cast<Heap::WeakSelector>(sel));
+    table->FreeRetiredDataExclusive();
     size = table->size();
     for (intptr_t i = 0; i < size; i++) {
       if (table->IsValidEntryAtExclusive(i)) {
@@ -1173,8 +1175,8 @@ void GCMarker::StartConcurrentMark(PageSpace* page_space) {
 
     if (i < (num_tasks - 1)) {
       // Begin marking on a helper thread.
-      bool result = Dart::thread_pool()->Run<ConcurrentMarkTask>(
-          this, isolate_group_, page_space, visitor);
+      bool result = Dart::thread_pool()->RunWithPriority<ConcurrentMarkTask>(
+          ThreadPool::kGCPriority, this, isolate_group_, page_space, visitor);
       ASSERT(result);
     } else {
       // For the last visitor, mark roots on the main thread.
@@ -1189,8 +1191,8 @@ void GCMarker::StartConcurrentMark(PageSpace* page_space) {
                   visitor->marked_bytes(), visitor->marked_micros());
       }
       // Continue non-root marking concurrently.
-      bool result = Dart::thread_pool()->Run<ConcurrentMarkTask>(
-          this, isolate_group_, page_space, visitor);
+      bool result = Dart::thread_pool()->RunWithPriority<ConcurrentMarkTask>(
+          ThreadPool::kGCPriority, this, isolate_group_, page_space, visitor);
       ASSERT(result);
     }
   }
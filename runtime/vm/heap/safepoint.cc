@@ -411,7 +411,8 @@ void SafepointHandler::RunTasks(IntrusiveDList<SafepointTask>* tasks) {
 
   // Then use thread pool workers.
   while (!tasks->IsEmpty()) {
-    bool result = Dart::thread_pool()->Run(tasks->RemoveFirst());
+    bool result = Dart::thread_pool()->Run(tasks->RemoveFirst(),
+                                           ThreadPool::kGCPriority);
     ASSERT(result);
   }
 
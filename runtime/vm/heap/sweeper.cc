@@ -213,7 +213,8 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
 };
 
 void GCSweeper::SweepConcurrent(IsolateGroup* isolate_group) {
-  bool result = Dart::thread_pool()->Run<ConcurrentSweeperTask>(isolate_group);
+  bool result = Dart::thread_pool()->RunWithPriority<ConcurrentSweeperTask>(
+      ThreadPool::kGCPriority, isolate_group);
   ASSERT(result);
 }
 
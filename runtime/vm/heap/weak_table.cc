@@ -30,7 +30,39 @@ intptr_t WeakTable::SizeFor(intptr_t count, intptr_t size) {
   return result;
 }
 
+intptr_t* WeakTable::AllocateData(intptr_t size) {
+  DataHeader* header = reinterpret_cast<DataHeader*>(
+      malloc(sizeof(DataHeader) + size * kEntrySize * kWordSize));
+  header->size = size;
+  header->next_retired = nullptr;
+  intptr_t* data = reinterpret_cast<intptr_t*>(header + 1);
+  for (intptr_t i = 0; i < size; i++) {
+    data[i * kEntrySize + kObjectOffset] = kNoEntry;
+    data[i * kEntrySize + kValueOffset] = kNoValue;
+  }
+  return data;
+}
+
+void WeakTable::RetireData(intptr_t* data) {
+  HeaderOf(data)->next_retired = retired_data_;
+  retired_data_ = data;
+}
+
+void WeakTable::FreeRetiredData() {
+  while (retired_data_ != nullptr) {
+    intptr_t* next = HeaderOf(retired_data_)->next_retired;
+    FreeData(retired_data_);
+    retired_data_ = next;
+  }
+}
+
 void WeakTable::SetValueExclusive(ObjectPtr key, intptr_t val) {
+  SetValueLocked(key, val);
+  // No lock-free reader can be using a replaced backing store.
+  FreeRetiredData();
+}
+
+void WeakTable::SetValueLocked(ObjectPtr key, intptr_t val) {
   const intptr_t mask = size() - 1;
   intptr_t idx = Hash(key) & mask;
   intptr_t empty_idx = -1;
@@ -62,9 +94,9 @@ void WeakTable::SetValueExclusive(ObjectPtr key, intptr_t val) {
   }
 
   ASSERT(!IsValidEntryAtExclusive(idx));
-  // Set the key and value.
-  SetObjectAt(idx, key);
+  // Set the value and publish the key.
   SetValueAt(idx, val);
+  SetObjectAt(idx, key);
   // Update the counts.
   set_used(used() + 1);
   set_count(count() + 1);
@@ -101,9 +133,9 @@ bool WeakTable::MarkValueExclusive(ObjectPtr key, intptr_t val) {
   }
 
   ASSERT(!IsValidEntryAtExclusive(idx));
-  // Set the key and value.
-  SetObjectAt(idx, key);
+  // Set the value and publish the key.
   SetValueAt(idx, val);
+  SetObjectAt(idx, key);
   // Update the counts.
   set_used(used() + 1);
   set_count(count() + 1);
@@ -111,6 +143,7 @@ bool WeakTable::MarkValueExclusive(ObjectPtr key, intptr_t val) {
   // Rehash if needed to ensure that there are empty slots available.
   if (used_ >= limit()) {
     Rehash();
+    FreeRetiredData();
   }
   return true;
 }
@@ -120,12 +153,10 @@ void WeakTable::Reset() {
   used_ = 0;
   count_ = 0;
   size_ = kMinSize;
-  free(old_data);
-  data_ = reinterpret_cast<intptr_t*>(malloc(size_ * kEntrySize * kWordSize));
-  for (intptr_t i = 0; i < size_; i++) {
-    data_[ObjectIndex(i)] = kNoEntry;
-    data_[ValueIndex(i)] = kNoValue;
-  }
+  FreeRetiredData();
+  FreeData(old_data);
+  data_ = AllocateData(size_);
+  published_data_.store(data_);
 }
 
 void WeakTable::Forward(ObjectPointerVisitor* visitor) {
@@ -138,6 +169,7 @@ void WeakTable::Forward(ObjectPointerVisitor* visitor) {
   }
 
   Rehash();
+  FreeRetiredData();
 }
 
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
@@ -168,12 +200,7 @@ void WeakTable::Rehash() {
 
   intptr_t new_size = SizeFor(count(), size());
   ASSERT(Utils::IsPowerOfTwo(new_size));
-  intptr_t* new_data =
-      reinterpret_cast<intptr_t*>(malloc(new_size * kEntrySize * kWordSize));
-  for (intptr_t i = 0; i < new_size; i++) {
-    new_data[ObjectIndex(i)] = kNoEntry;
-    new_data[ValueIndex(i)] = kNoValue;
-  }
+  intptr_t* new_data = AllocateData(new_size);
 
   intptr_t mask = new_size - 1;
   set_used(0);
@@ -197,10 +224,13 @@ void WeakTable::Rehash() {
   // We should only have used valid entries.
   ASSERT(used() == count());
 
-  // Switch to using the newly allocated backing store.
+  // Switch to using the newly allocated backing store. Lock-free readers may
+  // still be probing the old one, so it is only freed once we know we have
+  // exclusive access.
   size_ = new_size;
   data_ = new_data;
-  free(old_data);
+  published_data_.store(data_);
+  RetireData(old_data);
 }
 
 }  // namespace dart
@@ -8,6 +8,7 @@
 #include "vm/globals.h"
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
 #include "vm/lockers.h"
 #include "vm/raw_object.h"
 
@@ -18,7 +19,8 @@ class WeakTable {
   static constexpr intptr_t kNoValue = 0;
 
   WeakTable() : WeakTable(kMinSize) {}
-  explicit WeakTable(intptr_t size) : used_(0), count_(0) {
+  explicit WeakTable(intptr_t size)
+      : retired_data_(nullptr), used_(0), count_(0) {
     ASSERT(size >= 0);
     ASSERT(Utils::IsPowerOfTwo(kMinSize));
     if (size < kMinSize) {
@@ -33,14 +35,14 @@ class WeakTable {
     }
     size_ = size;
     ASSERT(Utils::IsPowerOfTwo(size_));
-    data_ = reinterpret_cast<intptr_t*>(malloc(size_ * kEntrySize * kWordSize));
-    for (intptr_t i = 0; i < size_; i++) {
-      data_[ObjectIndex(i)] = kNoEntry;
-      data_[ValueIndex(i)] = kNoValue;
-    }
+    data_ = AllocateData(size_);
+    published_data_.store(data_);
   }
 
-  ~WeakTable() { free(data_); }
+  ~WeakTable() {
+    FreeRetiredData();
+    FreeData(data_);
+  }
 
   static WeakTable* NewFrom(WeakTable* original) {
     return new WeakTable(SizeFor(original->count(), original->size()));
@@ -50,23 +52,29 @@ class WeakTable {
   intptr_t used() const { return used_; }
   intptr_t count() const { return count_; }
 
-  // The following methods can be called concurrently and are guarded by a lock.
+  // The following methods can be called concurrently. Updates are guarded by
+  // a lock, while lookups of existing entries do not need to take it.
 
   intptr_t GetValue(ObjectPtr key) {
+    const intptr_t value = GetValueUnlocked(key);
+    if (value != kNoValue) return value;
+    // The entry might have been added concurrently.
     MutexLocker ml(&mutex_);
     return GetValueExclusive(key);
   }
 
   void SetValue(ObjectPtr key, intptr_t val) {
     MutexLocker ml(&mutex_);
-    return SetValueExclusive(key, val);
+    return SetValueLocked(key, val);
   }
 
   intptr_t SetValueIfNonExistent(ObjectPtr key, intptr_t val) {
+    const intptr_t existing_value = GetValueUnlocked(key);
+    if (existing_value != kNoValue) return existing_value;
     MutexLocker ml(&mutex_);
     const auto old_value = GetValueExclusive(key);
     if (old_value == kNoValue) {
-      SetValueExclusive(key, val);
+      SetValueLocked(key, val);
       return val;
     }
     return old_value;
@@ -140,6 +148,10 @@ class WeakTable {
     return kNoValue;
   }
 
+  // Frees the backing stores replaced while concurrent readers may have been
+  // probing them.
+  void FreeRetiredDataExclusive() { FreeRetiredData(); }
+
   void Forward(ObjectPointerVisitor* visitor);
   void ReportSurvivingAllocations(Dart_HeapSamplingReportCallback callback,
                                   void* context);
@@ -158,6 +170,22 @@ class WeakTable {
   static constexpr intptr_t kDeletedEntry = 3;  // Not a valid OOP.
   static constexpr intptr_t kMinSize = 8;
 
+  // Every backing store is preceded by a header recording its size, so that
+  // lock-free readers always probe a consistent snapshot of the table, and a
+  // link used while the backing store is retired.
+  struct DataHeader {
+    intptr_t size;
+    intptr_t* next_retired;
+  };
+
+  static DataHeader* HeaderOf(const intptr_t* data) {
+    return reinterpret_cast<DataHeader*>(const_cast<intptr_t*>(data)) - 1;
+  }
+  static intptr_t* AllocateData(intptr_t size);
+  static void FreeData(intptr_t* data) { free(HeaderOf(data)); }
+  void RetireData(intptr_t* data);
+  void FreeRetiredData();
+
   static intptr_t SizeFor(intptr_t count, intptr_t size);
   static intptr_t LimitFor(intptr_t size) {
     // Maintain a maximum of 75% fill rate.
@@ -188,10 +216,13 @@ class WeakTable {
     return reinterpret_cast<ObjectPtr*>(&data_[ObjectIndex(i)]);
   }
 
+  // Lock-free readers may be probing this backing store. A new entry's value
+  // is stored before its key is published with release, so a reader loading
+  // the key with acquire sees the value that belongs to it.
   void SetObjectAt(intptr_t i, ObjectPtr key) {
     ASSERT(i >= 0);
     ASSERT(i < size());
-    data_[ObjectIndex(i)] = static_cast<intptr_t>(key);
+    StoreRelease(&data_[ObjectIndex(i)], static_cast<intptr_t>(key));
   }
 
   void SetValueAt(intptr_t i, intptr_t val) {
@@ -199,10 +230,36 @@ class WeakTable {
     ASSERT(i < size());
     // Setting a value of 0 is equivalent to invalidating the entry.
     if (val == 0) {
-      data_[ObjectIndex(i)] = kDeletedEntry;
+      StoreRelease(&data_[ObjectIndex(i)], kDeletedEntry);
       set_count(count() - 1);
     }
-    data_[ValueIndex(i)] = val;
+    StoreRelease(&data_[ValueIndex(i)], val);
+  }
+
+  void SetValueLocked(ObjectPtr key, intptr_t val);
+
+  // Looks up [key] without taking the lock. Backing stores replaced by a
+  // concurrent rehash stay alive until the next time the table is accessed
+  // exclusively, so this never reads freed memory. May return kNoValue for
+  // entries that are being added or removed concurrently.
+  intptr_t GetValueUnlocked(ObjectPtr key) const {
+    const intptr_t* data = published_data_.load();
+    const intptr_t size = HeaderOf(data)->size;
+    const intptr_t mask = size - 1;
+    intptr_t idx = Hash(key) & mask;
+    for (intptr_t i = 0; i < size; i++) {
+      const intptr_t obj = LoadAcquire(&data[ObjectIndex(idx)]);
+      if (obj == kNoEntry) break;
+      if (obj == static_cast<intptr_t>(key)) {
+        const intptr_t value = LoadAcquire(&data[ValueIndex(idx)]);
+        // If the slot was deleted and reused for another key since the key
+        // was loaded, the value may be the other key's.
+        if (LoadRelaxed(&data[ObjectIndex(idx)]) != obj) return kNoValue;
+        return value;
+      }
+      idx = (idx + 1) & mask;
+    }
+    return kNoValue;
   }
 
   void Rehash();
@@ -215,6 +272,11 @@ class WeakTable {
 
   // data_ contains size_ tuples of key/value.
   intptr_t* data_;
+  // The same as data_, for lock-free readers.
+  AcqRelAtomic<intptr_t*> published_data_;
+  // Backing stores replaced by Rehash that may still be in use by lock-free
+  // readers, linked through their headers.
+  intptr_t* retired_data_;
   // size_ keeps the number of entries in data_. used_ maintains the number of
   // non-NULL entries and will trigger rehashing if needed. count_ stores the
   // number valid entries, and will determine the size_ after rehashing.
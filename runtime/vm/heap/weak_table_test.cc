@@ -8,6 +8,7 @@
 #include "vm/globals.h"
 #include "vm/heap/heap.h"
 #include "vm/heap/weak_table.h"
+#include "vm/os_thread.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -59,4 +60,106 @@ ISOLATE_UNIT_TEST_CASE(WeakTables) {
   EXPECT_EQ(kNoValue, heap->GetObjectId(imm_obj.ptr()));
 }
 
+VM_UNIT_TEST_CASE(WeakTables_GrowWithRetiredData) {
+  WeakTable table;
+  const intptr_t kNumEntries = 1000;
+  for (intptr_t i = 0; i < kNumEntries; i++) {
+    table.SetValue(Smi::New(i), i + 1);
+    // Entries added before growing are found in the new backing store.
+    EXPECT_EQ(1, table.GetValue(Smi::New(0)));
+    EXPECT_EQ(i + 1, table.SetValueIfNonExistent(Smi::New(i), 42));
+  }
+  EXPECT_EQ(kNumEntries, table.count());
+  table.FreeRetiredDataExclusive();
+  for (intptr_t i = 0; i < kNumEntries; i++) {
+    EXPECT_EQ(i + 1, table.GetValue(Smi::New(i)));
+  }
+  EXPECT_EQ(WeakTable::kNoValue, table.GetValue(Smi::New(kNumEntries)));
+}
+
+struct WeakTableReaderArguments {
+  WeakTable* table;
+  intptr_t num_stable;
+  intptr_t num_keys;
+  std::atomic<bool> done;
+  std::atomic<intptr_t> mismatches;
+  Monitor* monitor;
+  ThreadJoinId join_id;
+};
+
+static intptr_t ValueForKey(intptr_t key) {
+  return 2 * key + 1;
+}
+
+static void WeakTableReader(uword parameter) {
+  WeakTableReaderArguments* arguments =
+      reinterpret_cast<WeakTableReaderArguments*>(parameter);
+  WeakTable* table = arguments->table;
+  while (!arguments->done.load()) {
+    for (intptr_t i = 0; i < arguments->num_keys; i++) {
+      const intptr_t value = table->GetValue(Smi::New(i));
+      // Stable keys are always present; other keys come and go but never
+      // have another key's value.
+      if ((value != ValueForKey(i)) &&
+          ((i < arguments->num_stable) || (value != WeakTable::kNoValue))) {
+        arguments->mismatches.fetch_add(1);
+      }
+    }
+  }
+  MonitorLocker ml(arguments->monitor);
+  arguments->join_id = OSThread::GetCurrentThreadJoinId(OSThread::Current());
+  ml.Notify();
+}
+
+VM_UNIT_TEST_CASE(WeakTables_ReuseSlotsWithConcurrentReader) {
+  WeakTable table;
+  Monitor monitor;
+  WeakTableReaderArguments arguments;
+  arguments.table = &table;
+  arguments.num_stable = 64;
+  arguments.num_keys = 256;
+  arguments.done = false;
+  arguments.mismatches = 0;
+  arguments.monitor = &monitor;
+  arguments.join_id = OSThread::kInvalidThreadJoinId;
+
+  for (intptr_t i = 0; i < arguments.num_stable; i++) {
+    table.SetValue(Smi::New(i), ValueForKey(i));
+  }
+  OSThread::Start("WeakTableReader", WeakTableReader,
+                  reinterpret_cast<uword>(&arguments));
+
+  // Insert and delete the other keys in turn, so their slots are reused by
+  // different keys while the reader is probing them.
+  const intptr_t kNumChurned = arguments.num_keys - arguments.num_stable;
+  for (intptr_t round = 0; round < 2000; round++) {
+    for (intptr_t i = 0; i < kNumChurned; i++) {
+      const intptr_t key =
+          arguments.num_stable + (i * 7 + round) % kNumChurned;
+      table.SetValue(Smi::New(key), ValueForKey(key));
+      if (i % 2 == round % 2) {
+        table.SetValue(Smi::New(key), 0);
+      }
+    }
+    for (intptr_t i = arguments.num_stable; i < arguments.num_keys; i++) {
+      table.SetValue(Smi::New(i), 0);
+    }
+  }
+  arguments.done = true;
+
+  {
+    MonitorLocker ml(&monitor);
+    while (arguments.join_id == OSThread::kInvalidThreadJoinId) {
+      ml.Wait();
+    }
+  }
+  OSThread::Join(arguments.join_id);
+
+  EXPECT_EQ(0, arguments.mismatches.load());
+  for (intptr_t i = 0; i < arguments.num_stable; i++) {
+    EXPECT_EQ(ValueForKey(i), table.GetValue(Smi::New(i)));
+  }
+  table.FreeRetiredDataExclusive();
+}
+
 }  // namespace dart
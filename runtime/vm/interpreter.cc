@@ -337,13 +337,33 @@ void LookupCache::Insert(intptr_t receiver_cid,
   entries_[probe1].target = target;
 }
 
+void CallSiteCache::Clear() {
+  for (intptr_t i = 0; i < kNumEntries; i++) {
+    entries_[i].call_site = nullptr;
+  }
+}
+
+void CallSiteCache::Insert(const KBCInstr* call_site,
+                           intptr_t receiver_cid,
+                           FunctionPtr target) {
+  // Otherwise we have to clear the cache or rehash on scavenges too.
+  ASSERT(target->IsOldObject());
+  // A polymorphic call site simply replaces its previous entry, leaving the
+  // other receiver classes to the LookupCache.
+  Entry& entry = entries_[IndexOf(call_site)];
+  entry.call_site = call_site;
+  entry.receiver_cid = receiver_cid;
+  entry.target = target;
+}
+
 Interpreter::Interpreter()
     : stack_(nullptr),
       fp_(nullptr),
       pp_(ObjectPool::null()),
       argdesc_(Array::null()),
       subtype_test_cache_(SubtypeTestCache::null()),
-      lookup_cache_() {
+      lookup_cache_(),
+      call_site_cache_() {
   // Setup interpreter support first. Some of this information is needed to
   // setup the architecture state.
   // We allocate the stack here, the size is computed as the sum of
@@ -729,7 +749,14 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall(Thread* thread,
 
   intptr_t receiver_cid = call_base[receiver_idx]->GetClassId();
 
+  // The return address identifies the call site.
+  const KBCInstr* call_site = *pc;
   FunctionPtr target;
+  if (LIKELY(call_site_cache_.Lookup(call_site, receiver_cid, &target))) {
+    top[0] = target;
+    return Invoke(thread, call_base, top, pc, FP, SP);
+  }
+
   if (UNLIKELY(!lookup_cache_.Lookup(receiver_cid, target_name, argdesc_,
                                      &target))) {
     // Table lookup miss.
@@ -754,6 +781,7 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall(Thread* thread,
 
   if (target != Function::null()) {
     lookup_cache_.Insert(receiver_cid, target_name, argdesc_, target);
+    call_site_cache_.Insert(call_site, receiver_cid, target);
     top[0] = target;
     return Invoke(thread, call_base, top, pc, FP, SP);
   }
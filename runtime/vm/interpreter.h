@@ -54,6 +54,56 @@ class LookupCache : public ValueObject {
   Entry entries_[kNumEntries];
 };
 
+// Monomorphic inline caches for instance call sites, keyed by the address of
+// the bytecode instruction following the call. The target name and arguments
+// descriptor are fixed for a given call site, so a hit only has to compare the
+// receiver class id. Misses fall back to the LookupCache.
+//
+// The bytecode format has no slots reserved for call site state, so the caches
+// are kept in a direct-mapped table instead of the object pool. Like the
+// LookupCache, the table is cleared before marking, which also guarantees that
+// call site addresses of collected bytecode are never reused for a hit.
+class CallSiteCache : public ValueObject {
+ public:
+  CallSiteCache() {
+    ASSERT(Utils::IsPowerOfTwo(kNumEntries));
+    Clear();
+  }
+
+  void Clear();
+  DART_FORCE_INLINE bool Lookup(const KBCInstr* call_site,
+                                intptr_t receiver_cid,
+                                FunctionPtr* target) const {
+    ASSERT(call_site != nullptr);  // Sentinel value.
+    const Entry& entry = entries_[IndexOf(call_site)];
+    if (entry.call_site == call_site && entry.receiver_cid == receiver_cid) {
+      *target = entry.target;
+      return true;
+    }
+    return false;
+  }
+  void Insert(const KBCInstr* call_site,
+              intptr_t receiver_cid,
+              FunctionPtr target);
+
+ private:
+  struct Entry {
+    const KBCInstr* call_site;
+    intptr_t receiver_cid;
+    FunctionPtr target;
+  };
+
+  static intptr_t IndexOf(const KBCInstr* call_site) {
+    // Call instructions are at least 2 bytes long, so drop the lowest bit.
+    return (reinterpret_cast<uword>(call_site) >> 1) & kTableMask;
+  }
+
+  static const intptr_t kNumEntries = 2048;
+  static const intptr_t kTableMask = kNumEntries - 1;
+
+  Entry entries_[kNumEntries];
+};
+
 class Interpreter {
  public:
   static const uword kInterpreterStackUnderflowSize = 0x80;
@@ -117,7 +167,11 @@ class Interpreter {
   void Unexit(Thread* thread);
 
   void VisitObjectPointers(ObjectPointerVisitor* visitor);
-  void ClearLookupCache() { lookup_cache_.Clear(); }
+  void ClearLookupCache() {
+    lookup_cache_.Clear();
+    call_site_cache_.Clear();
+  }
+  CallSiteCache* call_site_cache() { return &call_site_cache_; }
 
 #ifndef PRODUCT
   void set_is_debugging(bool value) { is_debugging_ = value; }
@@ -149,6 +203,7 @@ class Interpreter {
   ObjectPtr special_[KernelBytecode::kSpecialIndexCount];
 
   LookupCache lookup_cache_;
+  CallSiteCache call_site_cache_;
 
   void Exit(Thread* thread,
             ObjectPtr* base,
@@ -0,0 +1,142 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/globals.h"
+#if defined(DART_DYNAMIC_MODULES)
+
+#include "platform/assert.h"
+#include "vm/heap/heap.h"
+#include "vm/interpreter.h"
+#include "vm/object.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static FunctionPtr CreateTarget(const char* name) {
+  Thread* thread = Thread::Current();
+  const String& class_name = String::Handle(Symbols::New(thread, "Receiver"));
+  const Class& owner_class = Class::Handle(
+      Class::New(Library::Handle(), class_name, Script::Handle(),
+                 TokenPosition::kNoSource));
+  owner_class.set_is_synthesized_class_unsafe();  // Dummy class for testing.
+  owner_class.set_is_declaration_loaded_unsafe();
+  const String& function_name = String::Handle(Symbols::New(thread, name));
+  const FunctionType& signature = FunctionType::Handle(FunctionType::New());
+  return Function::New(signature, function_name,
+                       UntaggedFunction::kRegularFunction, false, false, false,
+                       false, false, owner_class, TokenPosition::kMinSource);
+}
+
+ISOLATE_UNIT_TEST_CASE(CallSiteCache_MonomorphicHit) {
+  const Function& target = Function::Handle(CreateTarget("foo"));
+  const KBCInstr bytecode[8] = {};
+  const KBCInstr* call_site = &bytecode[4];
+
+  CallSiteCache cache;
+  FunctionPtr found = Function::null();
+  EXPECT(!cache.Lookup(call_site, kSmiCid, &found));
+
+  cache.Insert(call_site, kSmiCid, target.ptr());
+  for (intptr_t i = 0; i < 3; i++) {
+    found = Function::null();
+    EXPECT(cache.Lookup(call_site, kSmiCid, &found));
+    EXPECT(found == target.ptr());
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(CallSiteCache_Miss) {
+  const Function& smi_target = Function::Handle(CreateTarget("smiFoo"));
+  const Function& mint_target = Function::Handle(CreateTarget("mintFoo"));
+  // Call sites this many bytes apart share an entry of the table.
+  const intptr_t kAliasDistance = 2 * 2048;
+  const KBCInstr bytecode[kAliasDistance + 8] = {};
+  const KBCInstr* call_site = &bytecode[4];
+  const KBCInstr* other_call_site = &bytecode[6];
+  const KBCInstr* aliased_call_site = &bytecode[kAliasDistance + 4];
+
+  CallSiteCache cache;
+  FunctionPtr found = Function::null();
+  cache.Insert(call_site, kSmiCid, smi_target.ptr());
+
+  // A different receiver class or call site misses.
+  EXPECT(!cache.Lookup(call_site, kMintCid, &found));
+  EXPECT(!cache.Lookup(other_call_site, kSmiCid, &found));
+  EXPECT(!cache.Lookup(aliased_call_site, kSmiCid, &found));
+  EXPECT(found == Function::null());
+
+  // The receiver class of the call site changes: the new class replaces the
+  // previous one, which is left to the LookupCache.
+  cache.Insert(call_site, kMintCid, mint_target.ptr());
+  EXPECT(cache.Lookup(call_site, kMintCid, &found));
+  EXPECT(found == mint_target.ptr());
+  EXPECT(!cache.Lookup(call_site, kSmiCid, &found));
+
+  // A call site sharing the entry evicts it.
+  cache.Insert(aliased_call_site, kSmiCid, smi_target.ptr());
+  EXPECT(cache.Lookup(aliased_call_site, kSmiCid, &found));
+  EXPECT(found == smi_target.ptr());
+  EXPECT(!cache.Lookup(call_site, kMintCid, &found));
+}
+
+ISOLATE_UNIT_TEST_CASE(CallSiteCache_InvalidatedBeforeMarking) {
+  const Function& target = Function::Handle(CreateTarget("foo"));
+  const Function& new_target = Function::Handle(CreateTarget("newFoo"));
+  const KBCInstr bytecode[8] = {};
+  const KBCInstr* call_site = &bytecode[4];
+
+  CallSiteCache* cache = Interpreter::Current()->call_site_cache();
+  FunctionPtr found = Function::null();
+  cache->Insert(call_site, kSmiCid, target.ptr());
+  EXPECT(cache->Lookup(call_site, kSmiCid, &found));
+
+  // The cache is cleared before marking, so the targets of call sites do
+  // not have to be visited.
+  GCTestHelper::CollectAllGarbage();
+  EXPECT(!cache->Lookup(call_site, kSmiCid, &found));
+
+  cache->Insert(call_site, kSmiCid, new_target.ptr());
+  EXPECT(cache->Lookup(call_site, kSmiCid, &found));
+  EXPECT(found == new_target.ptr());
+
+  Interpreter::Current()->ClearLookupCache();
+  EXPECT(!cache->Lookup(call_site, kSmiCid, &found));
+}
+
+#if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
+TEST_CASE(CallSiteCache_InvalidatedByReload) {
+  const char* kScript =
+      "class A { foo() => 1; }\n"
+      "main() => new A().foo();\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScript, nullptr);
+  EXPECT_VALID(lib);
+
+  const KBCInstr bytecode[8] = {};
+  const KBCInstr* call_site = &bytecode[4];
+  CallSiteCache* cache = nullptr;
+  FunctionPtr found = Function::null();
+  {
+    TransitionNativeToVM transition(thread);
+    const Function& target = Function::Handle(CreateTarget("foo"));
+    cache = Interpreter::Current()->call_site_cache();
+    cache->Insert(call_site, kSmiCid, target.ptr());
+    EXPECT(cache->Lookup(call_site, kSmiCid, &found));
+  }
+
+  // The reload replaces the method called through the call site.
+  const char* kReloadScript =
+      "class A { foo() => 2; }\n"
+      "main() => new A().foo();\n";
+  lib = TestCase::ReloadTestScript(kReloadScript);
+  EXPECT_VALID(lib);
+  {
+    TransitionNativeToVM transition(thread);
+    EXPECT(!cache->Lookup(call_site, kSmiCid, &found));
+  }
+}
+#endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
+
+}  // namespace dart
+
+#endif  // defined(DART_DYNAMIC_MODULES)
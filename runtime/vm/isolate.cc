@@ -98,6 +98,29 @@ DEFINE_FLAG(bool,
             "Disables the limit of the thread pool (simulates custom embedder "
             "with custom message handler on unlimited number of threads).");
 
+DEFINE_FLAG(int,
+            isolate_pool_size,
+            0,
+            "Number of idle isolates each isolate group keeps ready for "
+            "Isolate.spawn to claim (0 disables the pool).");
+
+DEFINE_FLAG(int,
+            max_isolate_threads,
+            0,
+            "Maximum number of threads on which the isolates of a group run "
+            "Dart code at the same time (0 for a default based on the new "
+            "generation size).");
+
+// The maximum number of isolates of a group that run Dart code at the same
+// time.
+static intptr_t MaxActiveMutators() {
+  const intptr_t max_mutators = Scavenger::MaxMutatorThreadCount();
+  if (FLAG_max_isolate_threads > 0) {
+    return Utils::Minimum<intptr_t>(max_mutators, FLAG_max_isolate_threads);
+  }
+  return max_mutators;
+}
+
 // Quick access to the locally defined thread() and isolate() methods.
 #define T (thread())
 #define I (isolate())
@@ -372,7 +395,7 @@ IsolateGroup::IsolateGroup(std::shared_ptr<IsolateGroupSource> source,
       boxed_field_list_(GrowableObjectArray::null()),
       program_lock_(new SafepointRwLock(SafepointLevel::kGCAndDeopt)),
       active_mutators_monitor_(new Monitor()),
-      max_active_mutators_(Scavenger::MaxMutatorThreadCount()),
+      max_active_mutators_(MaxActiveMutators()),
 #if !defined(PRODUCT)
       debugger_(new GroupDebugger(this)),
 #endif
@@ -389,7 +412,7 @@ IsolateGroup::IsolateGroup(std::shared_ptr<IsolateGroupSource> source,
       // so that there is a thread waiting in IncreaseMutatorCount (instead of
       // unscheduled task sitting in the thread pool's queue) to eventually
       // timeout and trigger StealActiveMutators.
-      max_worker_threads = Scavenger::MaxMutatorThreadCount() + 2;
+      max_worker_threads = max_active_mutators_ + 2;
     }
     thread_pool_.reset(new MutatorThreadPool(this, max_worker_threads));
   }
@@ -485,6 +508,45 @@ bool IsolateGroup::UnregisterIsolateDecrementCount() {
   return isolate_count_ == 0;
 }
 
+Isolate* IsolateGroup::TakePooledIsolate() {
+  if (FLAG_isolate_pool_size <= 0) {
+    return nullptr;
+  }
+  MutexLocker ml(&isolate_pool_mutex_);
+  if (isolate_pool_.is_empty()) {
+    GetIsolatePoolMissesMetric()->increment();
+    return nullptr;
+  }
+  GetIsolatePoolHitsMetric()->increment();
+  return isolate_pool_.RemoveLast();
+}
+
+bool IsolateGroup::StartIsolatePoolRefill() {
+  MutexLocker ml(&isolate_pool_mutex_);
+  if (isolate_pool_refilling_ ||
+      isolate_pool_.length() >= FLAG_isolate_pool_size) {
+    return false;
+  }
+  isolate_pool_refilling_ = true;
+  return true;
+}
+
+bool IsolateGroup::AddPooledIsolate(Isolate* isolate) {
+  MutexLocker ml(&isolate_pool_mutex_);
+  ASSERT(isolate_pool_refilling_);
+  isolate_pool_.Add(isolate);
+  if (isolate_pool_.length() >= FLAG_isolate_pool_size) {
+    isolate_pool_refilling_ = false;
+    return false;
+  }
+  return true;
+}
+
+void IsolateGroup::FinishIsolatePoolRefill() {
+  MutexLocker ml(&isolate_pool_mutex_);
+  isolate_pool_refilling_ = false;
+}
+
 void IsolateGroup::CreateHeap(bool is_vm_isolate,
                               bool is_service_or_kernel_isolate) {
   Heap::Init(this, is_vm_isolate,
@@ -704,6 +766,7 @@ void IsolateGroup::PrintToJSONObject(JSONObject* jsobj, bool ref) {
     JSONArray isolate_array(jsobj, "isolates");
     for (auto it = isolates_.Begin(); it != isolates_.End(); ++it) {
       Isolate* isolate = *it;
+      if (isolate->is_pooled()) continue;
       isolate_array.AddValue(isolate, /*ref=*/true);
     }
   }
@@ -2633,7 +2696,9 @@ void Isolate::Shutdown() {
 
   {
     StackZone zone(thread);
-    ServiceIsolate::SendIsolateShutdownMessage();
+    if (!is_pooled()) {
+      ServiceIsolate::SendIsolateShutdownMessage();
+    }
 #if !defined(PRODUCT)
     HandleScope handle_scope(thread);
     debugger()->Shutdown();
@@ -2676,6 +2741,53 @@ void Isolate::Shutdown() {
   Isolate::LowLevelCleanup(this);
 }
 
+void Isolate::MarkPooled() {
+  set_on_shutdown_callback(nullptr);
+  set_on_cleanup_callback(nullptr);
+  UpdateIsolateFlagsBit<IsPooledBit>(true);
+}
+
+void Isolate::ClaimFromPool(const char* name) {
+  Thread* thread = Thread::Current();
+  ASSERT(thread->isolate() == this);
+  ASSERT(is_pooled());
+  set_name(name);
+  set_on_shutdown_callback(Isolate::ShutdownCallback());
+  set_on_cleanup_callback(Isolate::CleanupCallback());
+  UpdateIsolateFlagsBit<IsPooledBit>(false);
+
+  // Announce the isolate the way Dart::InitializeIsolate does for isolates
+  // which are not pooled.
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  HandleScope handle_scope(thread);
+  ServiceIsolate::SendIsolateStartupMessage();
+#if !defined(PRODUCT)
+  debugger()->NotifyIsolateCreated();
+#endif
+}
+
+void IsolateGroup::ShutdownIsolatePoolIfUnused() {
+  MallocGrowableArray<Isolate*> pooled;
+  {
+    MutexLocker ml(&isolate_pool_mutex_);
+    SafepointReadRwLocker rl(Thread::Current(), isolates_lock_.get());
+    // Isolates are only added to the pool while the spawning isolate is alive.
+    if (isolate_pool_.is_empty() || isolate_count_ != isolate_pool_.length()) {
+      return;
+    }
+    while (!isolate_pool_.is_empty()) {
+      pooled.Add(isolate_pool_.RemoveLast());
+    }
+  }
+  // Pooled isolates never ran the embedder's initialize callback, so they are
+  // shut down without its shutdown and cleanup callbacks, see
+  // Isolate::MarkPooled. Shutting down the last one also shuts down this group.
+  for (intptr_t i = 0; i < pooled.length(); i++) {
+    ShutdownIsolate(reinterpret_cast<uword>(pooled[i]));
+  }
+}
+
 void Isolate::LowLevelCleanup(Isolate* isolate) {
 #if !defined(DART_PRECOMPILED_RUNTIME)
   if (isolate->is_kernel_isolate()) {
@@ -2760,6 +2872,7 @@ void Isolate::LowLevelCleanup(Isolate* isolate) {
     // TODO(dartbug.com/36097): An isolate just died. A significant amount of
     // memory might have become unreachable. We should evaluate how to best
     // inform the GC about this situation.
+    isolate_group->ShutdownIsolatePoolIfUnused();
   }
 }
 
@@ -2885,7 +2998,7 @@ bool Isolate::SetOwnerThread(ThreadId expected_old_owner, ThreadId new_owner) {
   return owner_thread_.compare_exchange_strong(expected_old_owner, new_owner);
 }
 
-ThreadId Isolate::GetOwnerThread(PortMap::Locker* locker) {
+ThreadId Isolate::GetOwnerThread(PortMap::ShardLocker* locker) {
   ASSERT(Isolate::Current() == this || locker != nullptr);
   return owner_thread_.load();
 }
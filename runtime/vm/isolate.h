@@ -329,6 +329,24 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
 
   bool ContainsOnlyOneIsolate();
 
+  // Idle isolates created ahead of time for lightweight Isolate.spawn to claim,
+  // see --isolate_pool_size. A pooled isolate has never run any Dart code and
+  // is handed out at most once, so claiming one is no different from creating
+  // a new one.
+  //
+  // Returns nullptr if the pool is empty.
+  Isolate* TakePooledIsolate();
+  // Returns true if the pool needs more isolates and no one else is creating
+  // them. The caller then creates isolates and passes them to
+  // [AddPooledIsolate] until it returns false, or calls
+  // [FinishIsolatePoolRefill] if it cannot create any more.
+  bool StartIsolatePoolRefill();
+  bool AddPooledIsolate(Isolate* isolate);
+  void FinishIsolatePoolRefill();
+  // Shuts down the pooled isolates once no other isolate is left to claim
+  // them. The group may be gone when this returns.
+  void ShutdownIsolatePoolIfUnused();
+
   Dart_Port interrupt_port() { return interrupt_port_; }
 
   ThreadRegistry* thread_registry() const { return thread_registry_.get(); }
@@ -853,6 +871,9 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   IntrusiveDList<Isolate> isolates_;
   RelaxedAtomic<Dart_Port> interrupt_port_ = ILLEGAL_PORT;
   intptr_t isolate_count_ = 0;
+  Mutex isolate_pool_mutex_;
+  MallocGrowableArray<Isolate*> isolate_pool_;
+  bool isolate_pool_refilling_ = false;
   bool initial_spawn_successful_ = false;
   Dart_LibraryTagHandler library_tag_handler_ = nullptr;
   Dart_DeferredLoadHandler deferred_load_handler_ = nullptr;
@@ -1410,6 +1431,15 @@ class Isolate : public IntrusiveDListEntry<Isolate> {
     UpdateIsolateFlagsBit<IsServiceRegisteredBit>(value);
   }
 
+  // Whether this isolate is waiting in its group's pool of idle isolates, see
+  // IsolateGroup::TakePooledIsolate. Pooled isolates are not announced to the
+  // service or debugger and run no embedder callbacks when shut down.
+  bool is_pooled() const { return LoadIsolateFlagsBit<IsPooledBit>(); }
+  void MarkPooled();
+  // Makes a pooled isolate, which must be the current isolate, look like one
+  // freshly created with [name].
+  void ClaimFromPool(const char* name);
+
   // Isolate-specific flag handling.
   static void FlagsInitialize(Dart_IsolateFlags* api_flags);
   void FlagsCopyTo(Dart_IsolateFlags* api_flags) const;
@@ -1497,9 +1527,10 @@ class Isolate : public IntrusiveDListEntry<Isolate> {
 
   bool SetOwnerThread(ThreadId expected_old_owner, ThreadId new_owner);
 
-  // Must be invoked with a valid PortMap::Locker, or while this isolate is the
-  // current isolate (in which case the locker may be null).
-  ThreadId GetOwnerThread(PortMap::Locker* locker);
+  // Must be invoked with a valid PortMap::ShardLocker for one of its ports, or
+  // while this isolate is the current isolate (in which case the locker may be
+  // null).
+  ThreadId GetOwnerThread(PortMap::ShardLocker* locker);
 
  private:
   friend class Dart;                  // Init, InitOnce, Shutdown.
@@ -1600,7 +1631,8 @@ class Isolate : public IntrusiveDListEntry<Isolate> {
   V(HasAttemptedStepping)                                                      \
   V(ShouldPausePostServiceRequest)                                             \
   V(IsSystemIsolate)                                                           \
-  V(IsServiceRegistered)
+  V(IsServiceRegistered)                                                       \
+  V(IsPooled)
 
   // Isolate specific flags.
   enum FlagBits {
@@ -15,6 +15,7 @@
 #include "vm/hash_table.h"
 #include "vm/heap/become.h"
 #include "vm/heap/safepoint.h"
+#include "vm/interpreter.h"
 #include "vm/isolate.h"
 #include "vm/kernel_isolate.h"
 #include "vm/kernel_loader.h"
@@ -2499,6 +2500,18 @@ ErrorPtr ProgramReloadContext::InvalidateWorld() {
   }
   DeoptimizeFunctionsOnStack();
   ResetUnoptimizedICsOnStack();
+#if defined(DART_DYNAMIC_MODULES)
+  // The interpreter caches targets by receiver class.
+  IG->ForEachIsolate([&](Isolate* isolate) {
+    Thread* mutator_thread = isolate->mutator_thread();
+    if (mutator_thread != nullptr) {
+      Interpreter* interpreter = mutator_thread->interpreter();
+      if (interpreter != nullptr) {
+        interpreter->ClearLookupCache();
+      }
+    }
+  });
+#endif  // defined(DART_DYNAMIC_MODULES)
   return RunInvalidationVisitors();
 }
 
@@ -54,6 +54,7 @@ Message::Message(PersistentHandle* handle, Priority priority)
 }
 
 Message::~Message() {
+  Dequeued();
   if (IsSnapshot()) {
     free(payload_.snapshot_);
   }
@@ -65,6 +66,14 @@ Message::~Message() {
   }
 }
 
+void Message::Dequeued() {
+  if (port_state_ != nullptr) {
+    port_state_->MessageDequeued();
+    port_state_->Release();
+    port_state_ = nullptr;
+  }
+}
+
 intptr_t Message::Id() const {
   // Messages are allocated on the C heap. Use the raw address as the id.
   return reinterpret_cast<intptr_t>(this);
@@ -165,6 +174,47 @@ void MessageQueue::Clear() {
   }
 }
 
+MessageInbox::~MessageInbox() {
+  // Ensure that all pending messages have been released.
+  MessageQueue queue;
+  DrainInto(&queue);
+}
+
+bool MessageInbox::Push(std::unique_ptr<Message> msg0) {
+  Message* msg = msg0.release();
+
+  // Make sure messages are not reused.
+  ASSERT(msg->next_ == nullptr);
+  Message* head = head_.load(std::memory_order_relaxed);
+  do {
+    msg->next_ = head;
+  } while (!head_.compare_exchange_weak(head, msg, std::memory_order_release,
+                                        std::memory_order_relaxed));
+  return head == nullptr;
+}
+
+intptr_t MessageInbox::DrainInto(MessageQueue* queue) {
+  Message* cur = head_.exchange(nullptr, std::memory_order_acquire);
+
+  // The inbox is a stack, reverse it to get the messages in posting order.
+  Message* first = nullptr;
+  intptr_t count = 0;
+  while (cur != nullptr) {
+    Message* next = cur->next_;
+    cur->next_ = first;
+    first = cur;
+    cur = next;
+    count++;
+  }
+  while (first != nullptr) {
+    Message* next = first->next_;
+    first->next_ = nullptr;
+    queue->Enqueue(std::unique_ptr<Message>(first), /*before_events=*/false);
+    first = next;
+  }
+  return count;
+}
+
 MessageQueue::Iterator::Iterator(const MessageQueue* queue) : next_(nullptr) {
   Reset(queue);
 }
@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_MESSAGE_H_
 #define RUNTIME_VM_MESSAGE_H_
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
@@ -21,6 +22,7 @@ namespace dart {
 
 class JSONStream;
 class PersistentHandle;
+class PortQueueState;
 
 class Message {
  public:
@@ -128,6 +130,21 @@ class Message {
 
   intptr_t Id() const;
 
+  // When the message was posted to its port, in monotonic microseconds, or 0
+  // if it was not posted through the port map.
+  int64_t enqueue_time() const { return enqueue_time_; }
+  void set_enqueue_time(int64_t time) { enqueue_time_ = time; }
+
+  // Attaches the queue of the destination port, which counts this message
+  // until [Dequeued] is called.
+  void set_port_state(PortQueueState* state) {
+    ASSERT(port_state_ == nullptr);
+    port_state_ = state;
+  }
+
+  // Called when the receiver takes this message off its queue.
+  void Dequeued();
+
   static const char* PriorityAsString(Priority priority);
 
  private:
@@ -135,6 +152,7 @@ class Message {
   static intptr_t const kFinalizerSnapshotLen = -2;
 
   friend class MessageQueue;
+  friend class MessageInbox;
 
   Message* next_ = nullptr;
   Dart_Port dest_port_;
@@ -151,6 +169,8 @@ class Message {
   intptr_t snapshot_length_ = 0;
   MessageFinalizableData* finalizable_data_ = nullptr;
   Priority priority_;
+  int64_t enqueue_time_ = 0;
+  PortQueueState* port_state_ = nullptr;
 
   DISALLOW_COPY_AND_ASSIGN(Message);
 };
@@ -204,6 +224,32 @@ class MessageQueue {
   DISALLOW_COPY_AND_ASSIGN(MessageQueue);
 };
 
+// A lock-free inbox that any number of threads can push messages to and that
+// a single consumer moves into a MessageQueue, a whole batch at a time.
+class MessageInbox {
+ public:
+  MessageInbox() : head_(nullptr) {}
+  ~MessageInbox();
+
+  // Adds a message to the inbox. Returns true if the inbox was empty, in
+  // which case the caller is responsible for waking up the consumer.
+  bool Push(std::unique_ptr<Message> msg);
+
+  bool IsEmpty() const {
+    return head_.load(std::memory_order_acquire) == nullptr;
+  }
+
+  // Appends all messages to |queue| in the order they were pushed and
+  // returns how many there were. Only one thread may drain at a time.
+  intptr_t DrainInto(MessageQueue* queue);
+
+ private:
+  // The most recently pushed message, linked to earlier ones through next_.
+  std::atomic<Message*> head_;
+
+  DISALLOW_COPY_AND_ASSIGN(MessageInbox);
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_MESSAGE_H_
@@ -15,11 +15,18 @@
 #include "vm/os.h"
 #include "vm/port.h"
 #include "vm/thread_interrupter.h"
+#include "vm/timeline.h"
 
 namespace dart {
 
 DECLARE_FLAG(bool, trace_service_pause_events);
 
+DEFINE_FLAG(int,
+            isolate_time_slice_micros,
+            10000,
+            "How long an isolate keeps handling messages while other isolates "
+            "wait for a thread (0 for no limit).");
+
 class MessageHandlerTask : public ThreadPool::Task {
  public:
   explicit MessageHandlerTask(MessageHandler* handler) : handler_(handler) {
@@ -67,6 +74,11 @@ MessageHandler::MessageHandler()
       paused_timestamp_(-1),
 #endif
       task_running_(false),
+      wakeups_(0),
+      tasks_started_(0),
+      last_worker_id_(ThreadPool::kNoAffinity),
+      time_slice_end_(0),
+      time_slice_expired_(false),
       pool_(nullptr),
       start_callback_(nullptr),
       end_callback_(nullptr),
@@ -121,62 +133,123 @@ bool MessageHandler::Run(ThreadPool* pool,
 
 void MessageHandler::PostMessage(std::unique_ptr<Message> message,
                                  bool before_events) {
-  Message::Priority saved_priority;
-
-  {
-    MonitorLocker ml(&monitor_);
-    if (FLAG_trace_isolates) {
-      Isolate* source_isolate = Isolate::Current();
-      if (source_isolate != nullptr) {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd "\n\tsource:     (%" Pd64
-            ") %s\n\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), static_cast<int64_t>(source_isolate->main_port()),
-            source_isolate->name(), name(), message->dest_port());
-      } else {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd
-            "\n\tsource:     <native code>\n"
-            "\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), name(), message->dest_port());
-      }
+  if (FLAG_trace_isolates) {
+    Isolate* source_isolate = Isolate::Current();
+    if (source_isolate != nullptr) {
+      OS::PrintErr(
+          "[>] Posting message:\n"
+          "\tlen:        %" Pd "\n\tsource:     (%" Pd64
+          ") %s\n\tdest:       %s\n"
+          "\tdest_port:  %" Pd64 "\n",
+          message->Size(), static_cast<int64_t>(source_isolate->main_port()),
+          source_isolate->name(), name(), message->dest_port());
+    } else {
+      OS::PrintErr(
+          "[>] Posting message:\n"
+          "\tlen:        %" Pd
+          "\n\tsource:     <native code>\n"
+          "\tdest:       %s\n"
+          "\tdest_port:  %" Pd64 "\n",
+          message->Size(), name(), message->dest_port());
     }
+  }
 
-    saved_priority = message->priority();
+  Message::Priority saved_priority = message->priority();
+  if (!message->IsOOB()) {
+    messages_enqueued_.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (!message->IsOOB() && !before_events) {
+    // Only the message that finds the inbox empty has to wake up the
+    // handler. Messages pushed after it are handled in the same batch.
+    if (inbox_.Push(std::move(message))) {
+      MonitorLocker ml(&monitor_);
+      WakeUpLocked(&ml);
+    }
+  } else {
+    MonitorLocker ml(&monitor_);
     if (message->IsOOB()) {
       oob_queue_->Enqueue(std::move(message), before_events);
     } else {
+      // Messages in the inbox are pending events too.
+      DrainInboxLocked();
       queue_->Enqueue(std::move(message), before_events);
     }
-    if (paused_for_messages_) {
-      ml.Notify();
-    }
-
-    if (pool_ != nullptr && !task_running_) {
-      task_running_ = true;
-      const bool launched_successfully = pool_->Run<MessageHandlerTask>(this);
-      ASSERT(launched_successfully);
-    }
+    WakeUpLocked(&ml);
   }
 
   // Invoke any custom message notification.
   MessageNotify(saved_priority);
 }
 
+void MessageHandler::WakeUpLocked(MonitorLocker* ml) {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  if (paused_for_messages_) {
+    wakeups_++;
+    ml->Notify();
+  }
+
+  if (pool_ != nullptr && !task_running_) {
+    task_running_ = true;
+    tasks_started_++;
+    const bool launched_successfully =
+        pool_->RunWithAffinity<MessageHandlerTask>(last_worker_id_, this);
+    ASSERT(launched_successfully);
+  }
+}
+
+intptr_t MessageHandler::DrainInboxLocked() {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  const intptr_t count = inbox_.DrainInto(queue_);
+#if defined(SUPPORT_TIMELINE)
+  if (count > 0) {
+    TimelineStream* stream = Timeline::GetIsolateStream();
+    TimelineEvent* event = stream->StartEvent();
+    if (event != nullptr) {
+      event->Counter("MessageHandler");
+      event->SetNumArguments(3);
+      event->FormatArgument(0, "batch", "%" Pd, count);
+      event->FormatArgument(1, "wakeups", "%" Pd64, wakeups_);
+      event->FormatArgument(2, "tasksStarted", "%" Pd64, tasks_started_);
+      event->Complete();
+    }
+  }
+#endif
+  return count;
+}
+
 std::unique_ptr<Message> MessageHandler::DequeueMessage(
     Message::Priority min_priority) {
   ASSERT(monitor_.IsOwnedByCurrentThread());
   std::unique_ptr<Message> message = oob_queue_->Dequeue();
   if ((message == nullptr) && (min_priority < Message::kOOBPriority)) {
+    if (queue_->IsEmpty()) {
+      DrainInboxLocked();
+    }
     message = queue_->Dequeue();
+    if (message != nullptr) {
+      message->Dequeued();
+      messages_dequeued_.fetch_add(1, std::memory_order_relaxed);
+    }
   }
   return message;
 }
 
+int64_t MessageHandler::OldestMessageAge(Dart_Port port) {
+  MonitorLocker ml(&monitor_);
+  DrainInboxLocked();
+  // Control messages posted before events and messages posted to ports
+  // without queue statistics have no enqueue time.
+  MessageQueue::Iterator it(queue_);
+  while (it.HasNext()) {
+    Message* message = it.Next();
+    if (message->enqueue_time() != 0 &&
+        (port == ILLEGAL_PORT || message->dest_port() == port)) {
+      return OS::GetCurrentMonotonicMicros() - message->enqueue_time();
+    }
+  }
+  return 0;
+}
+
 void MessageHandler::ClearOOBQueue() {
   oob_queue_->Clear();
 }
@@ -264,6 +337,16 @@ MessageHandler::MessageStatus MessageHandler::HandleMessages(
       allow_normal_messages = false;
     }
 
+    // Let other tasks have this handler's worker once its time slice is used
+    // up, see TaskCallback.
+    if ((saved_priority == Message::kNormalPriority) && (max_status == kOK) &&
+        (time_slice_end_ != 0) &&
+        (OS::GetCurrentMonotonicMicros() >= time_slice_end_) &&
+        pool_->HasPendingTasks()) {
+      time_slice_expired_ = true;
+      break;
+    }
+
     // Reevaluate the minimum allowable priority.  The paused state
     // may have changed as part of handling the message.  We may also
     // have encountered an error during message processing.
@@ -297,7 +380,7 @@ MessageHandler::MessageStatus MessageHandler::PauseAndHandleAllMessages(
   CheckAccess();
 #endif
   paused_for_messages_ = true;
-  while (queue_->IsEmpty() && oob_queue_->IsEmpty()) {
+  while (queue_->IsEmpty() && inbox_.IsEmpty() && oob_queue_->IsEmpty()) {
     Monitor::WaitResult wr;
     {
       // Ensure this thread is at a safepoint while we wait for new messages to
@@ -309,7 +392,7 @@ MessageHandler::MessageStatus MessageHandler::PauseAndHandleAllMessages(
     if (wr == Monitor::kTimedOut) {
       break;
     }
-    if (queue_->IsEmpty()) {
+    if (queue_->IsEmpty() && inbox_.IsEmpty()) {
       // There are only OOB messages. Handle them and then continue waiting for
       // normal messages unless there is an error.
       MessageStatus status = HandleMessages(&ml, false, false);
@@ -371,7 +454,7 @@ std::unique_ptr<Message> MessageHandler::StealOOBMessage() {
 
 bool MessageHandler::HasMessages() {
   MonitorLocker ml(&monitor_);
-  return !queue_->IsEmpty();
+  return !queue_->IsEmpty() || !inbox_.IsEmpty();
 }
 
 void MessageHandler::TaskCallback() {
@@ -391,6 +474,8 @@ void MessageHandler::TaskCallback() {
     // other message handler tasks will be started until this one sets
     // [task_running_] to false.
     ASSERT(task_running_);
+    last_worker_id_ = ThreadPool::CurrentWorkerId();
+    time_slice_expired_ = false;
 
 #if !defined(PRODUCT)
     if (ShouldPauseOnStart(kOK)) {
@@ -440,7 +525,12 @@ void MessageHandler::TaskCallback() {
 
       // Handle any pending messages for this message handler.
       if (status != kShutdown) {
+        if (FLAG_isolate_time_slice_micros > 0) {
+          time_slice_end_ =
+              OS::GetCurrentMonotonicMicros() + FLAG_isolate_time_slice_micros;
+        }
         status = HandleMessages(&ml, (status == kOK), true);
+        time_slice_end_ = 0;
       }
     }
 
@@ -492,6 +582,20 @@ void MessageHandler::TaskCallback() {
       run_end_callback = end_callback_ != nullptr;
     }
 
+    // Messages pushed to the inbox since it was last drained did not start a
+    // task of their own, as this one was still running. Leave it to a new
+    // task to handle them. After its time slice the handler queues up behind
+    // the tasks that were waiting instead of staying on this worker.
+    if (pool_ != nullptr && (time_slice_expired_ || !inbox_.IsEmpty())) {
+      const intptr_t worker_id =
+          time_slice_expired_ ? ThreadPool::kNoAffinity : last_worker_id_;
+      tasks_started_++;
+      const bool launched_successfully =
+          pool_->RunWithAffinity<MessageHandlerTask>(worker_id, this);
+      ASSERT(launched_successfully);
+      return;
+    }
+
     // Clear task_running_ last.  This allows other tasks to potentially start
     // for this message handler.
     ASSERT(oob_queue_->IsEmpty());
@@ -527,6 +631,7 @@ void MessageHandler::OnAllPortsClosed() {
         "\thandler:    %s\n",
         name());
   }
+  DrainInboxLocked();
   queue_->Clear();
   oob_queue_->Clear();
 }
@@ -602,6 +707,7 @@ void MessageHandler::PausedOnExitLocked(MonitorLocker* ml, bool paused) {
 MessageHandler::AcquiredQueues::AcquiredQueues(MessageHandler* handler)
     : handler_(handler), ml_(&handler->monitor_) {
   ASSERT(handler != nullptr);
+  handler_->DrainInboxLocked();
   handler_->oob_message_handling_allowed_ = false;
 }
 
@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_MESSAGE_HANDLER_H_
 #define RUNTIME_VM_MESSAGE_HANDLER_H_
 
+#include <atomic>
 #include <memory>
 
 #include "vm/isolate.h"
@@ -82,6 +83,23 @@ class MessageHandler : public PortHandler {
   // handler.
   bool HasMessages();
 
+  // Statistics about the normal messages posted to this handler, see the
+  // isolate.messages.* metrics.
+  int64_t messages_enqueued() const {
+    return messages_enqueued_.load(std::memory_order_relaxed);
+  }
+  int64_t messages_queued() const {
+    return messages_enqueued() -
+           messages_dequeued_.load(std::memory_order_relaxed);
+  }
+  int64_t messages_dropped() const {
+    return messages_dropped_.load(std::memory_order_relaxed);
+  }
+
+  // How long the oldest queued normal message for [port], or for any port if
+  // [port] is ILLEGAL_PORT, has been waiting in microseconds, 0 if none is.
+  int64_t OldestMessageAge(Dart_Port port = ILLEGAL_PORT);
+
   // Whether to keep this message handler alive or whether it should shutdown.
   virtual bool KeepAliveLocked() { return true; }
 
@@ -172,6 +190,10 @@ class MessageHandler : public PortHandler {
   void PostMessage(std::unique_ptr<Message> message,
                    bool before_events = false) override;
 
+  void OnMessageDropped() override {
+    messages_dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+
  private:
   template <typename GCVisitorType>
   friend void MournFinalizerEntry(GCVisitorType*, FinalizerEntryPtr);
@@ -221,6 +243,14 @@ class MessageHandler : public PortHandler {
   void PausedOnStartLocked(MonitorLocker* ml, bool paused);
   void PausedOnExitLocked(MonitorLocker* ml, bool paused);
 
+  // Wakes up whoever handles messages: a thread waiting in
+  // PauseAndHandleAllMessages, or a new task on the thread pool.
+  void WakeUpLocked(MonitorLocker* ml);
+
+  // Moves the messages posted to the inbox_ since the last call to the end of
+  // the queue_. Returns the number of messages moved.
+  intptr_t DrainInboxLocked();
+
   // Dequeue the next message.  Prefer messages from the oob_queue_ to
   // messages from the queue_.
   std::unique_ptr<Message> DequeueMessage(Message::Priority min_priority);
@@ -232,9 +262,17 @@ class MessageHandler : public PortHandler {
                                bool allow_normal_messages,
                                bool allow_multiple_normal_messages);
 
-  Monitor monitor_;  // Protects all fields in MessageHandler.
+  // Counts of normal messages, updated without holding the monitor_.
+  std::atomic<int64_t> messages_enqueued_ = {0};
+  std::atomic<int64_t> messages_dequeued_ = {0};
+  std::atomic<int64_t> messages_dropped_ = {0};
+
+  Monitor monitor_;  // Protects all fields in MessageHandler but inbox_.
   MessageQueue* queue_;
   MessageQueue* oob_queue_;
+  // Normal messages are posted here without taking the monitor_, and moved to
+  // the queue_ in batches by the thread handling messages.
+  MessageInbox inbox_;
   // This flag is not thread safe and can only reliably be accessed on a single
   // thread.
   bool oob_message_handling_allowed_;
@@ -256,6 +294,16 @@ class MessageHandler : public PortHandler {
   int64_t paused_timestamp_;
 #endif
   bool task_running_;
+  // How often posting messages woke up a paused handler or started a task.
+  int64_t wakeups_;
+  int64_t tasks_started_;
+  // The pool worker that ran the last task of this handler. The next task
+  // prefers to run there too.
+  intptr_t last_worker_id_;
+  // When a task handling messages has to give up its worker if other tasks
+  // are waiting for one, see FLAG_isolate_time_slice_micros.
+  int64_t time_slice_end_;
+  bool time_slice_expired_;
   ThreadPool* pool_;
   StartCallback start_callback_;
   EndCallback end_callback_;
@@ -21,7 +21,11 @@ class MessageHandlerTestPeer {
   void OnPortClosed(Dart_Port port) { handler_->OnPortClosed(port); }
   void OnAllPortsClosed() { handler_->OnAllPortsClosed(); }
 
-  MessageQueue* queue() const { return handler_->queue_; }
+  MessageQueue* queue() const {
+    MonitorLocker ml(&handler_->monitor_);
+    handler_->DrainInboxLocked();
+    return handler_->queue_;
+  }
   MessageQueue* oob_queue() const { return handler_->oob_queue_; }
 
  private:
@@ -344,6 +348,52 @@ static void SendMessages(uword param) {
   }
 }
 
+VM_UNIT_TEST_CASE(MessageHandler_ConcurrentPostMessage) {
+  TestMessageHandler handler;
+  MessageHandlerTestPeer handler_peer(&handler);
+  const int kThreadCount = 4;
+  const int kMessageCount = 1000;
+
+  Dart_Port ports[kThreadCount][kMessageCount];
+  ThreadStartInfo infos[kThreadCount];
+  for (int i = 0; i < kThreadCount; i++) {
+    for (int j = 0; j < kMessageCount; j++) {
+      ports[i][j] = i * kMessageCount + j + 1;
+    }
+    infos[i].handler = &handler;
+    infos[i].ports = ports[i];
+    infos[i].count = kMessageCount;
+    infos[i].join_id = OSThread::kInvalidThreadJoinId;
+    OSThread::Start("SendMessages", SendMessages,
+                    reinterpret_cast<uword>(&infos[i]));
+  }
+
+  // Every message is notified.
+  {
+    MonitorLocker ml(handler.monitor());
+    while (handler.notify_count() < kThreadCount * kMessageCount) {
+      ml.Wait();
+    }
+  }
+  for (int i = 0; i < kThreadCount; i++) {
+    ASSERT(infos[i].join_id != OSThread::kInvalidThreadJoinId);
+    OSThread::Join(infos[i].join_id);
+  }
+
+  // Each thread's messages arrive in order.
+  EXPECT_EQ(kThreadCount * kMessageCount, handler_peer.queue()->Length());
+  int next[kThreadCount] = {};
+  std::unique_ptr<Message> message;
+  while ((message = handler_peer.queue()->Dequeue()) != nullptr) {
+    const intptr_t sender = (message->dest_port() - 1) / kMessageCount;
+    EXPECT_EQ(ports[sender][next[sender]], message->dest_port());
+    next[sender]++;
+  }
+  for (int i = 0; i < kThreadCount; i++) {
+    EXPECT_EQ(kMessageCount, next[i]);
+  }
+}
+
 VM_UNIT_TEST_CASE(MessageHandler_Run) {
   TestMessageHandler handler;
   ThreadPool pool;
@@ -21,6 +21,7 @@
 #include "vm/object.h"
 #include "vm/object_graph_copy.h"
 #include "vm/object_store.h"
+#include "vm/shared_typed_data.h"
 #include "vm/symbols.h"
 #include "vm/type_testing_stubs.h"
 
@@ -160,6 +161,13 @@ class BaseSerializer : public StackResource {
   void WriteBytes(const void* addr, intptr_t len) {
     stream_.WriteBytes(addr, len);
   }
+  // Reserves [len] bytes in the stream to be filled in place. The result is
+  // only valid until the next write.
+  uint8_t* ReserveBytes(intptr_t len) {
+    const intptr_t position = stream_.Position();
+    stream_.SetPosition(position + len);
+    return stream_.buffer() + position;
+  }
   void WriteAscii(const String& str) {
     intptr_t len = str.Length();
     WriteUnsigned(len);
@@ -1274,6 +1282,10 @@ class TypedDataMessageDeserializationCluster
   const intptr_t cid_;
 };
 
+// Typed data from native code of at least this size is handed to the
+// receiver as external typed data rather than copied into its heap.
+static constexpr intptr_t kMinExternalizedTypedDataSize = 64 * KB;
+
 // This function's name can appear in Observatory.
 static void IsolateMessageTypedDataFinalizer(void* isolate_callback_data,
                                              void* buffer) {
@@ -1308,12 +1320,18 @@ class ExternalTypedDataMessageSerializationCluster
       s->WriteUnsigned(length);
 
       intptr_t length_in_bytes = length * element_size;
+      // Shared backing stores are passed by reference.
+      SharedTypedDataStore* store = SharedTypedDataStore::Of(data->ptr());
+      if (store != nullptr) {
+        store->Retain();
+        s->finalizable_data()->PutOwned(length_in_bytes, store->data(), store,
+                                        SharedTypedDataStore::Finalizer);
+        continue;
+      }
       void* passed_data = malloc(length_in_bytes);
       memmove(passed_data, data->untag()->data_, length_in_bytes);
-      s->finalizable_data()->Put(length_in_bytes,
-                                 passed_data,  // data
-                                 passed_data,  // peer,
-                                 IsolateMessageTypedDataFinalizer);
+      s->finalizable_data()->PutOwned(length_in_bytes, passed_data,
+                                      IsolateMessageTypedDataFinalizer);
     }
   }
 
@@ -1333,6 +1351,20 @@ class ExternalTypedDataMessageSerializationCluster
       intptr_t length = data->value.as_external_typed_data.length;
       s->WriteUnsigned(length);
 
+      if (data->type == Dart_CObject_kTypedData) {
+        // Large typed data is copied once into memory the receiver adopts,
+        // instead of into the message and again into the receiver's heap.
+        intptr_t length_in_bytes = length * element_size;
+        void* passed_data = malloc(length_in_bytes);
+        if (passed_data == nullptr) {
+          OUT_OF_MEMORY();
+        }
+        memmove(passed_data, data->value.as_typed_data.values,
+                length_in_bytes);
+        s->finalizable_data()->PutOwned(length_in_bytes, passed_data,
+                                        IsolateMessageTypedDataFinalizer);
+        continue;
+      }
       s->finalizable_data()->Put(length * element_size,
                                  data->value.as_external_typed_data.data,
                                  data->value.as_external_typed_data.peer,
@@ -1363,6 +1395,11 @@ class ExternalTypedDataMessageDeserializationCluster
       intptr_t external_size = length * element_size;
       data.AddFinalizer(finalizable_data.peer, finalizable_data.callback,
                         external_size);
+      if (finalizable_data.callback == &SharedTypedDataStore::Finalizer) {
+        SharedTypedDataStore::Attach(
+            data.ptr(),
+            static_cast<SharedTypedDataStore*>(finalizable_data.peer));
+      }
       d->AssignRef(data.ptr());
     }
   }
@@ -2503,14 +2540,11 @@ class OneByteStringMessageSerializationCluster
       Utf8::Type type = Utf8::kLatin1;
       intptr_t latin1_len = Utf8::CodeUnitCount(utf8_str, utf8_len, &type);
 
-      uint8_t* latin1_str = reinterpret_cast<uint8_t*>(
-          dart::malloc(latin1_len * sizeof(uint8_t)));
+      s->WriteUnsigned(latin1_len);
+      uint8_t* latin1_str = s->ReserveBytes(latin1_len * sizeof(uint8_t));
       bool success =
           Utf8::DecodeToLatin1(utf8_str, utf8_len, latin1_str, latin1_len);
       ASSERT(success);
-      s->WriteUnsigned(latin1_len);
-      s->WriteBytes(latin1_str, latin1_len);
-      ::free(latin1_str);
     }
   }
 
@@ -2611,15 +2645,12 @@ class TwoByteStringMessageSerializationCluster
       Utf8::Type type = Utf8::kLatin1;
       intptr_t utf16_len = Utf8::CodeUnitCount(utf8_str, utf8_len, &type);
 
+      s->WriteUnsigned(utf16_len);
       uint16_t* utf16_str = reinterpret_cast<uint16_t*>(
-          dart::malloc(utf16_len * sizeof(uint16_t)));
+          s->ReserveBytes(utf16_len * sizeof(uint16_t)));
       bool success =
           Utf8::DecodeToUTF16(utf8_str, utf8_len, utf16_str, utf16_len);
       ASSERT(success);
-      s->WriteUnsigned(utf16_len);
-      s->WriteBytes(reinterpret_cast<const uint8_t*>(utf16_str),
-                    utf16_len * sizeof(uint16_t));
-      ::free(utf16_str);
     }
   }
 
@@ -2907,6 +2938,11 @@ bool ApiMessageSerializer::Trace(Dart_CObject* object) {
         if (len < 0 || len > TypedData::MaxElements(cid)) {
           return Fail("invalid typeddata length");
         }
+        if (len * TypedData::ElementSizeInBytes(cid) >=
+            kMinExternalizedTypedDataSize) {
+          cid = cid - kTypedDataCidRemainderInternal +
+                kTypedDataCidRemainderExternal;
+        }
       }
       break;
     case Dart_CObject_kExternalTypedData:
@@ -3438,6 +3474,359 @@ std::unique_ptr<Message> WriteApiMessage(Zone* zone,
   return serializer.Finish(dest_port, priority);
 }
 
+// The external data of a typed data node written by an ApiMessageBuilder.
+struct ApiMessageExternalData {
+  void* data;
+  void* peer;
+  Dart_HandleFinalizer callback;
+  intptr_t external_size;
+  bool owned;
+};
+
+class ApiMessageBuilder::Cluster : public MallocAllocated {
+ public:
+  Cluster(intptr_t class_id, bool canonical, MessagePhase message_phase)
+      : cid(class_id),
+        is_canonical(canonical),
+        phase(message_phase),
+        nodes(64) {}
+
+  ~Cluster() {
+    // Data the builder allocated is freed if the message was never finished.
+    for (const ApiMessageExternalData& data : external_data) {
+      if (data.owned) {
+        data.callback(nullptr, data.peer);
+      }
+    }
+  }
+
+  template <typename T>
+  void Write(T value) {
+    BaseWriteStream::Raw<sizeof(T), T>::Write(&nodes, value);
+  }
+
+  const intptr_t cid;
+  const bool is_canonical;
+  const MessagePhase phase;
+  intptr_t count = 0;
+  // The reference of the first node, once the layout of the message is known.
+  intptr_t start_ref = 0;
+  MallocWriteStream nodes;
+  // The external data of typed data nodes, in node order.
+  MallocGrowableArray<ApiMessageExternalData> external_data;
+  // The elements of all array nodes, one array after the other.
+  MallocGrowableArray<intptr_t> elements;
+  MallocGrowableArray<intptr_t> element_starts;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(Cluster);
+};
+
+// Matches ApiMessageSerializer::AddBaseObjects.
+static constexpr intptr_t kApiMessageNumBaseObjects = 8;
+static constexpr intptr_t kApiMessageNullRef = kFirstReference;
+static constexpr intptr_t kApiMessageTrueRef = kFirstReference + 6;
+static constexpr intptr_t kApiMessageFalseRef = kFirstReference + 7;
+
+static intptr_t ExternalTypedDataCidFor(Dart_TypedData_Type type) {
+  switch (type) {
+    case Dart_TypedData_kInt8:
+      return kExternalTypedDataInt8ArrayCid;
+    case Dart_TypedData_kUint8:
+      return kExternalTypedDataUint8ArrayCid;
+    case Dart_TypedData_kUint8Clamped:
+      return kExternalTypedDataUint8ClampedArrayCid;
+    case Dart_TypedData_kInt16:
+      return kExternalTypedDataInt16ArrayCid;
+    case Dart_TypedData_kUint16:
+      return kExternalTypedDataUint16ArrayCid;
+    case Dart_TypedData_kInt32:
+      return kExternalTypedDataInt32ArrayCid;
+    case Dart_TypedData_kUint32:
+      return kExternalTypedDataUint32ArrayCid;
+    case Dart_TypedData_kInt64:
+      return kExternalTypedDataInt64ArrayCid;
+    case Dart_TypedData_kUint64:
+      return kExternalTypedDataUint64ArrayCid;
+    case Dart_TypedData_kFloat32:
+      return kExternalTypedDataFloat32ArrayCid;
+    case Dart_TypedData_kFloat64:
+      return kExternalTypedDataFloat64ArrayCid;
+    case Dart_TypedData_kInt32x4:
+      return kExternalTypedDataInt32x4ArrayCid;
+    case Dart_TypedData_kFloat32x4:
+      return kExternalTypedDataFloat32x4ArrayCid;
+    case Dart_TypedData_kFloat64x2:
+      return kExternalTypedDataFloat64x2ArrayCid;
+    default:
+      return kIllegalCid;
+  }
+}
+
+ApiMessageBuilder::ApiMessageBuilder() {
+  Clear();
+}
+
+ApiMessageBuilder::~ApiMessageBuilder() {
+  for (Cluster* cluster : clusters_) {
+    delete cluster;
+  }
+}
+
+void ApiMessageBuilder::Clear() {
+  for (Cluster* cluster : clusters_) {
+    delete cluster;
+  }
+  clusters_.Clear();
+  objects_.Clear();
+  objects_.Add({nullptr, kApiMessageNullRef});
+  objects_.Add({nullptr, kApiMessageTrueRef});
+  objects_.Add({nullptr, kApiMessageFalseRef});
+  ASSERT(objects_.length() == kFalseObject + 1);
+}
+
+ApiMessageBuilder::Cluster* ApiMessageBuilder::ClusterFor(intptr_t cid,
+                                                          bool is_canonical) {
+  for (Cluster* cluster : clusters_) {
+    if (cluster->cid == cid) {
+      return cluster;
+    }
+  }
+  MessagePhase phase;
+  switch (cid) {
+    case kSmiCid:
+    case kMintCid:
+    case kDoubleCid:
+    case kOneByteStringCid:
+    case kTwoByteStringCid:
+      phase = MessagePhase::kBeforeTypes;
+      break;
+    default:
+      ASSERT(cid == kArrayCid || IsExternalTypedDataClassId(cid));
+      phase = MessagePhase::kNonCanonicalInstances;
+      break;
+  }
+  Cluster* cluster = new Cluster(cid, is_canonical, phase);
+  clusters_.Add(cluster);
+  return cluster;
+}
+
+intptr_t ApiMessageBuilder::AddObject(Cluster* cluster) {
+  objects_.Add({cluster, cluster->count++});
+  return objects_.length() - 1;
+}
+
+intptr_t ApiMessageBuilder::AddInt64(int64_t value) {
+  if (Smi::IsValid(value)) {
+    Cluster* cluster = ClusterFor(kSmiCid, /*is_canonical=*/true);
+    cluster->Write<intptr_t>(value);
+    return AddObject(cluster);
+  }
+  Cluster* cluster = ClusterFor(kMintCid, /*is_canonical=*/false);
+  cluster->Write<int64_t>(value);
+  return AddObject(cluster);
+}
+
+intptr_t ApiMessageBuilder::AddDouble(double value) {
+  Cluster* cluster = ClusterFor(kDoubleCid, /*is_canonical=*/false);
+  cluster->Write<double>(value);
+  return AddObject(cluster);
+}
+
+intptr_t ApiMessageBuilder::AddString(const char* utf8, intptr_t length) {
+  const uint8_t* utf8_str = reinterpret_cast<const uint8_t*>(utf8);
+  if (length < 0 || (length > 0 && utf8 == nullptr) ||
+      !Utf8::IsValid(utf8_str, length)) {
+    return kIllegalObject;
+  }
+  Utf8::Type type = Utf8::kLatin1;
+  intptr_t len = Utf8::CodeUnitCount(utf8_str, length, &type);
+  if (len > String::kMaxElements) {
+    return kIllegalObject;
+  }
+
+  // Decode straight into the message instead of into a temporary buffer.
+  const bool is_latin1 = type == Utf8::kLatin1;
+  Cluster* cluster =
+      ClusterFor(is_latin1 ? kOneByteStringCid : kTwoByteStringCid,
+                 /*is_canonical=*/false);
+  MallocWriteStream* nodes = &cluster->nodes;
+  nodes->WriteUnsigned(len);
+  const intptr_t position = nodes->Position();
+  const intptr_t char_size = is_latin1 ? sizeof(uint8_t) : sizeof(uint16_t);
+  nodes->SetPosition(position + len * char_size);
+  uint8_t* chars = nodes->buffer() + position;
+  bool success =
+      is_latin1 ? Utf8::DecodeToLatin1(utf8_str, length, chars, len)
+                : Utf8::DecodeToUTF16(utf8_str, length,
+                                      reinterpret_cast<uint16_t*>(chars), len);
+  ASSERT(success);
+  return AddObject(cluster);
+}
+
+intptr_t ApiMessageBuilder::AddTypedData(Dart_TypedData_Type type,
+                                         intptr_t length,
+                                         uint8_t** data) {
+  const intptr_t cid = ExternalTypedDataCidFor(type);
+  if (cid == kIllegalCid || length < 0 ||
+      length > ExternalTypedData::MaxElements(cid)) {
+    return kIllegalObject;
+  }
+  const intptr_t length_in_bytes =
+      length * ExternalTypedData::ElementSizeInBytes(cid);
+  void* buffer = malloc(length_in_bytes > 0 ? length_in_bytes : 1);
+  if (buffer == nullptr) {
+    return kIllegalObject;
+  }
+  Cluster* cluster = ClusterFor(cid, /*is_canonical=*/false);
+  cluster->nodes.WriteUnsigned(length);
+  cluster->external_data.Add({buffer, buffer, IsolateMessageTypedDataFinalizer,
+                              length_in_bytes, /*owned=*/true});
+  *data = reinterpret_cast<uint8_t*>(buffer);
+  return AddObject(cluster);
+}
+
+intptr_t ApiMessageBuilder::AddExternalTypedData(
+    Dart_TypedData_Type type,
+    uint8_t* data,
+    intptr_t length,
+    void* peer,
+    Dart_HandleFinalizer callback) {
+  const intptr_t cid = ExternalTypedDataCidFor(type);
+  if (cid == kIllegalCid || callback == nullptr || length < 0 ||
+      length > ExternalTypedData::MaxElements(cid)) {
+    return kIllegalObject;
+  }
+  Cluster* cluster = ClusterFor(cid, /*is_canonical=*/false);
+  cluster->nodes.WriteUnsigned(length);
+  cluster->external_data.Add(
+      {data, peer, callback,
+       length * ExternalTypedData::ElementSizeInBytes(cid), /*owned=*/false});
+  return AddObject(cluster);
+}
+
+intptr_t ApiMessageBuilder::AddArray(intptr_t length) {
+  if (!Array::IsValidLength(length)) {
+    return kIllegalObject;
+  }
+  Cluster* cluster = ClusterFor(kArrayCid, /*is_canonical=*/false);
+  cluster->nodes.WriteUnsigned(length);
+  cluster->element_starts.Add(cluster->elements.length());
+  for (intptr_t i = 0; i < length; i++) {
+    cluster->elements.Add(kNullObject);
+  }
+  return AddObject(cluster);
+}
+
+bool ApiMessageBuilder::SetArrayElement(intptr_t array,
+                                        intptr_t index,
+                                        intptr_t element) {
+  if (array < 0 || array >= objects_.length() || element < 0 ||
+      element >= objects_.length()) {
+    return false;
+  }
+  const ObjectInfo& info = objects_[array];
+  Cluster* cluster = info.cluster;
+  if (cluster == nullptr || cluster->cid != kArrayCid) {
+    return false;
+  }
+  const intptr_t start = cluster->element_starts[info.index];
+  const intptr_t end = info.index + 1 < cluster->element_starts.length()
+                           ? cluster->element_starts[info.index + 1]
+                           : cluster->elements.length();
+  if (index < 0 || index >= end - start) {
+    return false;
+  }
+  cluster->elements[start + index] = element;
+  return true;
+}
+
+intptr_t ApiMessageBuilder::RefOf(intptr_t object) const {
+  const ObjectInfo& info = objects_[object];
+  if (info.cluster == nullptr) {
+    return info.index;
+  }
+  return info.cluster->start_ref + info.index;
+}
+
+std::unique_ptr<Message> ApiMessageBuilder::Finish(
+    intptr_t root,
+    Dart_Port dest_port,
+    Message::Priority priority) {
+  if (root < 0 || root >= objects_.length()) {
+    return nullptr;
+  }
+
+  // References are assigned phase by phase, as ApiMessageSerializer does.
+  constexpr intptr_t kNumPhases =
+      static_cast<intptr_t>(MessagePhase::kNumPhases);
+  intptr_t next_ref = kFirstReference + kApiMessageNumBaseObjects;
+  for (intptr_t phase = 0; phase < kNumPhases; phase++) {
+    for (Cluster* cluster : clusters_) {
+      if (static_cast<intptr_t>(cluster->phase) != phase) continue;
+      cluster->start_ref = next_ref;
+      next_ref += cluster->count;
+    }
+  }
+
+  intptr_t size = 16;
+  for (Cluster* cluster : clusters_) {
+    size += cluster->nodes.bytes_written() + 16;
+  }
+  MallocWriteStream stream(size);
+  MessageFinalizableData* finalizable_data = new MessageFinalizableData();
+  stream.WriteUnsigned(kApiMessageNumBaseObjects);
+  stream.WriteUnsigned(next_ref - kFirstReference);
+  for (intptr_t phase = 0; phase < kNumPhases; phase++) {
+    intptr_t num_clusters = 0;
+    for (Cluster* cluster : clusters_) {
+      if (static_cast<intptr_t>(cluster->phase) != phase) continue;
+      num_clusters++;
+    }
+    stream.WriteUnsigned(num_clusters);
+    for (Cluster* cluster : clusters_) {
+      if (static_cast<intptr_t>(cluster->phase) != phase) continue;
+      stream.WriteUnsigned((static_cast<uint64_t>(cluster->cid) << 1) |
+                           (cluster->is_canonical ? 0x1 : 0x0));
+      stream.WriteUnsigned(cluster->count);
+      stream.WriteBytes(cluster->nodes.buffer(),
+                        cluster->nodes.bytes_written());
+      for (const ApiMessageExternalData& data : cluster->external_data) {
+        if (data.owned) {
+          finalizable_data->PutOwned(data.external_size, data.data,
+                                     data.callback);
+        } else {
+          finalizable_data->Put(data.external_size, data.data, data.peer,
+                                data.callback);
+        }
+      }
+      // The message owns the data from now on.
+      cluster->external_data.Clear();
+    }
+    for (Cluster* cluster : clusters_) {
+      if (static_cast<intptr_t>(cluster->phase) != phase) continue;
+      if (cluster->cid != kArrayCid) continue;
+      for (intptr_t i = 0; i < cluster->count; i++) {
+        const intptr_t start = cluster->element_starts[i];
+        const intptr_t end = i + 1 < cluster->count
+                                 ? cluster->element_starts[i + 1]
+                                 : cluster->elements.length();
+        stream.WriteUnsigned(kApiMessageNullRef);  // TypeArguments
+        for (intptr_t j = start; j < end; j++) {
+          stream.WriteUnsigned(RefOf(cluster->elements[j]));
+        }
+      }
+    }
+  }
+  stream.WriteUnsigned(RefOf(root));
+  Clear();
+
+  finalizable_data->SerializationSucceeded();
+  intptr_t length;
+  uint8_t* buffer = stream.Steal(&length);
+  return Message::New(dest_port, buffer, length, finalizable_data, priority);
+}
+
 ObjectPtr ReadObjectGraphCopyMessage(Thread* thread, PersistentHandle* handle) {
   // msg_array = [
   //     <message>,
@@ -23,6 +23,67 @@ std::unique_ptr<Message> WriteApiMessage(Zone* zone,
                                          Dart_Port dest_port,
                                          Message::Priority priority);
 
+// Writes a message from native code directly in snapshot format, one object
+// at a time, instead of serializing a Dart_CObject graph built beforehand.
+//
+// Objects are identified by the indices the Add methods return. Typed data is
+// handed to the receiver as external typed data, so its contents are never
+// copied after native code has written them.
+class ApiMessageBuilder : public MallocAllocated {
+ public:
+  static constexpr intptr_t kIllegalObject = ILLEGAL_MESSAGE_OBJECT;
+
+  ApiMessageBuilder();
+  ~ApiMessageBuilder();
+
+  intptr_t AddNull() { return kNullObject; }
+  intptr_t AddBool(bool value) { return value ? kTrueObject : kFalseObject; }
+  intptr_t AddInt64(int64_t value);
+  intptr_t AddDouble(double value);
+  intptr_t AddString(const char* utf8, intptr_t length);
+  // Allocates the contents of new typed data for the caller to fill in.
+  intptr_t AddTypedData(Dart_TypedData_Type type,
+                        intptr_t length,
+                        uint8_t** data);
+  intptr_t AddExternalTypedData(Dart_TypedData_Type type,
+                                uint8_t* data,
+                                intptr_t length,
+                                void* peer,
+                                Dart_HandleFinalizer callback);
+  // Adds an array whose elements are null until set.
+  intptr_t AddArray(intptr_t length);
+  bool SetArrayElement(intptr_t array, intptr_t index, intptr_t element);
+
+  // Returns nullptr if [root] is not an object of this builder. Afterwards the
+  // builder holds no objects.
+  std::unique_ptr<Message> Finish(intptr_t root,
+                                  Dart_Port dest_port,
+                                  Message::Priority priority);
+
+ private:
+  class Cluster;
+
+  static constexpr intptr_t kNullObject = 0;
+  static constexpr intptr_t kTrueObject = 1;
+  static constexpr intptr_t kFalseObject = 2;
+
+  struct ObjectInfo {
+    // nullptr for base objects, whose index is their reference.
+    Cluster* cluster;
+    intptr_t index;
+  };
+
+  Cluster* ClusterFor(intptr_t cid, bool is_canonical);
+  intptr_t AddObject(Cluster* cluster);
+  intptr_t RefOf(intptr_t object) const;
+  void Clear();
+
+  MallocGrowableArray<Cluster*> clusters_;
+  MallocGrowableArray<ObjectInfo> objects_;
+
+  DISALLOW_COPY_AND_ASSIGN(ApiMessageBuilder);
+};
+
 ObjectPtr ReadObjectGraphCopyMessage(Thread* thread, PersistentHandle* handle);
 
 ObjectPtr ReadMessage(Thread* thread, Message* message);
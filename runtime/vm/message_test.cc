@@ -140,4 +140,38 @@ TEST_CASE(MessageQueue_Clear) {
   EXPECT(queue.IsEmpty());
 }
 
+TEST_CASE(MessageInbox_PushAndDrain) {
+  MessageInbox inbox;
+  MessageQueue queue;
+  EXPECT(inbox.IsEmpty());
+  EXPECT_EQ(0, inbox.DrainInto(&queue));
+
+  const char* str1 = "msg1";
+  const char* str2 = "msg2";
+  const char* str3 = "msg3";
+
+  // Only the first message finds the inbox empty.
+  EXPECT(inbox.Push(Message::New(1, AllocMsg(str1), strlen(str1) + 1, nullptr,
+                                 Message::kNormalPriority)));
+  EXPECT(!inbox.Push(Message::New(2, AllocMsg(str2), strlen(str2) + 1,
+                                  nullptr, Message::kNormalPriority)));
+  EXPECT(!inbox.IsEmpty());
+
+  // Messages are moved after those already in the queue, in posting order.
+  queue.Enqueue(Message::New(3, AllocMsg(str3), strlen(str3) + 1, nullptr,
+                             Message::kNormalPriority),
+                false);
+  EXPECT_EQ(2, inbox.DrainInto(&queue));
+  EXPECT(inbox.IsEmpty());
+  EXPECT_EQ(3, queue.Length());
+  EXPECT_STREQ(str3, reinterpret_cast<char*>(queue.Dequeue()->snapshot()));
+  EXPECT_STREQ(str1, reinterpret_cast<char*>(queue.Dequeue()->snapshot()));
+  EXPECT_STREQ(str2, reinterpret_cast<char*>(queue.Dequeue()->snapshot()));
+  EXPECT(queue.IsEmpty());
+
+  // The next message finds the inbox empty again.
+  EXPECT(inbox.Push(Message::New(1, AllocMsg(str1), strlen(str1) + 1, nullptr,
+                                 Message::kNormalPriority)));
+}
+
 }  // namespace dart
@@ -7,8 +7,10 @@
 #include "vm/isolate.h"
 #include "vm/json_stream.h"
 #include "vm/log.h"
+#include "vm/message_handler.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
+#include "vm/port.h"
 #include "vm/runtime_entry.h"
 
 namespace dart {
@@ -182,6 +184,31 @@ int64_t MetricHeapUsed::Value() const {
          isolate_group()->heap()->UsedInWords(Heap::kOld) * kWordSize;
 }
 
+int64_t MetricMessagesQueued::Value() const {
+  MessageHandler* handler = isolate()->message_handler();
+  return handler != nullptr ? handler->messages_queued() : 0;
+}
+
+int64_t MetricMessagesEnqueued::Value() const {
+  MessageHandler* handler = isolate()->message_handler();
+  return handler != nullptr ? handler->messages_enqueued() : 0;
+}
+
+int64_t MetricMessagesDropped::Value() const {
+  MessageHandler* handler = isolate()->message_handler();
+  return handler != nullptr ? handler->messages_dropped() : 0;
+}
+
+int64_t MetricMessageAge::Value() const {
+  MessageHandler* handler = isolate()->message_handler();
+  if (handler == nullptr) {
+    return 0;
+  }
+  // Only messages posted to ports with statistics have an enqueue time.
+  PortMap::RequestQueueStatistics(handler);
+  return handler->OldestMessageAge();
+}
+
 int64_t MetricIsolateCount::Value() const {
   return Isolate::IsolateListLength();
 }
@@ -41,14 +41,22 @@ class JSONStream;
   V(MaxMetric, HeapNewUsedMax, "heap.new.used.max", kByte)                     \
   V(MaxMetric, HeapNewCapacityMax, "heap.new.capacity.max", kByte)             \
   V(MetricHeapUsed, HeapGlobalUsed, "heap.global.used", kByte)                 \
-  V(MaxMetric, HeapGlobalUsedMax, "heap.global.used.max", kByte)
+  V(MaxMetric, HeapGlobalUsedMax, "heap.global.used.max", kByte)               \
+  V(Metric, IsolatePoolHits, "isolate.pool.hits", kCounter)                    \
+  V(Metric, IsolatePoolMisses, "isolate.pool.misses", kCounter)
 
 // Metrics for each isolate.
 //
 // All metrics are exposed via vm-service protocol.
 #define ISOLATE_METRIC_LIST(V)                                                 \
   V(Metric, RunnableLatency, "isolate.runnable.latency", kMicrosecond)         \
-  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)
+  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)                  \
+  V(MetricMessagesQueued, MessagesQueued, "isolate.messages.queued", kCounter) \
+  V(MetricMessagesEnqueued, MessagesEnqueued, "isolate.messages.enqueued",     \
+    kCounter)                                                                  \
+  V(MetricMessagesDropped, MessagesDropped, "isolate.messages.dropped",        \
+    kCounter)                                                                  \
+  V(MetricMessageAge, MessageAge, "isolate.messages.age", kMicrosecond)
 
 class Metric {
  public:
@@ -191,6 +199,31 @@ class MetricHeapUsed : public Metric {
   virtual int64_t Value() const;
 };
 
+// The number of normal messages waiting to be handled by the isolate.
+class MetricMessagesQueued : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+// The number of normal messages posted to the isolate. Sample it twice for
+// the rate at which they arrive.
+class MetricMessagesEnqueued : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+// The number of messages discarded because a port's queue was full.
+class MetricMessagesDropped : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+// How long the oldest queued message has been waiting.
+class MetricMessageAge : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_METRICS_H_
@@ -91,6 +91,117 @@ DART_EXPORT bool Dart_PostInteger(Dart_Port port_id, int64_t message) {
   return PostCObjectHelper(port_id, &cobj);
 }
 
+DART_EXPORT bool Dart_SetPortQueueLimit(Dart_Port port_id,
+                                        intptr_t limit,
+                                        Dart_PortQueuePolicy policy) {
+  if (limit < 0) {
+    return false;
+  }
+  PortQueueState::Policy queue_policy;
+  switch (policy) {
+    case Dart_PortQueuePolicy_kBlock:
+      queue_policy = PortQueueState::kBlock;
+      break;
+    case Dart_PortQueuePolicy_kDrop:
+      queue_policy = PortQueueState::kDrop;
+      break;
+    case Dart_PortQueuePolicy_kNotify:
+      queue_policy = PortQueueState::kNotify;
+      break;
+    default:
+      return false;
+  }
+  return PortMap::SetQueueLimit(port_id, limit, queue_policy);
+}
+
+static ApiMessageBuilder* MessageBuilder(Dart_MessageBuilder builder) {
+  RELEASE_ASSERT(builder != nullptr);
+  return reinterpret_cast<ApiMessageBuilder*>(builder);
+}
+
+DART_EXPORT Dart_MessageBuilder Dart_NewMessageBuilder() {
+  return reinterpret_cast<Dart_MessageBuilder>(new ApiMessageBuilder());
+}
+
+DART_EXPORT void Dart_DeleteMessageBuilder(Dart_MessageBuilder builder) {
+  delete MessageBuilder(builder);
+}
+
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddNull(Dart_MessageBuilder builder) {
+  return MessageBuilder(builder)->AddNull();
+}
+
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddBool(Dart_MessageBuilder builder, bool value) {
+  return MessageBuilder(builder)->AddBool(value);
+}
+
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddInt64(Dart_MessageBuilder builder, int64_t value) {
+  return MessageBuilder(builder)->AddInt64(value);
+}
+
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddDouble(Dart_MessageBuilder builder, double value) {
+  return MessageBuilder(builder)->AddDouble(value);
+}
+
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddString(Dart_MessageBuilder builder,
+                             const char* utf8,
+                             intptr_t length) {
+  return MessageBuilder(builder)->AddString(utf8, length);
+}
+
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddTypedData(Dart_MessageBuilder builder,
+                                Dart_TypedData_Type type,
+                                intptr_t length,
+                                uint8_t** data) {
+  if (data == nullptr) {
+    return ILLEGAL_MESSAGE_OBJECT;
+  }
+  return MessageBuilder(builder)->AddTypedData(type, length, data);
+}
+
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddExternalTypedData(Dart_MessageBuilder builder,
+                                        Dart_TypedData_Type type,
+                                        uint8_t* data,
+                                        intptr_t length,
+                                        void* peer,
+                                        Dart_HandleFinalizer callback) {
+  return MessageBuilder(builder)->AddExternalTypedData(type, data, length,
+                                                       peer, callback);
+}
+
+DART_EXPORT Dart_MessageObject
+Dart_MessageBuilderAddArray(Dart_MessageBuilder builder, intptr_t length) {
+  return MessageBuilder(builder)->AddArray(length);
+}
+
+DART_EXPORT bool Dart_MessageBuilderSetArrayElement(
+    Dart_MessageBuilder builder,
+    Dart_MessageObject array,
+    intptr_t index,
+    Dart_MessageObject element) {
+  return MessageBuilder(builder)->SetArrayElement(array, index, element);
+}
+
+DART_EXPORT bool Dart_PostMessageBuilder(Dart_Port port_id,
+                                         Dart_MessageBuilder builder,
+                                         Dart_MessageObject root) {
+  ApiMessageBuilder* message_builder = MessageBuilder(builder);
+  std::unique_ptr<Message> msg =
+      message_builder->Finish(root, port_id, Message::kNormalPriority);
+  delete message_builder;
+  if (msg == nullptr) {
+    return false;
+  }
+  return PortMap::PostMessage(std::move(msg));
+}
+
 DART_EXPORT Dart_Port Dart_NewNativePort(const char* name,
                                          Dart_NativeMessageHandler handler,
                                          bool handle_concurrently) {
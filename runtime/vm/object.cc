@@ -7552,6 +7552,45 @@ TypeArguments::Cache::KeyLocation TypeArguments::Cache::FindKeyOrUnused(
   return {probe, false};
 }
 
+bool TypeArguments::Cache::LookupUnlocked(const Array& array,
+                                          const TypeArguments& instantiator_tav,
+                                          const TypeArguments& function_tav,
+                                          TypeArguments* result) {
+  ASSERT(result != nullptr);
+  // The backing array of a cache is never mutated once published except for
+  // filling in unoccupied entries, so it is safe to probe without the mutex as
+  // long as the sentinel position is read with load-acquire semantics.
+  const bool is_hash = IsHash(array);
+  InstantiationsCacheTable table(array);
+  const intptr_t num_entries = table.Length();
+  intptr_t probe = 0;
+  intptr_t probe_distance = 1;
+  if (is_hash) {
+    auto hash = FinalizeHash(
+        CombineHashes(instantiator_tav.Hash(), function_tav.Hash()));
+    probe = hash & (num_entries - 1);
+  }
+  // Both linear and hash-based caches always contain an unoccupied entry, so
+  // this loop is guaranteed to terminate.
+  for (intptr_t i = 0; i < num_entries; i++) {
+    const auto& tuple = table.At(probe);
+    const ObjectPtr key =
+        tuple.Get<kSentinelIndex, std::memory_order_acquire>();
+    if (key == Sentinel()) return false;
+    if ((key == instantiator_tav.ptr()) &&
+        (tuple.Get<kFunctionTypeArgsIndex>() == function_tav.ptr())) {
+      *result = tuple.Get<kInstantiatedTypeArgsIndex>();
+      return true;
+    }
+    probe = probe + probe_distance;
+    if (is_hash) {
+      probe = probe & (num_entries - 1);
+      probe_distance++;
+    }
+  }
+  return false;
+}
+
 TypeArguments::Cache::KeyLocation TypeArguments::Cache::AddEntry(
     intptr_t entry,
     const TypeArguments& instantiator_tav,
@@ -8063,14 +8102,32 @@ TypeArgumentsPtr TypeArguments::InstantiateAndCanonicalizeFrom(
     const TypeArguments& function_type_arguments) const {
   auto thread = Thread::Current();
   auto zone = thread->zone();
-  SafepointMutexLocker ml(
-      thread->isolate_group()->type_arguments_canonicalization_mutex());
 
   ASSERT(!IsInstantiated());
   ASSERT(instantiator_type_arguments.IsNull() ||
          instantiator_type_arguments.IsCanonical());
   ASSERT(function_type_arguments.IsNull() ||
          function_type_arguments.IsCanonical());
+  TypeArguments& result = TypeArguments::Handle(zone);
+#if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
+  const bool check_for_stub_misses =
+      TESTING_runtime_fail_on_existing_cache_entry;
+#else
+  const bool check_for_stub_misses = false;
+#endif
+  // Callers that do not probe the cache in generated code (e.g., runtime
+  // entries, hash-based caches on IA32) usually hit an existing entry, so
+  // avoid contending on the canonicalization mutex in that case.
+  if (!check_for_stub_misses) {
+    const Array& prior_instantiations = Array::Handle(zone, instantiations());
+    if (Cache::LookupUnlocked(prior_instantiations, instantiator_type_arguments,
+                              function_type_arguments, &result)) {
+      return result.ptr();
+    }
+  }
+
+  SafepointMutexLocker ml(
+      thread->isolate_group()->type_arguments_canonicalization_mutex());
   // Lookup instantiators and if found, return instantiated result.
   Cache cache(zone, *this);
   auto const loc = cache.FindKeyOrUnused(instantiator_type_arguments,
@@ -8100,7 +8157,6 @@ TypeArgumentsPtr TypeArguments::InstantiateAndCanonicalizeFrom(
     return cache.Retrieve(loc.entry);
   }
   // Cache lookup failed. Instantiate the type arguments.
-  TypeArguments& result = TypeArguments::Handle(zone);
   result = InstantiateFrom(instantiator_type_arguments, function_type_arguments,
                            kAllFree, Heap::kOld);
   // Canonicalize type arguments.
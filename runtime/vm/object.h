@@ -8960,6 +8960,20 @@ class TypeArguments : public Instance {
       return FindKeyOrUnused(data_, instantiator_tav, function_tav);
     }
 
+    // Looks up the instantiation for the given instantiator and function type
+    // arguments in the cache backed by [array] without holding the type
+    // arguments canonicalization mutex. Entries are probed with the same
+    // acquire semantics as in the InstantiateTypeArguments stubs, so a
+    // concurrently added entry may be missed, but a partially initialized one
+    // is never returned.
+    //
+    // Returns whether an entry was found, in which case [result] is set to the
+    // instantiated type arguments.
+    static bool LookupUnlocked(const Array& array,
+                               const TypeArguments& instantiator_tav,
+                               const TypeArguments& function_tav,
+                               TypeArguments* result);
+
     // Returns whether the entry at the given index in the cache is occupied.
     bool IsOccupied(intptr_t entry) const;
 
@@ -10711,9 +10725,11 @@ class OneByteString : public AllStatic {
 
   ALLSTATIC_CONTAINS_COMPRESSED_IMPLEMENTATION(OneByteString, String);
 
+  friend class BytecodeRegExpMacroAssembler;
   friend class Class;
   friend class FlowGraphSerializer;
   friend class ImageWriter;
+  friend class RegExpNfa;
   friend class String;
   friend class StringHasher;
   friend class Symbols;
@@ -10834,9 +10850,11 @@ class TwoByteString : public AllStatic {
 
   ALLSTATIC_CONTAINS_COMPRESSED_IMPLEMENTATION(TwoByteString, String);
 
+  friend class BytecodeRegExpMacroAssembler;
   friend class Class;
   friend class FlowGraphSerializer;
   friend class ImageWriter;
+  friend class RegExpNfa;
   friend class String;
   friend class StringHasher;
   friend class Symbols;
@@ -12824,10 +12842,12 @@ class RegExp : public Instance {
   // kUninitialized: the type of th regexp has not been initialized yet.
   // kSimple: A simple pattern to match against, using string indexOf operation.
   // kComplex: A complex pattern to match.
+  // kLinear: A complex pattern matched by simulating its NFA, see RegExpNfa.
   enum RegExType {
     kUninitialized = 0,
     kSimple = 1,
     kComplex = 2,
+    kLinear = 3,
   };
 
   using TypeBits = BitField<int8_t, RegExType, 0, 2>;
@@ -12849,6 +12869,7 @@ class RegExp : public Instance {
   bool is_initialized() const { return (type() != kUninitialized); }
   bool is_simple() const { return (type() == kSimple); }
   bool is_complex() const { return (type() == kComplex); }
+  bool is_linear() const { return (type() == kLinear); }
 
   intptr_t num_registers(bool is_one_byte) const {
     return LoadNonPointer<intptr_t, std::memory_order_relaxed>(
@@ -12943,6 +12964,7 @@ class RegExp : public Instance {
   }
   void set_is_simple() const { set_type(kSimple); }
   void set_is_complex() const { set_type(kComplex); }
+  void set_is_linear() const { set_type(kLinear); }
   void set_num_registers(bool is_one_byte, intptr_t value) const {
     StoreNonPointer<intptr_t, intptr_t, std::memory_order_relaxed>(
         is_one_byte ? &untag()->num_one_byte_registers_
@@ -6,14 +6,20 @@
 
 #include <memory>
 
+#include "platform/atomic.h"
+#include "vm/dart.h"
 #include "vm/dart_api_state.h"
 #include "vm/flags.h"
 #include "vm/heap/weak_table.h"
+#include "vm/lockers.h"
 #include "vm/longjump.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
+#include "vm/os.h"
+#include "vm/shared_typed_data.h"
 #include "vm/snapshot.h"
 #include "vm/symbols.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 
 #define Z zone_
@@ -102,6 +108,10 @@ DEFINE_FLAG(bool,
             gc_on_foc_slow_path,
             false,
             "Cause a GC when falling off the fast path for fast object copy.");
+DEFINE_FLAG(bool,
+            parallel_typed_data_copy,
+            true,
+            "Copy the contents of large typed data on several threads.");
 
 const char* kFastAllocationFailed = "fast allocation failed";
 
@@ -299,16 +309,131 @@ void UpdateLengthField(intptr_t cid, ObjectPtr from, ObjectPtr to) {
   }
 }
 
+// Copies the contents of large typed data on the calling thread together with
+// tasks on the VM thread pool, each taking chunks until none are left.
+//
+// The tasks only touch the two buffers, so the caller must make sure they do
+// not move until Copy() returns, i.e. it must not check into a safepoint.
+class ParallelMemmove {
+ public:
+  static constexpr intptr_t kChunkSize = 512 * KB;
+  // Smaller copies are not worth waking up other threads for.
+  static constexpr intptr_t kMinimumLength = 4 * MB;
+  static constexpr intptr_t kMaxTasks = 8;
+
+  static void Copy(uint8_t* to, const uint8_t* from, intptr_t length) {
+    const intptr_t num_chunks = Utils::RoundUp(length, kChunkSize) / kChunkSize;
+    const intptr_t num_tasks = Utils::Minimum<intptr_t>(
+        Utils::Minimum<intptr_t>(num_chunks, kMaxTasks),
+        OS::NumberOfAvailableProcessors()) - 1;
+    if (!FLAG_parallel_typed_data_copy || length < kMinimumLength ||
+        num_tasks <= 0) {
+      memmove(to, from, length);
+      return;
+    }
+
+    // Tasks that start late may outlive this call, so they share ownership of
+    // the copy with the calling thread.
+    auto copy = new ParallelMemmove(to, from, length, num_chunks,
+                                    /*ref_count=*/num_tasks + 1);
+    for (intptr_t i = 0; i < num_tasks; i++) {
+      if (!Dart::thread_pool()->Run<ParallelMemmoveTask>(copy)) {
+        copy->Release();
+      }
+    }
+    copy->CopyChunks();
+    copy->WaitForChunks();
+    copy->Release();
+  }
+
+ private:
+  class ParallelMemmoveTask : public ThreadPool::Task {
+   public:
+    explicit ParallelMemmoveTask(ParallelMemmove* copy) : copy_(copy) {}
+
+    virtual void Run() {
+      copy_->CopyChunks();
+      copy_->Release();
+    }
+
+   private:
+    ParallelMemmove* copy_;
+
+    DISALLOW_COPY_AND_ASSIGN(ParallelMemmoveTask);
+  };
+
+  ParallelMemmove(uint8_t* to,
+                  const uint8_t* from,
+                  intptr_t length,
+                  intptr_t num_chunks,
+                  intptr_t ref_count)
+      : to_(to),
+        from_(from),
+        length_(length),
+        num_chunks_(num_chunks),
+        next_chunk_(0),
+        copied_chunks_(0),
+        ref_count_(ref_count) {}
+
+  void CopyChunks() {
+    while (true) {
+      const intptr_t chunk = next_chunk_.fetch_add(1);
+      if (chunk >= num_chunks_) return;
+      const intptr_t offset = chunk * kChunkSize;
+      memmove(to_ + offset, from_ + offset,
+              Utils::Minimum(kChunkSize, length_ - offset));
+      if (copied_chunks_.fetch_add(1) + 1 == num_chunks_) {
+        MonitorLocker ml(&monitor_);
+        ml.Notify();
+      }
+    }
+  }
+
+  void WaitForChunks() {
+    MonitorLocker ml(&monitor_);
+    while (copied_chunks_.load() < num_chunks_) {
+      ml.Wait();
+    }
+  }
+
+  void Release() {
+    if (ref_count_.fetch_sub(1) == 1) {
+      delete this;
+    }
+  }
+
+  uint8_t* const to_;
+  const uint8_t* const from_;
+  const intptr_t length_;
+  const intptr_t num_chunks_;
+  RelaxedAtomic<intptr_t> next_chunk_;
+  AcqRelAtomic<intptr_t> copied_chunks_;
+  AcqRelAtomic<intptr_t> ref_count_;
+  Monitor monitor_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelMemmove);
+};
+
 void InitializeExternalTypedData(intptr_t cid,
                                  ExternalTypedDataPtr from,
                                  ExternalTypedDataPtr to) {
   auto raw_from = from.untag();
   auto raw_to = to.untag();
+  // Shared backing stores are referenced instead of copied.
+  SharedTypedDataStore* store = SharedTypedDataStore::Of(from);
+  if (store != nullptr) {
+    store->Retain();
+    raw_to->length_ = raw_from->length_;
+    raw_to->data_ = raw_from->data_;
+    SharedTypedDataStore::Attach(to, store);
+    return;
+  }
+
   const intptr_t length =
       TypedData::ElementSizeInBytes(cid) * Smi::Value(raw_from->length_);
 
   auto buffer = static_cast<uint8_t*>(malloc(length));
-  memmove(buffer, raw_from->data_, length);
+  ParallelMemmove::Copy(buffer, raw_from->data_, length);
   raw_to->length_ = raw_from->length_;
   raw_to->data_ = buffer;
 }
@@ -318,22 +443,27 @@ void CopyTypedDataBaseWithSafepointChecks(Thread* thread,
                                           const T& from,
                                           const T& to,
                                           intptr_t length) {
-  constexpr intptr_t kChunkSize = 100 * 1024;
+  // Large contents are copied on several threads, which get through more
+  // bytes in the same time between safepoint checks.
+  const intptr_t chunk_size = length >= ParallelMemmove::kMinimumLength
+                                  ? ParallelMemmove::kMinimumLength
+                                  : 100 * 1024;
 
-  const intptr_t chunks = length / kChunkSize;
-  const intptr_t remainder = length % kChunkSize;
+  const intptr_t chunks = length / chunk_size;
+  const intptr_t remainder = length % chunk_size;
 
   // Notice we re-load the data pointer, since T may be TypedData in which case
   // the interior pointer may change after checking into safepoints.
   for (intptr_t i = 0; i < chunks; ++i) {
-    memmove(to.ptr().untag()->data_ + i * kChunkSize,
-            from.ptr().untag()->data_ + i * kChunkSize, kChunkSize);
+    ParallelMemmove::Copy(to.ptr().untag()->data_ + i * chunk_size,
+                          from.ptr().untag()->data_ + i * chunk_size,
+                          chunk_size);
 
     thread->CheckForSafepoint();
   }
   if (remainder > 0) {
-    memmove(to.ptr().untag()->data_ + chunks * kChunkSize,
-            from.ptr().untag()->data_ + chunks * kChunkSize, remainder);
+    memmove(to.ptr().untag()->data_ + chunks * chunk_size,
+            from.ptr().untag()->data_ + chunks * chunk_size, remainder);
   }
 }
 
@@ -343,6 +473,14 @@ void InitializeExternalTypedDataWithSafepointChecks(
     const ExternalTypedData& from,
     const ExternalTypedData& to) {
   const intptr_t length_in_elements = from.Length();
+  SharedTypedDataStore* store = SharedTypedDataStore::Of(from.ptr());
+  if (store != nullptr) {
+    store->Retain();
+    to.ptr().untag()->data_ = from.ptr().untag()->data_;
+    to.ptr().untag()->length_ = Smi::New(length_in_elements);
+    SharedTypedDataStore::Attach(to.ptr(), store);
+    return;
+  }
   const intptr_t length_in_bytes =
       TypedData::ElementSizeInBytes(cid) * length_in_elements;
 
@@ -611,6 +749,13 @@ class ForwardMapBase {
   }
 
   void FinalizeExternalTypedData(const ExternalTypedData& to) {
+    // Drops the reference taken when a shared store was sent.
+    SharedTypedDataStore* store = SharedTypedDataStore::Of(to.ptr());
+    if (store != nullptr) {
+      to.AddFinalizer(store, &SharedTypedDataStore::Finalizer,
+                      to.LengthInBytes());
+      return;
+    }
     to.AddFinalizer(to.DataAddr(0), &FreeExternalTypedData, to.LengthInBytes());
   }
 
@@ -1971,7 +2116,7 @@ class ObjectCopy : public Base {
     raw_to->RecomputeDataField();
     const intptr_t length =
         TypedData::ElementSizeInBytes(cid) * Smi::Value(raw_from->length_);
-    memmove(raw_to->data_, raw_from->data_, length);
+    ParallelMemmove::Copy(raw_to->data_, raw_from->data_, length);
   }
 
   void CopyTypedData(const TypedData& from, const TypedData& to) {
@@ -13,12 +13,84 @@
 #include "vm/isolate.h"
 #include "vm/lockers.h"
 #include "vm/message_handler.h"
+#include "vm/os.h"
 #include "vm/os_thread.h"
 
 namespace dart {
 
+void PortQueueState::MessageEnqueued(Message* message, int64_t now) {
+  depth_.fetch_add(1, std::memory_order_relaxed);
+  enqueued_++;
+  if (now - rate_window_start_ >= kMicrosecondsPerSecond) {
+    enqueue_rate_ = EnqueueRate(now);
+    rate_window_start_ = now;
+    rate_window_count_ = 0;
+  }
+  rate_window_count_++;
+  Retain();
+  message->set_port_state(this);
+  message->set_enqueue_time(now);
+}
+
+int64_t PortQueueState::EnqueueRate(int64_t now) const {
+  const int64_t elapsed = now - rate_window_start_;
+  if (elapsed < kMicrosecondsPerSecond) {
+    return enqueue_rate_;
+  }
+  // The current window is over, so it holds all messages since it started, no
+  // matter how long ago that was.
+  return rate_window_start_ == 0
+             ? 0
+             : rate_window_count_ * kMicrosecondsPerSecond / elapsed;
+}
+
+void PortQueueState::MessageDequeued() {
+  // Either a waiting poster sees the new depth, or we see the poster and
+  // wake it up, see [WaitForSpaceBlocked].
+  depth_.fetch_sub(1);
+  if (waiters_.load() > 0) {
+    NotifyWaiters();
+  }
+}
+
+void PortQueueState::WaitForSpace() {
+  // Waiting threads must not hold up safepoint operations, and must not enter
+  // one while holding [space_monitor_], which the receiver takes to wake them.
+  Thread* thread = Thread::Current();
+  if (thread != nullptr && thread->execution_state() == Thread::kThreadInVM) {
+    TransitionVMToBlocked transition(thread);
+    WaitForSpaceBlocked();
+  } else {
+    WaitForSpaceBlocked();
+  }
+}
+
+void PortQueueState::WaitForSpaceBlocked() {
+  MonitorLocker ml(&space_monitor_);
+  // Registering as a waiter and then checking the depth is sequentially
+  // consistent with the receiver updating the depth and then checking for
+  // waiters, see [MessageDequeued].
+  waiters_++;
+  while (IsFull() && !closed_.load()) {
+    ml.Wait();
+  }
+  waiters_--;
+}
+
+void PortQueueState::Close() {
+  closed_ = true;
+  if (waiters_.load() > 0) {
+    NotifyWaiters();
+  }
+}
+
+void PortQueueState::NotifyWaiters() {
+  MonitorLocker ml(&space_monitor_);
+  ml.NotifyAll();
+}
+
 Mutex* PortMap::mutex_ = nullptr;
-PortSet<PortMap::Entry>* PortMap::ports_ = nullptr;
+PortMap::Shard* PortMap::shards_ = nullptr;
 Random* PortMap::prng_ = nullptr;
 
 Dart_Port PortMap::AllocatePort() {
@@ -27,7 +99,8 @@ Dart_Port PortMap::AllocatePort() {
   ASSERT(mutex_->IsOwnedByCurrentThread());
 
   // Keep getting new values while we have an illegal port number or the port
-  // number is already in use.
+  // number is already in use. Ports are only added and removed with [mutex_]
+  // held, so the shards can be searched without holding their locks.
   do {
     // Ensure port ids are never valid object pointers so that reinterpreting
     // an object pointer as a port id never produces a used port id.
@@ -45,17 +118,27 @@ Dart_Port PortMap::AllocatePort() {
     }
 
     ASSERT(!static_cast<ObjectPtr>(static_cast<uword>(result))->IsWellFormed());
-  } while (ports_->Contains(result));
+  } while (ShardFor(result)->ports->Contains(result));
 
   ASSERT(result != 0);
-  ASSERT(!ports_->Contains(result));
   return result;
 }
 
+PortMap::Shard* PortMap::ShardFor(Dart_Port port) {
+  if (shards_ == nullptr) {
+    // Like after [Cleanup], the shard has no port set.
+    static Shard* const empty_shard = new Shard();
+    return empty_shard;
+  }
+  // Port ids are random. The low bits select the slot within the shard's
+  // [PortSet], so use high bits to select the shard.
+  return &shards_[(static_cast<uint64_t>(port) >> 32) & (kShardCount - 1)];
+}
+
 Dart_Port PortMap::CreatePort(PortHandler* handler) {
   ASSERT(handler != nullptr);
   PortMap::Locker ml;
-  if (ports_ == nullptr) {
+  if (shards_ == nullptr || shards_[0].ports == nullptr) {
     return ILLEGAL_PORT;
   }
 
@@ -63,7 +146,10 @@ Dart_Port PortMap::CreatePort(PortHandler* handler) {
   if (auto ports = handler->ports(ml)) {
     ports->Insert(PortHandler::PortSetEntry{port});
   }
-  ports_->Insert(Entry{port, handler});
+  {
+    MutexLocker shard_locker(&ShardFor(port)->mutex);
+    ShardFor(port)->ports->Insert(Entry{port, handler});
+  }
 
   if (FLAG_trace_isolates) {
     OS::PrintErr(
@@ -82,23 +168,28 @@ bool PortMap::ClosePort(Dart_Port port, PortHandler** port_handler) {
   PortHandler* handler = nullptr;
   {
     PortMap::Locker ml;
-    if (ports_ == nullptr) {
-      return false;
-    }
-    auto it = ports_->TryLookup(port);
-    if (it == ports_->end()) {
-      return false;
-    }
-    Entry entry = *it;
-    handler = entry.handler;
-    ASSERT(handler != nullptr);
+    Shard* shard = ShardFor(port);
+    {
+      MutexLocker shard_locker(&shard->mutex);
+      if (shard->ports == nullptr) {
+        return false;
+      }
+      auto it = shard->ports->TryLookup(port);
+      if (it == shard->ports->end()) {
+        return false;
+      }
+      Entry entry = *it;
+      handler = entry.handler;
+      ASSERT(handler != nullptr);
 
 #if defined(DEBUG)
-    handler->CheckAccess();
+      handler->CheckAccess();
 #endif
 
-    it.Delete();
-    ports_->Rebalance();
+      it.Delete();
+      shard->ports->Rebalance();
+      ReleaseQueueState(entry);
+    }
 
     if (auto ports = handler->ports(ml)) {
       auto isolate_it = ports->TryLookup(port);
@@ -115,7 +206,7 @@ bool PortMap::ClosePort(Dart_Port port, PortHandler** port_handler) {
 void PortMap::ClosePorts(MessageHandler* handler) {
   {
     PortMap::Locker ml;
-    if (ports_ == nullptr) {
+    if (shards_ == nullptr || shards_[0].ports == nullptr) {
       return;
     }
 
@@ -124,60 +215,166 @@ void PortMap::ClosePorts(MessageHandler* handler) {
 
     for (auto isolate_it = ports->begin(); isolate_it != ports->end();
          ++isolate_it) {
-      auto it = ports_->TryLookup((*isolate_it).port);
-      ASSERT(it != ports_->end());
+      Shard* shard = ShardFor((*isolate_it).port);
+      MutexLocker shard_locker(&shard->mutex);
+      auto it = shard->ports->TryLookup((*isolate_it).port);
+      ASSERT(it != shard->ports->end());
       Entry entry = *it;
       ASSERT(entry.port == (*isolate_it).port);
       ASSERT(entry.handler == handler);
       it.Delete();
+      shard->ports->Rebalance();
+      ReleaseQueueState(entry);
       isolate_it.Delete();
     }
     ASSERT(ports->IsEmpty());
-    ports_->Rebalance();
   }
   handler->OnAllPortsClosed();
 }
 
 bool PortMap::PostMessage(std::unique_ptr<Message> message,
-                          bool before_events) {
-  Locker ml;
-  if (ports_ == nullptr) {
+                          bool before_events,
+                          bool* queue_full) {
+  Shard* shard = ShardFor(message->dest_port());
+  MutexLocker ml(&shard->mutex);
+  while (true) {
+    if (shard->ports == nullptr) {
+      return false;
+    }
+    auto it = shard->ports->TryLookup(message->dest_port());
+    if (it == shard->ports->end()) {
+      // Ownership of external data remains with the poster.
+      message->DropFinalizers();
+      return false;
+    }
+    Entry& entry = *it;
+    auto handler = entry.handler;
+    ASSERT(handler != nullptr);
+    // Control messages are never held back. Queues are only accounted for
+    // on ports with a limit or whose statistics were requested.
+    PortQueueState* state = entry.queue_state;
+    if (message->IsOOB() || before_events || state == nullptr) {
+      handler->PostMessage(std::move(message), before_events);
+      return true;
+    }
+    if (state->IsFull()) {
+      switch (state->policy_) {
+        case PortQueueState::kBlock: {
+          // The receiver cannot make space while it waits for itself.
+          Isolate* isolate = handler->isolate();
+          if (isolate != nullptr && isolate == Isolate::Current()) {
+            break;
+          }
+          // The port might be closed while waiting, look it up again after.
+          state->Retain();
+          {
+            MutexUnlocker unlocker(&ml);
+            state->WaitForSpace();
+          }
+          state->Release();
+          continue;
+        }
+        case PortQueueState::kDrop: {
+          state->dropped_++;
+          handler->OnMessageDropped();
+          // Finalizers run as if the message was delivered and collected.
+          MutexUnlocker unlocker(&ml);
+          message.reset();
+          return true;
+        }
+        case PortQueueState::kNotify:
+          state->dropped_++;
+          handler->OnMessageDropped();
+          message->DropFinalizers();
+          if (queue_full != nullptr) {
+            *queue_full = true;
+          }
+          return false;
+      }
+    }
+    state->MessageEnqueued(message.get(), OS::GetCurrentMonotonicMicros());
+    handler->PostMessage(std::move(message), before_events);
+    return true;
+  }
+}
+
+bool PortMap::SetQueueLimit(Dart_Port id,
+                            intptr_t limit,
+                            PortQueueState::Policy policy) {
+  ASSERT(limit >= 0);
+  Shard* shard = ShardFor(id);
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(message->dest_port());
-  if (it == ports_->end()) {
-    // Ownership of external data remains with the poster.
-    message->DropFinalizers();
+  auto it = shard->ports->TryLookup(id);
+  if (it == shard->ports->end()) {
     return false;
   }
-  auto handler = (*it).handler;
-  ASSERT(handler != nullptr);
-  handler->PostMessage(std::move(message), before_events);
+  PortQueueState* state = QueueStateLocked(&*it);
+  state->limit_ = limit;
+  state->policy_ = policy;
+  // Posters waiting for space might be let through now.
+  state->NotifyWaiters();
   return true;
 }
 
+void PortMap::RequestQueueStatistics(MessageHandler* handler) {
+  PortMap::Locker ml;
+  if (shards_ == nullptr || shards_[0].ports == nullptr) {
+    return;
+  }
+  auto ports = handler->ports(ml);
+  if (ports == nullptr) {
+    return;
+  }
+  for (auto& isolate_entry : *ports) {
+    Shard* shard = ShardFor(isolate_entry.port);
+    MutexLocker shard_locker(&shard->mutex);
+    auto it = shard->ports->TryLookup(isolate_entry.port);
+    ASSERT(it != shard->ports->end());
+    QueueStateLocked(&*it);
+  }
+}
+
+PortQueueState* PortMap::QueueStateLocked(Entry* entry) {
+  if (entry->queue_state == nullptr) {
+    entry->queue_state = new PortQueueState();
+  }
+  return entry->queue_state;
+}
+
+void PortMap::ReleaseQueueState(const Entry& entry) {
+  if (entry.queue_state != nullptr) {
+    entry.queue_state->Close();
+    entry.queue_state->Release();
+  }
+}
+
 #if defined(TESTING)
 bool PortMap::PortExists(Dart_Port id) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(id);
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(id);
-  return it != ports_->end();
+  auto it = shard->ports->TryLookup(id);
+  return it != shard->ports->end();
 }
 
 Isolate* PortMap::GetIsolate(Dart_Port id) {
-  Locker ml;
+  ShardLocker ml(id);
   return GetIsolateLocked(ml, id);
 }
 #endif  // defined(TESTING)
 
-Isolate* PortMap::GetIsolateLocked(const Locker& ml, Dart_Port id) {
-  if (ports_ == nullptr) {
+Isolate* PortMap::GetIsolateLocked(const ShardLocker& ml, Dart_Port id) {
+  Shard* shard = ShardFor(id);
+  if (shard->ports == nullptr) {
     return nullptr;
   }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  auto it = shard->ports->TryLookup(id);
+  if (it == shard->ports->end()) {
     // Port does not exist.
     return nullptr;
   }
@@ -187,12 +384,13 @@ Isolate* PortMap::GetIsolateLocked(const Locker& ml, Dart_Port id) {
 }
 
 Dart_Port PortMap::GetOriginId(Dart_Port id) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(id);
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     return ILLEGAL_PORT;
   }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  auto it = shard->ports->TryLookup(id);
+  if (it == shard->ports->end()) {
     // Port does not exist.
     return ILLEGAL_PORT;
   }
@@ -207,7 +405,7 @@ Dart_Port PortMap::GetOriginId(Dart_Port id) {
 }
 
 bool PortMap::IsOwnedByCurrentThread(Dart_Port id) {
-  Locker ml;
+  ShardLocker ml(id);
   Isolate* isolate = GetIsolateLocked(ml, id);
   if (isolate == nullptr) {
     // Either the port is invalid, or the isolate has already shut down.
@@ -219,7 +417,7 @@ bool PortMap::IsOwnedByCurrentThread(Dart_Port id) {
 #if defined(TESTING)
 bool PortMap::HasPorts(MessageHandler* handler) {
   Locker ml;
-  if (ports_ == nullptr) {
+  if (shards_ == nullptr || shards_[0].ports == nullptr) {
     return false;
   }
   // The MessageHandler::ports_ is only accessed by [PortMap], it is guarded
@@ -230,13 +428,14 @@ bool PortMap::HasPorts(MessageHandler* handler) {
 
 bool PortMap::IsReceiverInThisIsolateGroupOrClosed(Dart_Port receiver,
                                                    IsolateGroup* group) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(receiver);
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     // Port was closed.
     return true;
   }
-  auto it = ports_->TryLookup(receiver);
-  if (it == ports_->end()) {
+  auto it = shard->ports->TryLookup(receiver);
+  if (it == shard->ports->end()) {
     // Port was closed.
     return true;
   }
@@ -256,35 +455,52 @@ void PortMap::Init() {
   if (prng_ == nullptr) {
     prng_ = new Random();
   }
-  if (ports_ == nullptr) {
-    ports_ = new PortSet<Entry>();
+  // The shards and their locks are never freed, so that looking up a port
+  // after [Cleanup] finds no port set instead of a dangling lock.
+  if (shards_ == nullptr) {
+    shards_ = new Shard[kShardCount];
+  }
+  for (intptr_t i = 0; i < kShardCount; i++) {
+    if (shards_[i].ports == nullptr) {
+      shards_[i].ports = new PortSet<Entry>();
+    }
   }
 }
 
 void PortMap::Shutdown() {
   // Tell all handlers which are running their own thread pools to shutdown.
-  for (auto& entry : *ports_) {
-    entry.handler->Shutdown();
+  for (intptr_t i = 0; i < kShardCount; i++) {
+    for (auto& entry : *shards_[i].ports) {
+      entry.handler->Shutdown();
+    }
   }
 }
 
 void PortMap::Cleanup() {
-  ASSERT(ports_ != nullptr);
+  ASSERT(shards_ != nullptr);
   ASSERT(prng_ != nullptr);
-  for (auto it = ports_->begin(); it != ports_->end(); ++it) {
-    const auto& entry = *it;
-    ASSERT(entry.handler != nullptr);
-    delete entry.handler;
-    it.Delete();
+  for (intptr_t i = 0; i < kShardCount; i++) {
+    PortSet<Entry>* ports = shards_[i].ports;
+    ASSERT(ports != nullptr);
+    for (auto it = ports->begin(); it != ports->end(); ++it) {
+      const auto& entry = *it;
+      ASSERT(entry.handler != nullptr);
+      delete entry.handler;
+      ReleaseQueueState(entry);
+      it.Delete();
+    }
+    ports->Rebalance();
   }
-  ports_->Rebalance();
 
-  // Grab the mutex and delete the port set.
+  // Grab the mutexes and delete the port sets.
   Locker ml;
   delete prng_;
   prng_ = nullptr;
-  delete ports_;
-  ports_ = nullptr;
+  for (intptr_t i = 0; i < kShardCount; i++) {
+    MutexLocker shard_locker(&shards_[i].mutex);
+    delete shards_[i].ports;
+    shards_[i].ports = nullptr;
+  }
 }
 
 void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
@@ -295,34 +511,81 @@ void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
   Object& msg_handler = Object::Handle();
   {
     JSONArray ports(&jsobj, "ports");
-    SafepointMutexLocker ml(mutex_);
-    if (ports_ == nullptr) {
+    if (shards_ == nullptr) {
       return;
     }
-    for (auto& entry : *ports_) {
-      if (entry.handler == handler) {
-        JSONObject port(&ports);
-        port.AddProperty("type", "_Port");
-        port.AddPropertyF("name", "Isolate Port (%" Pd64 ")", entry.port);
-        msg_handler = DartLibraryCalls::LookupHandler(entry.port);
-        port.AddProperty("handler", msg_handler);
+    for (intptr_t i = 0; i < kShardCount; i++) {
+      SafepointMutexLocker ml(&shards_[i].mutex);
+      if (shards_[i].ports == nullptr) {
+        return;
+      }
+      for (auto& entry : *shards_[i].ports) {
+        if (entry.handler == handler) {
+          JSONObject port(&ports);
+          port.AddProperty("type", "_Port");
+          port.AddPropertyF("name", "Isolate Port (%" Pd64 ")", entry.port);
+          msg_handler = DartLibraryCalls::LookupHandler(entry.port);
+          port.AddProperty("handler", msg_handler);
+          PrintQueueState(&port, handler, entry);
+          // Messages posted from now on are accounted for.
+          QueueStateLocked(&entry);
+        }
       }
     }
   }
 #endif
 }
 
+#ifndef PRODUCT
+void PortMap::PrintQueueState(JSONObject* port,
+                              MessageHandler* handler,
+                              const Entry& entry) {
+  const PortQueueState* state = entry.queue_state;
+  if (state == nullptr) {
+    return;
+  }
+  port->AddProperty64("queued", state->depth());
+  port->AddProperty64("queueLimit", state->limit_.load());
+  if (state->limit_.load() != 0) {
+    const char* policy = nullptr;
+    switch (state->policy_) {
+      case PortQueueState::kBlock:
+        policy = "Block";
+        break;
+      case PortQueueState::kDrop:
+        policy = "Drop";
+        break;
+      case PortQueueState::kNotify:
+        policy = "Notify";
+        break;
+    }
+    port->AddProperty("queuePolicy", policy);
+  }
+  port->AddProperty64("enqueued", state->enqueued_);
+  port->AddProperty64("dropped", state->dropped_);
+  port->AddProperty64("enqueueRate",
+                      state->EnqueueRate(OS::GetCurrentMonotonicMicros()));
+  port->AddProperty64("oldestMessageAgeMicros",
+                      handler->OldestMessageAge(entry.port));
+}
+#endif  // !PRODUCT
+
 void PortMap::DebugDumpForMessageHandler(MessageHandler* handler) {
-  SafepointMutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  if (shards_ == nullptr) {
     return;
   }
   Object& msg_handler = Object::Handle();
-  for (auto& entry : *ports_) {
-    if (entry.handler == handler) {
-      OS::PrintErr("Port = %" Pd64 "\n", entry.port);
-      msg_handler = DartLibraryCalls::LookupHandler(entry.port);
-      OS::PrintErr("Handler = %s\n", msg_handler.ToCString());
+  for (intptr_t i = 0; i < kShardCount; i++) {
+    SafepointMutexLocker ml(&shards_[i].mutex);
+    if (shards_[i].ports == nullptr) {
+      return;
+    }
+    for (auto& entry : *shards_[i].ports) {
+      if (entry.handler == handler) {
+        OS::PrintErr("Port = %" Pd64 "\n", entry.port);
+        msg_handler = DartLibraryCalls::LookupHandler(entry.port);
+        OS::PrintErr("Handler = %s\n", msg_handler.ToCString());
+      }
     }
   }
 }
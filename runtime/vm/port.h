@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_PORT_H_
 #define RUNTIME_VM_PORT_H_
 
+#include <atomic>
 #include <memory>
 
 #include "include/dart_api.h"
@@ -20,9 +21,85 @@ namespace dart {
 class Isolate;
 class Message;
 class MessageHandler;
+class Monitor;
 class Mutex;
 class PortHandler;
 
+// Counts the normal messages queued for a port, optionally limits their
+// number and keeps statistics about them for the service protocol. Ports
+// only have one once a limit is set or their statistics are requested.
+//
+// Reference counted: the port map holds a reference while the port is open
+// and every queued message holds one until the receiver dequeues it.
+class PortQueueState {
+ public:
+  // What happens to a message posted while the queue is full.
+  enum Policy {
+    kBlock,   // The poster waits until the receiver dequeues messages.
+    kDrop,    // The message is discarded, posting it still succeeds.
+    kNotify,  // The message is discarded and posting it fails.
+  };
+
+  PortQueueState() {}
+
+  void Retain() { ref_count_.fetch_add(1, std::memory_order_relaxed); }
+  void Release() {
+    if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+  // Called when the receiver takes a message off the queue.
+  void MessageDequeued();
+
+  // The number of messages queued and not dequeued yet.
+  intptr_t depth() const { return depth_.load(std::memory_order_relaxed); }
+
+ private:
+  friend class PortMap;
+
+  // Sequentially consistent with the update of [depth_] in
+  // [MessageDequeued], see [WaitForSpaceBlocked].
+  bool IsFull() const {
+    const intptr_t limit = limit_.load(std::memory_order_relaxed);
+    return limit != 0 && depth_.load() >= limit;
+  }
+
+  // Accounts for [message] being queued at time [now].
+  void MessageEnqueued(Message* message, int64_t now);
+
+  // Messages enqueued per second over the last full window, as of [now].
+  int64_t EnqueueRate(int64_t now) const;
+
+  // Waits until the queue is not full any longer or the port is closed.
+  void WaitForSpace();
+  void WaitForSpaceBlocked();
+
+  // Marks the port closed and wakes up the posters waiting for it.
+  void Close();
+  void NotifyWaiters();
+
+  std::atomic<intptr_t> ref_count_ = {1};
+  std::atomic<intptr_t> depth_ = {0};
+  std::atomic<intptr_t> limit_ = {0};  // 0 for no limit.
+  std::atomic<intptr_t> waiters_ = {0};
+  std::atomic<bool> closed_ = {false};
+
+  // The fields below are protected by the lock of the port's shard.
+  Policy policy_ = kBlock;
+  int64_t enqueued_ = 0;
+  int64_t dropped_ = 0;
+  // Messages enqueued per second, over the window before the current one.
+  int64_t enqueue_rate_ = 0;
+  int64_t rate_window_start_ = 0;
+  int64_t rate_window_count_ = 0;
+
+  // The posters waiting for space in this queue wait on it.
+  Monitor space_monitor_;
+
+  DISALLOW_COPY_AND_ASSIGN(PortQueueState);
+};
+
 class PortMap : public AllStatic {
  public:
   // Allocate a port for the provided handler and return its VM-global id.
@@ -37,11 +114,24 @@ class PortMap : public AllStatic {
   static void ClosePorts(MessageHandler* handler);
 
   // Enqueues the message in the port with id. Returns false if the port is not
-  // active any longer.
+  // active any longer, or if its queue is full and its policy is
+  // [PortQueueState::kNotify], in which case [queue_full] is set.
   //
   // Claims ownership of 'message'.
   static bool PostMessage(std::unique_ptr<Message> message,
-                          bool before_events = false);
+                          bool before_events = false,
+                          bool* queue_full = nullptr);
+
+  // Limits the number of normal messages queued for the port with id to
+  // [limit] (0 for no limit), applying [policy] to messages posted while
+  // there are that many. Returns false if the port does not exist.
+  static bool SetQueueLimit(Dart_Port id,
+                            intptr_t limit,
+                            PortQueueState::Policy policy);
+
+  // Starts keeping the statistics of the queues of the ports of [handler],
+  // which are only kept for ports with a limit otherwise.
+  static void RequestQueueStatistics(MessageHandler* handler);
 
   // Returns the origin id for port 'id'.
   static Dart_Port GetOriginId(Dart_Port id);
@@ -69,11 +159,21 @@ class PortMap : public AllStatic {
 
   static void DebugDumpForMessageHandler(MessageHandler* handler);
 
+  // Holds the lock that serializes opening and closing ports and protects
+  // the sets of ports of each handler.
   class Locker : public MutexLocker {
    public:
     Locker() : MutexLocker(PortMap::mutex_) {}
   };
 
+  // Holds the lock of the shard of the port map that contains [port]. While
+  // it is held the port cannot be closed, so its handler stays alive.
+  class ShardLocker : public MutexLocker {
+   public:
+    explicit ShardLocker(Dart_Port port)
+        : MutexLocker(&PortMap::ShardFor(port)->mutex) {}
+  };
+
  private:
   struct Entry : public PortSet<Entry>::Entry {
     Entry() : handler(nullptr) {}
@@ -81,17 +181,42 @@ class PortMap : public AllStatic {
         : PortSet<Entry>::Entry(port), handler(handler) {}
 
     PortHandler* handler;
+    // Created when a limit is set or statistics are requested.
+    PortQueueState* queue_state = nullptr;
+  };
+
+  // The ports are spread over shards with separate locks, so that posting
+  // messages to ports in different shards does not contend on one lock.
+  static constexpr intptr_t kShardCount = 64;
+
+  struct Shard {
+    Mutex mutex;
+    // Written with both [PortMap::mutex_] and [mutex] held.
+    PortSet<Entry>* ports = nullptr;
   };
 
+  // Returns the shard that contains [port]. Before [Init], returns a shard
+  // without a port set, so the port is not found.
+  static Shard* ShardFor(Dart_Port port);
+
   // Allocate a new unique port.
   static Dart_Port AllocatePort();
 
-  static Isolate* GetIsolateLocked(const Locker& ml, Dart_Port id);
+  static Isolate* GetIsolateLocked(const ShardLocker& ml, Dart_Port id);
+
+#ifndef PRODUCT
+  static void PrintQueueState(JSONObject* port,
+                              MessageHandler* handler,
+                              const Entry& entry);
+#endif
+
+  static PortQueueState* QueueStateLocked(Entry* entry);
+  static void ReleaseQueueState(const Entry& entry);
 
-  // Lock protecting access to the port map.
+  // Lock serializing the opening and closing of ports.
   static Mutex* mutex_;
 
-  static PortSet<Entry>* ports_;
+  static Shard* shards_;
 
   static Random* prng_;
 };
@@ -127,6 +252,10 @@ class PortHandler {
   virtual void PostMessage(std::unique_ptr<Message> message,
                            bool before_events = false) = 0;
 
+  // Notify the handler that a message posted to one of its ports was
+  // discarded because the port's queue was full.
+  virtual void OnMessageDropped() {}
+
  protected:
   struct PortSetEntry : public PortSet<PortSetEntry>::Entry {
     PortSetEntry() : Entry() {}
@@ -140,7 +269,7 @@ class PortHandler {
   // handler supports multiple ports or |nullptr| otherwise.
   //
   // Only |PortMap| is expected to call this method under locked
-  // PortMap::mutex_.
+  // PortMap::mutex_ (see [PortMap::Locker]).
   virtual PortSet<PortSetEntry>* ports(PortMap::Locker& locker) = 0;
 };
 
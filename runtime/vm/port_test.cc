@@ -131,4 +131,218 @@ TEST_CASE(PortMap_PostMessageClosedPort) {
                    message_len, nullptr, Message::kNormalPriority)));
 }
 
+TEST_CASE(PortMap_QueueLimitDrop) {
+  PortTestMessageHandler handler;
+  Dart_Port port = PortMap::CreatePort(&handler);
+  EXPECT(PortMap::SetQueueLimit(port, 2, PortQueueState::kDrop));
+
+  for (intptr_t i = 0; i < 3; i++) {
+    EXPECT(PortMap::PostMessage(
+        Message::New(port, Smi::New(i), Message::kNormalPriority)));
+  }
+  EXPECT_EQ(2, handler.notify_count);
+  EXPECT_EQ(2, handler.messages_queued());
+  EXPECT_EQ(1, handler.messages_dropped());
+
+  // Control messages are not limited.
+  EXPECT(PortMap::PostMessage(
+      Message::New(port, Smi::New(3), Message::kOOBPriority)));
+  EXPECT_EQ(3, handler.notify_count);
+
+  // Handling a message makes space for another one.
+  EXPECT_EQ(MessageHandler::kOK, handler.HandleNextMessage());
+  EXPECT_EQ(1, handler.messages_queued());
+  EXPECT(PortMap::PostMessage(
+      Message::New(port, Smi::New(4), Message::kNormalPriority)));
+  EXPECT_EQ(2, handler.messages_queued());
+  EXPECT_EQ(1, handler.messages_dropped());
+  PortMap::ClosePorts(&handler);
+}
+
+TEST_CASE(PortMap_QueueLimitNotify) {
+  PortTestMessageHandler handler;
+  Dart_Port port = PortMap::CreatePort(&handler);
+  EXPECT(PortMap::SetQueueLimit(port, 1, PortQueueState::kNotify));
+
+  bool queue_full = false;
+  EXPECT(PortMap::PostMessage(
+      Message::New(port, Smi::New(1), Message::kNormalPriority),
+      /*before_events=*/false, &queue_full));
+  EXPECT(!queue_full);
+  EXPECT(!PortMap::PostMessage(
+      Message::New(port, Smi::New(2), Message::kNormalPriority),
+      /*before_events=*/false, &queue_full));
+  EXPECT(queue_full);
+  EXPECT_EQ(1, handler.messages_queued());
+  EXPECT_EQ(1, handler.messages_dropped());
+
+  // Without a limit, messages are queued again.
+  EXPECT(PortMap::SetQueueLimit(port, 0, PortQueueState::kNotify));
+  EXPECT(PortMap::PostMessage(
+      Message::New(port, Smi::New(3), Message::kNormalPriority),
+      /*before_events=*/false, &queue_full));
+  EXPECT(!queue_full);
+  EXPECT_EQ(2, handler.messages_queued());
+  PortMap::ClosePorts(&handler);
+
+  EXPECT(!PortMap::SetQueueLimit(port, 1, PortQueueState::kNotify));
+}
+
+TEST_CASE(PortMap_QueueStatisticsOnRequest) {
+  PortTestMessageHandler handler;
+  Dart_Port port = PortMap::CreatePort(&handler);
+
+  // Messages posted to a port without a limit are not accounted for.
+  EXPECT(PortMap::PostMessage(
+      Message::New(port, Smi::New(1), Message::kNormalPriority)));
+  OS::Sleep(2);
+  EXPECT_EQ(0, handler.OldestMessageAge(port));
+
+  PortMap::RequestQueueStatistics(&handler);
+  EXPECT(PortMap::PostMessage(
+      Message::New(port, Smi::New(2), Message::kNormalPriority)));
+  OS::Sleep(2);
+  EXPECT_LT(0, handler.OldestMessageAge(port));
+  EXPECT_EQ(2, handler.messages_queued());
+  PortMap::ClosePorts(&handler);
+}
+
+TEST_CASE(PortMap_QueueLimitBlock) {
+  struct PostArguments {
+    Dart_Port port;
+    Monitor* monitor;
+    bool posted = false;
+    ThreadJoinId join_id = OSThread::kInvalidThreadJoinId;
+  };
+
+  auto start_poster = [](PostArguments* arguments) {
+    OSThread::Start(
+        "PortMapPoster",
+        [](uword arguments_ptr) {
+          PostArguments* arguments =
+              reinterpret_cast<PostArguments*>(arguments_ptr);
+          const bool posted = PortMap::PostMessage(Message::New(
+              arguments->port, Smi::New(0), Message::kNormalPriority));
+          MonitorLocker ml(arguments->monitor);
+          arguments->posted = posted;
+          arguments->join_id =
+              OSThread::GetCurrentThreadJoinId(OSThread::Current());
+          ml.Notify();
+        },
+        reinterpret_cast<uword>(arguments));
+  };
+  auto join_poster = [](PostArguments* arguments) {
+    {
+      MonitorLocker ml(arguments->monitor);
+      while (arguments->join_id == OSThread::kInvalidThreadJoinId) {
+        ml.Wait();
+      }
+    }
+    OSThread::Join(arguments->join_id);
+  };
+
+  PortTestMessageHandler handler;
+  Dart_Port port = PortMap::CreatePort(&handler);
+  EXPECT(PortMap::SetQueueLimit(port, 1, PortQueueState::kBlock));
+  EXPECT(PortMap::PostMessage(
+      Message::New(port, Smi::New(1), Message::kNormalPriority)));
+
+  // The poster waits until the message in the queue is handled.
+  Monitor monitor;
+  PostArguments first = {port, &monitor};
+  start_poster(&first);
+  OS::Sleep(50);
+  {
+    MonitorLocker ml(&monitor);
+    EXPECT(first.join_id == OSThread::kInvalidThreadJoinId);
+  }
+  EXPECT_EQ(1, handler.notify_count);
+  EXPECT_EQ(MessageHandler::kOK, handler.HandleNextMessage());
+  join_poster(&first);
+  EXPECT(first.posted);
+  EXPECT_EQ(2, handler.notify_count);
+  EXPECT_EQ(1, handler.messages_queued());
+
+  // Closing the port lets a waiting poster fail.
+  PostArguments second = {port, &monitor};
+  start_poster(&second);
+  OS::Sleep(50);
+  PortMap::ClosePort(port);
+  join_poster(&second);
+  EXPECT(!second.posted);
+  EXPECT_EQ(2, handler.notify_count);
+}
+
+class ConcurrentPortTestMessageHandler : public MessageHandler {
+ public:
+  void MessageNotify(Message::Priority priority) { notify_count++; }
+
+  MessageStatus HandleMessage(std::unique_ptr<Message> message) { return kOK; }
+
+  RelaxedAtomic<intptr_t> notify_count = 0;
+};
+
+TEST_CASE(PortMap_ConcurrentPostMessage) {
+  const intptr_t kPortCount = 256;
+  const intptr_t kThreadCount = 8;
+  const intptr_t kRounds = 16;
+
+  struct PostArguments {
+    Dart_Port* ports;
+    Monitor* monitor;
+    ThreadJoinId join_id = OSThread::kInvalidThreadJoinId;
+  };
+
+  // Post from several threads to ports spread over all shards, while other
+  // ports are opened and closed.
+  ConcurrentPortTestMessageHandler handler;
+  Dart_Port ports[kPortCount];
+  for (intptr_t i = 0; i < kPortCount; i++) {
+    ports[i] = PortMap::CreatePort(&handler);
+  }
+  Monitor monitor;
+  PostArguments arguments[kThreadCount];
+  for (intptr_t i = 0; i < kThreadCount; i++) {
+    arguments[i].ports = ports;
+    arguments[i].monitor = &monitor;
+    OSThread::Start(
+        "PortMapPoster",
+        [](uword arguments_ptr) {
+          PostArguments* arguments =
+              reinterpret_cast<PostArguments*>(arguments_ptr);
+          for (intptr_t round = 0; round < kRounds; round++) {
+            for (intptr_t j = 0; j < kPortCount; j++) {
+              PortMap::PostMessage(Message::New(
+                  arguments->ports[j], Smi::New(j), Message::kNormalPriority));
+            }
+          }
+          MonitorLocker ml(arguments->monitor);
+          arguments->join_id =
+              OSThread::GetCurrentThreadJoinId(OSThread::Current());
+          ml.Notify();
+        },
+        reinterpret_cast<uword>(&arguments[i]));
+  }
+
+  PortTestMessageHandler other_handler;
+  for (intptr_t i = 0; i < kThreadCount; i++) {
+    while (true) {
+      {
+        MonitorLocker ml(&monitor);
+        if (arguments[i].join_id != OSThread::kInvalidThreadJoinId) break;
+      }
+      Dart_Port port = PortMap::CreatePort(&other_handler);
+      EXPECT(PortMap::PortExists(port));
+      PortMap::ClosePort(port);
+    }
+    OSThread::Join(arguments[i].join_id);
+  }
+
+  EXPECT_EQ(kPortCount * kThreadCount * kRounds, handler.notify_count.load());
+  PortMap::ClosePorts(&handler);
+  for (intptr_t i = 0; i < kPortCount; i++) {
+    EXPECT(!PortMap::PortExists(ports[i]));
+  }
+}
+
 }  // namespace dart
@@ -11,6 +11,7 @@
 #include "vm/regexp/regexp_assembler_bytecode_inl.h"
 #include "vm/regexp/regexp_bytecodes.h"
 #include "vm/regexp/regexp_interpreter.h"
+#include "vm/regexp/regexp_nfa.h"
 #include "vm/regexp/regexp_parser.h"
 #include "vm/timeline.h"
 
@@ -443,22 +444,36 @@ static intptr_t Prepare(const RegExp& regexp,
 
     regexp.set_num_bracket_expressions(compile_data->capture_count);
     regexp.set_capture_name_map(compile_data->capture_name_map);
+    TypedData& program = TypedData::Handle(zone);
     if (compile_data->simple) {
       regexp.set_is_simple();
     } else {
-      regexp.set_is_complex();
+      // Patterns the NFA simulation supports don't need to backtrack.
+      program = RegExpNfa::Compile(compile_data->tree, regexp.flags(),
+                                   compile_data->capture_count, is_one_byte,
+                                   zone);
+      if (program.IsNull()) {
+        regexp.set_is_complex();
+      } else {
+        regexp.set_is_linear();
+      }
     }
 
-    RegExpEngine::CompilationResult result = RegExpEngine::CompileBytecode(
-        compile_data, regexp, is_one_byte, sticky, zone);
-    if (result.error_message != nullptr) {
-      Exceptions::ThrowUnsupportedError(result.error_message);
+    if (!program.IsNull()) {
+      regexp.set_num_registers(is_one_byte, 0);
+      regexp.set_bytecode(is_one_byte, sticky, program);
+    } else {
+      RegExpEngine::CompilationResult result = RegExpEngine::CompileBytecode(
+          compile_data, regexp, is_one_byte, sticky, zone);
+      if (result.error_message != nullptr) {
+        Exceptions::ThrowUnsupportedError(result.error_message);
+      }
+      ASSERT(result.bytecode != nullptr);
+      ASSERT(regexp.num_registers(is_one_byte) == -1 ||
+             regexp.num_registers(is_one_byte) == result.num_registers);
+      regexp.set_num_registers(is_one_byte, result.num_registers);
+      regexp.set_bytecode(is_one_byte, sticky, *(result.bytecode));
     }
-    ASSERT(result.bytecode != nullptr);
-    ASSERT(regexp.num_registers(is_one_byte) == -1 ||
-           regexp.num_registers(is_one_byte) == result.num_registers);
-    regexp.set_num_registers(is_one_byte, result.num_registers);
-    regexp.set_bytecode(is_one_byte, sticky, *(result.bytecode));
   }
 
   ASSERT(regexp.num_registers(is_one_byte) != -1);
@@ -492,7 +507,11 @@ static ObjectPtr ExecRaw(const RegExp& regexp,
       TypedData::Handle(zone, regexp.bytecode(is_one_byte, sticky));
   ASSERT(!bytecode.IsNull());
   const Object& result = Object::Handle(
-      zone, IrregexpInterpreter::Match(bytecode, subject, raw_output, index));
+      zone, regexp.is_linear()
+                ? RegExpNfa::Match(bytecode, subject, raw_output, index,
+                                   sticky, zone)
+                : IrregexpInterpreter::Match(bytecode, subject, raw_output,
+                                             index));
 
   if (result.ptr() == Bool::True().ptr()) {
     // Copy capture results to the start of the registers array.
@@ -506,6 +525,82 @@ static ObjectPtr ExecRaw(const RegExp& regexp,
   return result.ptr();
 }
 
+// Whether [regexp] can be matched by searching for its pattern in the subject.
+// The parser marks a regexp as simple if the whole pattern is a single literal
+// atom without captures.
+static bool CanMatchAsAtom(const RegExp& regexp, const String& pattern) {
+  if (!regexp.is_simple()) return false;
+  const RegExpFlags flags = regexp.flags();
+  if (flags.IgnoreCase()) return false;
+  if (flags.IsUnicode()) {
+    // Unicode patterns must not match inside surrogate pairs.
+    for (intptr_t i = 0; i < pattern.Length(); i++) {
+      if (Utf16::IsSurrogate(pattern.CharAt(i))) return false;
+    }
+  }
+  return true;
+}
+
+template <typename PatternChar, typename SubjectChar>
+static intptr_t SearchAtom(const PatternChar* pattern,
+                           intptr_t pattern_length,
+                           const SubjectChar* subject,
+                           intptr_t subject_length,
+                           intptr_t index,
+                           bool sticky) {
+  if (pattern_length == 0) return index;
+  // The last index at which a match may start.
+  intptr_t last = subject_length - pattern_length;
+  if (sticky && index < last) last = index;
+  const PatternChar first = pattern[0];
+  for (; index <= last; index++) {
+    if (sizeof(SubjectChar) == 1) {
+      if (sizeof(PatternChar) != 1 && first > 0xFF) return -1;
+      // Skip to the next candidate using the vectorized memchr.
+      const void* candidate = memchr(&subject[index], first, last - index + 1);
+      if (candidate == nullptr) return -1;
+      index = reinterpret_cast<const SubjectChar*>(candidate) - subject;
+    } else if (subject[index] != first) {
+      continue;
+    }
+    intptr_t i = 1;
+    while (i < pattern_length && subject[index + i] == pattern[i]) {
+      i++;
+    }
+    if (i == pattern_length) return index;
+  }
+  return -1;
+}
+
+intptr_t BytecodeRegExpMacroAssembler::SearchAtom(const String& pattern,
+                                                  const String& subject,
+                                                  intptr_t index,
+                                                  bool is_sticky) {
+  const intptr_t pattern_length = pattern.Length();
+  const intptr_t subject_length = subject.Length();
+  NoSafepointScope no_safepoint;
+  if (pattern.IsOneByteString()) {
+    const uint8_t* pattern_data = OneByteString::DataStart(pattern);
+    if (subject.IsOneByteString()) {
+      return dart::SearchAtom(pattern_data, pattern_length,
+                              OneByteString::DataStart(subject),
+                              subject_length, index, is_sticky);
+    }
+    return dart::SearchAtom(pattern_data, pattern_length,
+                            TwoByteString::DataStart(subject), subject_length,
+                            index, is_sticky);
+  }
+  const uint16_t* pattern_data = TwoByteString::DataStart(pattern);
+  if (subject.IsOneByteString()) {
+    return dart::SearchAtom(pattern_data, pattern_length,
+                            OneByteString::DataStart(subject), subject_length,
+                            index, is_sticky);
+  }
+  return dart::SearchAtom(pattern_data, pattern_length,
+                          TwoByteString::DataStart(subject), subject_length,
+                          index, is_sticky);
+}
+
 ObjectPtr BytecodeRegExpMacroAssembler::Interpret(const RegExp& regexp,
                                                   const String& subject,
                                                   const Smi& start_index,
@@ -517,6 +612,24 @@ ObjectPtr BytecodeRegExpMacroAssembler::Interpret(const RegExp& regexp,
     UNREACHABLE();
   }
 
+  // Literal patterns don't need the backtracking interpreter.
+  const String& pattern = String::Handle(zone, regexp.pattern());
+  const intptr_t index = start_index.Value();
+  if (index >= 0 && index <= subject.Length() &&
+      CanMatchAsAtom(regexp, pattern)) {
+    ASSERT(regexp.num_bracket_expressions() == 0);
+    const intptr_t match_start = SearchAtom(pattern, subject, index, sticky);
+    if (match_start < 0) {
+      return Instance::null();
+    }
+    const TypedData& result =
+        TypedData::Handle(zone, TypedData::New(kTypedDataInt32ArrayCid, 2));
+    result.SetInt32(0, static_cast<int32_t>(match_start));
+    result.SetInt32(sizeof(int32_t),
+                    static_cast<int32_t>(match_start + pattern.Length()));
+    return result.ptr();
+  }
+
   // V8 uses a shared copy on the isolate when smaller than some threshold.
   int32_t* output_registers = zone->Alloc<int32_t>(required_registers);
 
@@ -114,6 +114,13 @@ class BytecodeRegExpMacroAssembler : public RegExpMacroAssembler {
                              Zone* zone);
 
  private:
+  // Returns the index of the first occurrence of [pattern] in [subject] at or
+  // after [index] (or exactly at [index] if [is_sticky]), or -1 if none.
+  static intptr_t SearchAtom(const String& pattern,
+                             const String& subject,
+                             intptr_t index,
+                             bool is_sticky);
+
   void Expand();
   // Code and bitmap emission.
   inline void EmitOrLink(BlockLabel* label);
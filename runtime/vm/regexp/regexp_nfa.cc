@@ -0,0 +1,667 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/regexp/regexp_nfa.h"
+
+#include "platform/unicode.h"
+#include "vm/flags.h"
+#include "vm/growable_array.h"
+#include "vm/regexp/regexp.h"
+#include "vm/regexp/regexp_ast.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            regexp_nfa,
+            true,
+            "Match interpreted regexps without backreferences or lookarounds "
+            "by NFA simulation instead of backtracking.");
+
+// Each instruction is an opcode and two operands, a and b.
+enum NfaOpcode : int32_t {
+  kNfaChar,          // Consumes the character a.
+  kNfaAny,           // Consumes any character.
+  kNfaClass,         // Consumes a character in the b ranges starting at a.
+  kNfaNegatedClass,  // Consumes a character not in the b ranges at a.
+  kNfaMatch,         // Reports a match.
+  kNfaJump,          // Continues at a.
+  kNfaSplit,         // Continues at a, then with lower priority at b.
+  kNfaSave,          // Stores the position in register a.
+  kNfaClear,         // Clears registers a to b.
+  kNfaAssert,        // Continues if RegExpAssertion::AssertionType a holds.
+};
+
+// Layout of a compiled program, in int32 elements: a header, the
+// instructions, and the character ranges of classes as inclusive pairs.
+static constexpr intptr_t kNfaInstructionCountIndex = 0;
+static constexpr intptr_t kNfaRegisterCountIndex = 1;
+// The character every match starts with, or -1.
+static constexpr intptr_t kNfaFirstCharIndex = 2;
+static constexpr intptr_t kNfaRangesStartIndex = 3;
+static constexpr intptr_t kNfaHeaderSize = 4;
+static constexpr intptr_t kNfaInstructionSize = 3;
+
+// Bounds the program size, which counted repetitions multiply.
+static constexpr intptr_t kNfaMaxInstructions = 10000;
+
+class NfaCompiler : public RegExpVisitor {
+ public:
+  NfaCompiler(RegExpFlags flags, bool is_one_byte, Zone* zone)
+      : flags_(flags), is_one_byte_(is_one_byte), zone_(zone), failed_(false) {}
+
+#define DECLARE_VISIT(Name)                                                    \
+  virtual void* Visit##Name(RegExp##Name* that, void* data);
+  FOR_EACH_REG_EXP_TREE_TYPE(DECLARE_VISIT)
+#undef DECLARE_VISIT
+
+  TypedDataPtr Compile(RegExpTree* tree, intptr_t capture_count);
+
+ private:
+  struct Instruction {
+    int32_t opcode;
+    int32_t a;
+    int32_t b;
+  };
+
+  intptr_t Emit(NfaOpcode opcode, int32_t a = 0, int32_t b = 0) {
+    if (code_.length() >= kNfaMaxInstructions) {
+      failed_ = true;
+    }
+    code_.Add({opcode, a, b});
+    return code_.length() - 1;
+  }
+
+  void PatchSplit(intptr_t split, intptr_t body, intptr_t exit, bool greedy) {
+    ASSERT(code_[split].opcode == kNfaSplit);
+    code_[split].a = greedy ? body : exit;
+    code_[split].b = greedy ? exit : body;
+  }
+
+  void EmitClass(ZoneGrowableArray<CharacterRange>* ranges, bool negated);
+  void EmitIteration(RegExpQuantifier* that);
+  int32_t FirstChar() const;
+
+  const RegExpFlags flags_;
+  const bool is_one_byte_;
+  Zone* const zone_;
+  bool failed_;
+  GrowableArray<Instruction> code_;
+  GrowableArray<int32_t> ranges_;
+};
+
+void NfaCompiler::EmitClass(ZoneGrowableArray<CharacterRange>* ranges,
+                            bool negated) {
+  auto set = new (zone_) ZoneGrowableArray<CharacterRange>(ranges->length());
+  for (intptr_t i = 0; i < ranges->length(); i++) {
+    set->Add(ranges->At(i));
+  }
+  if (flags_.IgnoreCase()) {
+    CharacterRange::AddCaseEquivalents(set, is_one_byte_, zone_);
+  }
+  CharacterRange::Canonicalize(set);
+  // Without the unicode flag, the subject is matched by code units.
+  intptr_t count = 0;
+  while (count < set->length() &&
+         set->At(count).from() <= Utf16::kMaxCodeUnit) {
+    count++;
+  }
+  if (!negated && count == 1) {
+    const int32_t from = set->At(0).from();
+    const int32_t to = Utils::Minimum(set->At(0).to(), Utf16::kMaxCodeUnit);
+    if (from == to) {
+      Emit(kNfaChar, from);
+      return;
+    }
+    if (from == 0 && to == Utf16::kMaxCodeUnit) {
+      Emit(kNfaAny);
+      return;
+    }
+  }
+  Emit(negated ? kNfaNegatedClass : kNfaClass, ranges_.length(), count);
+  for (intptr_t i = 0; i < count; i++) {
+    ranges_.Add(set->At(i).from());
+    ranges_.Add(Utils::Minimum(set->At(i).to(), Utf16::kMaxCodeUnit));
+  }
+}
+
+void* NfaCompiler::VisitDisjunction(RegExpDisjunction* that, void* data) {
+  ZoneGrowableArray<RegExpTree*>* alternatives = that->alternatives();
+  GrowableArray<intptr_t> exits;
+  for (intptr_t i = 0; i < alternatives->length() && !failed_; i++) {
+    if (i == alternatives->length() - 1) {
+      alternatives->At(i)->Accept(this, data);
+      break;
+    }
+    const intptr_t split = Emit(kNfaSplit);
+    alternatives->At(i)->Accept(this, data);
+    exits.Add(Emit(kNfaJump));
+    PatchSplit(split, split + 1, code_.length(), /*greedy=*/true);
+  }
+  for (intptr_t i = 0; i < exits.length(); i++) {
+    code_[exits[i]].a = code_.length();
+  }
+  return nullptr;
+}
+
+void* NfaCompiler::VisitAlternative(RegExpAlternative* that, void* data) {
+  ZoneGrowableArray<RegExpTree*>* nodes = that->nodes();
+  for (intptr_t i = 0; i < nodes->length() && !failed_; i++) {
+    nodes->At(i)->Accept(this, data);
+  }
+  return nullptr;
+}
+
+void* NfaCompiler::VisitAssertion(RegExpAssertion* that, void* data) {
+  Emit(kNfaAssert, that->assertion_type());
+  return nullptr;
+}
+
+void* NfaCompiler::VisitCharacterClass(RegExpCharacterClass* that,
+                                       void* data) {
+  EmitClass(that->ranges(), that->is_negated());
+  return nullptr;
+}
+
+void* NfaCompiler::VisitAtom(RegExpAtom* that, void* data) {
+  ZoneGrowableArray<uint16_t>* chars = that->data();
+  for (intptr_t i = 0; i < chars->length(); i++) {
+    if (flags_.IgnoreCase()) {
+      EmitClass(CharacterRange::List(
+                    zone_, CharacterRange::Singleton(chars->At(i))),
+                /*negated=*/false);
+    } else {
+      Emit(kNfaChar, chars->At(i));
+    }
+  }
+  return nullptr;
+}
+
+void* NfaCompiler::VisitText(RegExpText* that, void* data) {
+  GrowableArray<TextElement>* elements = that->elements();
+  for (intptr_t i = 0; i < elements->length(); i++) {
+    const TextElement& element = elements->At(i);
+    if (element.text_type() == TextElement::ATOM) {
+      VisitAtom(element.atom(), data);
+    } else {
+      VisitCharacterClass(element.char_class(), data);
+    }
+  }
+  return nullptr;
+}
+
+void NfaCompiler::EmitIteration(RegExpQuantifier* that) {
+  // Each iteration starts with the captures of the body cleared.
+  const Interval registers = that->body()->CaptureRegisters();
+  if (!registers.is_empty()) {
+    Emit(kNfaClear, registers.from(), registers.to());
+  }
+  that->body()->Accept(this, nullptr);
+}
+
+void* NfaCompiler::VisitQuantifier(RegExpQuantifier* that, void* data) {
+  if (that->is_possessive() ||
+      (that->max() > 1 && that->body()->min_match() == 0)) {
+    failed_ = true;
+    return nullptr;
+  }
+  for (intptr_t i = 0; i < that->min() && !failed_; i++) {
+    EmitIteration(that);
+  }
+  if (that->max() == RegExpTree::kInfinity) {
+    const intptr_t split = Emit(kNfaSplit);
+    EmitIteration(that);
+    Emit(kNfaJump, split);
+    PatchSplit(split, split + 1, code_.length(), that->is_greedy());
+  } else {
+    GrowableArray<intptr_t> splits;
+    for (intptr_t i = that->min(); i < that->max() && !failed_; i++) {
+      splits.Add(Emit(kNfaSplit));
+      EmitIteration(that);
+    }
+    for (intptr_t i = 0; i < splits.length(); i++) {
+      PatchSplit(splits[i], splits[i] + 1, code_.length(), that->is_greedy());
+    }
+  }
+  return nullptr;
+}
+
+void* NfaCompiler::VisitCapture(RegExpCapture* that, void* data) {
+  Emit(kNfaSave, RegExpCapture::StartRegister(that->index()));
+  that->body()->Accept(this, data);
+  Emit(kNfaSave, RegExpCapture::EndRegister(that->index()));
+  return nullptr;
+}
+
+void* NfaCompiler::VisitLookaround(RegExpLookaround* that, void* data) {
+  failed_ = true;
+  return nullptr;
+}
+
+void* NfaCompiler::VisitBackReference(RegExpBackReference* that, void* data) {
+  failed_ = true;
+  return nullptr;
+}
+
+void* NfaCompiler::VisitEmpty(RegExpEmpty* that, void* data) {
+  return nullptr;
+}
+
+int32_t NfaCompiler::FirstChar() const {
+  intptr_t pc = 0;
+  for (intptr_t i = 0; i < code_.length(); i++) {
+    const Instruction& instruction = code_[pc];
+    switch (instruction.opcode) {
+      case kNfaSave:
+      case kNfaClear:
+        pc++;
+        break;
+      case kNfaJump:
+        pc = instruction.a;
+        break;
+      case kNfaChar:
+        return instruction.a;
+      default:
+        return -1;
+    }
+  }
+  return -1;
+}
+
+TypedDataPtr NfaCompiler::Compile(RegExpTree* tree, intptr_t capture_count) {
+  Emit(kNfaSave, RegExpCapture::StartRegister(0));
+  tree->Accept(this, nullptr);
+  Emit(kNfaSave, RegExpCapture::EndRegister(0));
+  Emit(kNfaMatch);
+  if (failed_) {
+    return TypedData::null();
+  }
+
+  const intptr_t ranges_start =
+      kNfaHeaderSize + code_.length() * kNfaInstructionSize;
+  const TypedData& program = TypedData::Handle(
+      zone_, TypedData::New(kTypedDataInt32ArrayCid,
+                            ranges_start + ranges_.length(), Heap::kOld));
+  NoSafepointScope no_safepoint;
+  int32_t* data = reinterpret_cast<int32_t*>(program.DataAddr(0));
+  data[kNfaInstructionCountIndex] = code_.length();
+  data[kNfaRegisterCountIndex] = (capture_count + 1) * 2;
+  data[kNfaFirstCharIndex] = FirstChar();
+  data[kNfaRangesStartIndex] = ranges_start;
+  int32_t* instruction = &data[kNfaHeaderSize];
+  for (intptr_t i = 0; i < code_.length(); i++) {
+    instruction[0] = code_[i].opcode;
+    instruction[1] = code_[i].a;
+    instruction[2] = code_[i].b;
+    instruction += kNfaInstructionSize;
+  }
+  for (intptr_t i = 0; i < ranges_.length(); i++) {
+    data[ranges_start + i] = ranges_[i];
+  }
+  return program.ptr();
+}
+
+TypedDataPtr RegExpNfa::Compile(RegExpTree* tree,
+                                RegExpFlags flags,
+                                intptr_t capture_count,
+                                bool is_one_byte,
+                                Zone* zone) {
+  // Unicode patterns match surrogate pairs as one character.
+  if (!FLAG_regexp_nfa || flags.IsUnicode()) {
+    return TypedData::null();
+  }
+  NfaCompiler compiler(flags, is_one_byte, zone);
+  return compiler.Compile(tree, capture_count);
+}
+
+// The threads at one position of the subject, in priority order, with at
+// most one thread per instruction. Membership is a sparse set, so clearing
+// the list takes constant time.
+class NfaThreadList : public ValueObject {
+ public:
+  NfaThreadList(intptr_t num_instructions, intptr_t num_registers, Zone* zone)
+      : size_(0),
+        num_registers_(num_registers),
+        sparse_(zone->Alloc<intptr_t>(num_instructions)),
+        dense_(zone->Alloc<intptr_t>(num_instructions)),
+        registers_(zone->Alloc<int32_t>(num_instructions * num_registers)) {
+    memset(sparse_, 0, num_instructions * sizeof(intptr_t));
+  }
+
+  intptr_t size() const { return size_; }
+  bool is_empty() const { return size_ == 0; }
+  void Clear() { size_ = 0; }
+
+  bool Contains(intptr_t pc) const {
+    const intptr_t index = sparse_[pc];
+    return index < size_ && dense_[index] == pc;
+  }
+
+  intptr_t Add(intptr_t pc) {
+    sparse_[pc] = size_;
+    dense_[size_] = pc;
+    return size_++;
+  }
+
+  intptr_t pc(intptr_t index) const { return dense_[index]; }
+  int32_t* registers(intptr_t index) const {
+    return &registers_[index * num_registers_];
+  }
+
+ private:
+  intptr_t size_;
+  const intptr_t num_registers_;
+  intptr_t* const sparse_;
+  intptr_t* const dense_;
+  int32_t* const registers_;
+};
+
+template <typename Char>
+class NfaSimulation : public ValueObject {
+ public:
+  using CharsFunction = const Char* (*)(const String& subject);
+
+  NfaSimulation(const TypedData& program,
+                const String& subject,
+                CharsFunction chars_of,
+                Zone* zone)
+      : program_(program),
+        subject_(subject),
+        chars_of_(chars_of),
+        length_(subject.Length()),
+        num_instructions_(program.GetInt32(kNfaInstructionCountIndex *
+                                           sizeof(int32_t))),
+        num_registers_(
+            program.GetInt32(kNfaRegisterCountIndex * sizeof(int32_t))),
+        first_char_(program.GetInt32(kNfaFirstCharIndex * sizeof(int32_t))),
+        code_(nullptr),
+        ranges_(nullptr),
+        chars_(nullptr),
+        scratch_(zone->Alloc<int32_t>(num_registers_)),
+        best_(nullptr),
+        stack_(zone, num_instructions_) {}
+
+  ObjectPtr Run(int32_t* captures, intptr_t start, bool sticky, Zone* zone);
+
+ private:
+  struct StackEntry {
+    // The instruction to continue at, or -1 to restore a register.
+    intptr_t pc;
+    intptr_t reg;
+    int32_t value;
+  };
+
+  void LoadPointers() {
+    const int32_t* data =
+        reinterpret_cast<const int32_t*>(program_.DataAddr(0));
+    code_ = &data[kNfaHeaderSize];
+    ranges_ = &data[data[kNfaRangesStartIndex]];
+    chars_ = chars_of_(subject_);
+  }
+
+  const int32_t* InstructionAt(intptr_t pc) const {
+    return &code_[pc * kNfaInstructionSize];
+  }
+
+  static bool IsLineTerminator(uint16_t c) {
+    return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+  }
+
+  bool IsWordCharAt(intptr_t pos) const {
+    if (pos < 0 || pos >= length_) return false;
+    const uint16_t c = chars_[pos];
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c == '_';
+  }
+
+  bool Holds(int32_t assertion, intptr_t pos) const {
+    switch (assertion) {
+      case RegExpAssertion::START_OF_INPUT:
+        return pos == 0;
+      case RegExpAssertion::END_OF_INPUT:
+        return pos == length_;
+      case RegExpAssertion::START_OF_LINE:
+        return pos == 0 || IsLineTerminator(chars_[pos - 1]);
+      case RegExpAssertion::END_OF_LINE:
+        return pos == length_ || IsLineTerminator(chars_[pos]);
+      case RegExpAssertion::BOUNDARY:
+        return IsWordCharAt(pos - 1) != IsWordCharAt(pos);
+      case RegExpAssertion::NON_BOUNDARY:
+        return IsWordCharAt(pos - 1) == IsWordCharAt(pos);
+    }
+    UNREACHABLE();
+    return false;
+  }
+
+  bool InRanges(const int32_t* instruction, uint16_t c) const {
+    // Binary search for the last range starting at or before c.
+    const int32_t* ranges = &ranges_[instruction[1]];
+    intptr_t low = 0;
+    intptr_t high = instruction[2];
+    while (low < high) {
+      const intptr_t mid = (low + high) / 2;
+      if (ranges[2 * mid] <= c) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low > 0 && c <= ranges[2 * (low - 1) + 1];
+  }
+
+  intptr_t FindFirstChar(intptr_t pos) const {
+    if (sizeof(Char) == 1) {
+      if (first_char_ > 0xFF || pos >= length_) return -1;
+      const void* found = memchr(&chars_[pos], first_char_, length_ - pos);
+      return found == nullptr ? -1 : static_cast<const Char*>(found) - chars_;
+    }
+    for (; pos < length_; pos++) {
+      if (chars_[pos] == first_char_) return pos;
+    }
+    return -1;
+  }
+
+  void AddThread(NfaThreadList* list,
+                 intptr_t pc,
+                 intptr_t pos,
+                 const int32_t* registers);
+  bool Step(NfaThreadList* current, NfaThreadList* next, intptr_t pos);
+
+  const TypedData& program_;
+  const String& subject_;
+  const CharsFunction chars_of_;
+  const intptr_t length_;
+  const intptr_t num_instructions_;
+  const intptr_t num_registers_;
+  const int32_t first_char_;
+  const int32_t* code_;
+  const int32_t* ranges_;
+  const Char* chars_;
+  // The registers of the thread being added.
+  int32_t* const scratch_;
+  // The registers of the best match so far.
+  int32_t* best_;
+  ZoneGrowableArray<StackEntry> stack_;
+};
+
+// Follows the non-consuming instructions from [pc], adding a thread for
+// each consuming instruction reached, in priority order.
+template <typename Char>
+void NfaSimulation<Char>::AddThread(NfaThreadList* list,
+                                    intptr_t pc,
+                                    intptr_t pos,
+                                    const int32_t* registers) {
+  memmove(scratch_, registers, num_registers_ * sizeof(int32_t));
+  stack_.Add({pc, 0, 0});
+  while (!stack_.is_empty()) {
+    const StackEntry entry = stack_.RemoveLast();
+    if (entry.pc < 0) {
+      scratch_[entry.reg] = entry.value;
+      continue;
+    }
+    pc = entry.pc;
+    while (!list->Contains(pc)) {
+      const intptr_t index = list->Add(pc);
+      const int32_t* instruction = InstructionAt(pc);
+      switch (instruction[0]) {
+        case kNfaJump:
+          pc = instruction[1];
+          continue;
+        case kNfaSplit:
+          stack_.Add({instruction[2], 0, 0});
+          pc = instruction[1];
+          continue;
+        case kNfaSave:
+          stack_.Add({-1, instruction[1], scratch_[instruction[1]]});
+          scratch_[instruction[1]] = pos;
+          pc++;
+          continue;
+        case kNfaClear:
+          for (intptr_t reg = instruction[1]; reg <= instruction[2]; reg++) {
+            stack_.Add({-1, reg, scratch_[reg]});
+            scratch_[reg] = -1;
+          }
+          pc++;
+          continue;
+        case kNfaAssert:
+          if (Holds(instruction[1], pos)) {
+            pc++;
+            continue;
+          }
+          break;
+        default:
+          memmove(list->registers(index), scratch_,
+                  num_registers_ * sizeof(int32_t));
+          break;
+      }
+      break;
+    }
+  }
+}
+
+// Advances the threads in [current] over the character at [pos]. Returns
+// whether a match was found, in which case lower priority threads are
+// dropped.
+template <typename Char>
+bool NfaSimulation<Char>::Step(NfaThreadList* current,
+                               NfaThreadList* next,
+                               intptr_t pos) {
+  const bool at_end = pos == length_;
+  const uint16_t c = at_end ? 0 : chars_[pos];
+  for (intptr_t i = 0; i < current->size(); i++) {
+    const intptr_t pc = current->pc(i);
+    const int32_t* instruction = InstructionAt(pc);
+    bool consumed = false;
+    switch (instruction[0]) {
+      case kNfaChar:
+        consumed = !at_end && c == instruction[1];
+        break;
+      case kNfaAny:
+        consumed = !at_end;
+        break;
+      case kNfaClass:
+        consumed = !at_end && InRanges(instruction, c);
+        break;
+      case kNfaNegatedClass:
+        consumed = !at_end && !InRanges(instruction, c);
+        break;
+      case kNfaMatch:
+        memmove(best_, current->registers(i),
+                num_registers_ * sizeof(int32_t));
+        return true;
+      default:
+        break;
+    }
+    if (consumed) {
+      AddThread(next, pc + 1, pos + 1, current->registers(i));
+    }
+  }
+  return false;
+}
+
+template <typename Char>
+ObjectPtr NfaSimulation<Char>::Run(int32_t* captures,
+                                   intptr_t start,
+                                   bool sticky,
+                                   Zone* zone) {
+  if (start < 0 || start > length_) {
+    return Bool::False().ptr();
+  }
+  NfaThreadList list_a(num_instructions_, num_registers_, zone);
+  NfaThreadList list_b(num_instructions_, num_registers_, zone);
+  NfaThreadList* current = &list_a;
+  NfaThreadList* next = &list_b;
+  int32_t* initial = zone->Alloc<int32_t>(num_registers_);
+  for (intptr_t i = 0; i < num_registers_; i++) {
+    initial[i] = -1;
+  }
+  best_ = captures;
+  bool matched = false;
+
+  Thread* thread = Thread::Current();
+  intptr_t pos = start;
+  while (true) {
+    if (UNLIKELY(thread->HasScheduledInterrupts())) {
+      ErrorPtr error = thread->HandleInterrupts();
+      if (error != Object::null()) {
+        return error;
+      }
+    }
+    NoSafepointScope no_safepoint;
+    // The program and subject may have been moved while handling interrupts.
+    LoadPointers();
+    while (!thread->HasScheduledInterrupts()) {
+      if (!matched && (!sticky || pos == start)) {
+        if (current->is_empty() && first_char_ >= 0 && !sticky) {
+          // No thread is running, so skip ahead to where a match can start.
+          pos = FindFirstChar(pos);
+          if (pos < 0) {
+            return Bool::False().ptr();
+          }
+        }
+        AddThread(current, 0, pos, initial);
+      }
+      if (current->is_empty()) {
+        return matched ? Bool::True().ptr() : Bool::False().ptr();
+      }
+      if (Step(current, next, pos)) {
+        matched = true;
+      }
+      NfaThreadList* swap = current;
+      current = next;
+      next = swap;
+      next->Clear();
+      if (pos == length_) {
+        return matched ? Bool::True().ptr() : Bool::False().ptr();
+      }
+      pos++;
+    }
+  }
+}
+
+ObjectPtr RegExpNfa::Match(const TypedData& program,
+                           const String& subject,
+                           int32_t* captures,
+                           intptr_t start_position,
+                           bool sticky,
+                           Zone* zone) {
+  if (subject.IsOneByteString()) {
+    NfaSimulation<uint8_t> simulation(
+        program, subject,
+        [](const String& subject) -> const uint8_t* {
+          return OneByteString::DataStart(subject);
+        },
+        zone);
+    return simulation.Run(captures, start_position, sticky, zone);
+  }
+  NfaSimulation<uint16_t> simulation(
+      program, subject,
+      [](const String& subject) -> const uint16_t* {
+        return TwoByteString::DataStart(subject);
+      },
+      zone);
+  return simulation.Run(captures, start_position, sticky, zone);
+}
+
+}  // namespace dart
@@ -0,0 +1,50 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// A regexp matcher simulating the NFA of a pattern, in time linear in the
+// length of the subject.
+
+#ifndef RUNTIME_VM_REGEXP_REGEXP_NFA_H_
+#define RUNTIME_VM_REGEXP_REGEXP_NFA_H_
+
+#include "vm/allocation.h"
+#include "vm/object.h"
+#include "vm/zone.h"
+
+namespace dart {
+
+class RegExpTree;
+
+// Runs all alternatives of a pattern in lockstep over the subject, keeping at
+// most one thread per program location, so the backtracking interpreter's
+// exponential blowup cannot happen. Threads are kept in priority order,
+// which gives the same matches and captures as backtracking.
+//
+// Only patterns without backreferences and lookarounds, in non-unicode
+// mode, can be compiled. Quantified expressions must not be able to match
+// the empty string, as ECMAScript's empty check cannot be expressed in the
+// NFA.
+class RegExpNfa : public AllStatic {
+ public:
+  // Compiles the parsed pattern [tree] for one-byte or two-byte subjects.
+  // Returns null if the pattern is not supported.
+  static TypedDataPtr Compile(RegExpTree* tree,
+                              RegExpFlags flags,
+                              intptr_t capture_count,
+                              bool is_one_byte,
+                              Zone* zone);
+
+  // Returns True in case of a success, False in case of a failure,
+  // Error in case VM error has to propagated up to the caller.
+  static ObjectPtr Match(const TypedData& program,
+                         const String& subject,
+                         int32_t* captures,
+                         intptr_t start_position,
+                         bool sticky,
+                         Zone* zone);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_REGEXP_REGEXP_NFA_H_
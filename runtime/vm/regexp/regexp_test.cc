@@ -7,6 +7,7 @@
 #include "vm/isolate.h"
 #include "vm/object.h"
 #include "vm/regexp/regexp.h"
+#include "vm/regexp/regexp_assembler_bytecode.h"
 #include "vm/regexp/regexp_assembler_ir.h"
 #include "vm/unit_test.h"
 
@@ -66,4 +67,174 @@ ISOLATE_UNIT_TEST_CASE(RegExp_TwoByteString) {
   EXPECT_EQ(3, smi_2.Value());
 }
 
+DECLARE_FLAG(bool, regexp_nfa);
+
+// Creates a regexp for the bytecode interpreter, which must be enabled
+// while it is used.
+static RegExpPtr CreateInterpretedRegExp(Thread* thread,
+                                         const char* pattern,
+                                         RegExpFlags flags = RegExpFlags()) {
+  ASSERT(FLAG_interpret_irregexp);
+  const String& pat = String::Handle(
+      Symbols::New(thread, String::Handle(String::New(pattern))));
+  return RegExpEngine::CreateRegExp(thread, pat, flags);
+}
+
+static TypedDataPtr Interpret(const RegExp& regexp,
+                              const String& str,
+                              intptr_t start_index,
+                              bool sticky) {
+  Zone* zone = Thread::Current()->zone();
+  const Smi& idx = Smi::Handle(zone, Smi::New(start_index));
+  return static_cast<TypedDataPtr>(BytecodeRegExpMacroAssembler::Interpret(
+      regexp, str, idx, sticky, zone));
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_SimplePattern) {
+  SetFlagScope<bool> sfs(&FLAG_interpret_irregexp, true);
+  const RegExp& regexp =
+      RegExp::Handle(CreateInterpretedRegExp(thread, "bc"));
+  uint16_t chars[] = {'a', 'b', 'c', 'b', 'c', 0x1234};
+  const String& one_byte_str = String::Handle(String::New("abcbc"));
+  const String& two_byte_str =
+      String::Handle(TwoByteString::New(chars, ARRAY_SIZE(chars), Heap::kNew));
+
+  TypedData& res = TypedData::Handle(Interpret(regexp, one_byte_str, 0, false));
+  EXPECT(regexp.is_simple());
+  EXPECT(!res.IsNull());
+  EXPECT_EQ(2, res.Length());
+  EXPECT_EQ(1, res.GetInt32(0));
+  EXPECT_EQ(3, res.GetInt32(sizeof(int32_t)));
+
+  res = Interpret(regexp, two_byte_str, 2, false);
+  EXPECT(!res.IsNull());
+  EXPECT_EQ(3, res.GetInt32(0));
+  EXPECT_EQ(5, res.GetInt32(sizeof(int32_t)));
+
+  res = Interpret(regexp, one_byte_str, 3, true);
+  EXPECT(!res.IsNull());
+  EXPECT_EQ(3, res.GetInt32(0));
+  EXPECT_EQ(5, res.GetInt32(sizeof(int32_t)));
+
+  res = Interpret(regexp, one_byte_str, 2, true);
+  EXPECT(res.IsNull());
+  res = Interpret(regexp, two_byte_str, 4, false);
+  EXPECT(res.IsNull());
+}
+
+// Matches [pattern] by NFA simulation and by backtracking, and expects the
+// same captures.
+static void ExpectSameMatch(Thread* thread,
+                            const char* pattern,
+                            RegExpFlags flags,
+                            const String& subject,
+                            intptr_t start_index = 0,
+                            bool sticky = false) {
+  SetFlagScope<bool> sfs(&FLAG_interpret_irregexp, true);
+  TypedData& expected = TypedData::Handle();
+  {
+    SetFlagScope<bool> disable_nfa(&FLAG_regexp_nfa, false);
+    const RegExp& regexp =
+        RegExp::Handle(CreateInterpretedRegExp(thread, pattern, flags));
+    expected = Interpret(regexp, subject, start_index, sticky);
+    EXPECT(!regexp.is_linear());
+  }
+  const RegExp& regexp =
+      RegExp::Handle(CreateInterpretedRegExp(thread, pattern, flags));
+  const TypedData& actual =
+      TypedData::Handle(Interpret(regexp, subject, start_index, sticky));
+  EXPECT(regexp.is_linear());
+  EXPECT_EQ(expected.IsNull(), actual.IsNull());
+  if (expected.IsNull() || actual.IsNull()) return;
+  EXPECT_EQ(expected.Length(), actual.Length());
+  for (intptr_t i = 0; i < expected.Length() && i < actual.Length(); i++) {
+    EXPECT_EQ(expected.GetInt32(i * sizeof(int32_t)),
+              actual.GetInt32(i * sizeof(int32_t)));
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_NfaMatchesLikeBacktracking) {
+  const String& abcd = String::Handle(String::New("abcd"));
+  ExpectSameMatch(thread, "(a|ab)(c|bcd)(d*)", RegExpFlags(), abcd);
+  ExpectSameMatch(thread, "b+?c?", RegExpFlags(), abcd);
+  ExpectSameMatch(thread, "[b-c]{1,2}d|x", RegExpFlags(), abcd, 1, true);
+  ExpectSameMatch(thread, "[b-c]{1,2}d|x", RegExpFlags(), abcd, 0, true);
+  ExpectSameMatch(thread, "(?:ab|cd)+$", RegExpFlags(), abcd);
+
+  // Captures in a quantified group are reset on each iteration.
+  const String& abab = String::Handle(String::New("abab"));
+  ExpectSameMatch(thread, "((a)|b)+", RegExpFlags(), abab);
+  ExpectSameMatch(thread, "(?:(a)|(b)){2,3}?", RegExpFlags(), abab);
+
+  RegExpFlags ignore_case;
+  ignore_case.SetIgnoreCase();
+  const String& upper = String::Handle(String::New("xx ABC1 Abc2"));
+  ExpectSameMatch(thread, "[a-c]+\\d", ignore_case, upper);
+  ExpectSameMatch(thread, "[^a]b", ignore_case, upper);
+  ExpectSameMatch(thread, "\\bab\\w*", ignore_case, upper, 4);
+
+  RegExpFlags multi_line;
+  multi_line.SetMultiLine();
+  const String& lines = String::Handle(String::New("a\nbcd\r\ne"));
+  ExpectSameMatch(thread, "^b\\w*$", multi_line, lines);
+  ExpectSameMatch(thread, "^b\\w*$", RegExpFlags(), lines);
+  ExpectSameMatch(thread, "a.b", RegExpFlags(), lines);
+  RegExpFlags dot_all;
+  dot_all.SetDotAll();
+  ExpectSameMatch(thread, "a.b", dot_all, lines);
+
+  uint16_t chars[] = {'x', 0x1234, 'a', 0x1235, 0x1234, 'a'};
+  const String& two_byte_str =
+      String::Handle(TwoByteString::New(chars, ARRAY_SIZE(chars), Heap::kNew));
+  ExpectSameMatch(thread, "[\\u1234-\\u1235]+a", RegExpFlags(),
+                  two_byte_str);
+  ExpectSameMatch(thread, "[^x]a(\\u1234)?", RegExpFlags(), two_byte_str, 2);
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_NfaLinearTime) {
+  SetFlagScope<bool> sfs(&FLAG_interpret_irregexp, true);
+  // Backtracking takes time exponential in the number of 'a's.
+  const RegExp& regexp =
+      RegExp::Handle(CreateInterpretedRegExp(thread, "(a+)+b"));
+  const intptr_t kLength = 10000;
+  uint8_t* chars = thread->zone()->Alloc<uint8_t>(kLength);
+  memset(chars, 'a', kLength - 1);
+  chars[kLength - 1] = 'c';
+  const String& str =
+      String::Handle(OneByteString::New(chars, kLength, Heap::kNew));
+  TypedData& res = TypedData::Handle(Interpret(regexp, str, 0, false));
+  EXPECT(regexp.is_linear());
+  EXPECT(res.IsNull());
+
+  chars[kLength - 1] = 'b';
+  const String& matching_str =
+      String::Handle(OneByteString::New(chars, kLength, Heap::kNew));
+  res = Interpret(regexp, matching_str, 0, false);
+  EXPECT(!res.IsNull());
+  EXPECT_EQ(4, res.Length());
+  EXPECT_EQ(0, res.GetInt32(0));
+  EXPECT_EQ(kLength, res.GetInt32(sizeof(int32_t)));
+  EXPECT_EQ(0, res.GetInt32(2 * sizeof(int32_t)));
+  EXPECT_EQ(kLength - 1, res.GetInt32(3 * sizeof(int32_t)));
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_NfaUnsupportedPatterns) {
+  SetFlagScope<bool> sfs(&FLAG_interpret_irregexp, true);
+  const String& str = String::Handle(String::New("aab"));
+  const char* patterns[] = {"(a)\\1", "a(?=b)", "(?<=a)b", "(a*)*b"};
+  for (intptr_t i = 0; i < ARRAY_SIZE(patterns); i++) {
+    const RegExp& regexp =
+        RegExp::Handle(CreateInterpretedRegExp(thread, patterns[i]));
+    const TypedData& res = TypedData::Handle(Interpret(regexp, str, 0, false));
+    EXPECT(!res.IsNull());
+    EXPECT(regexp.is_complex());
+  }
+  RegExpFlags unicode;
+  unicode.SetUnicode();
+  const RegExp& regexp =
+      RegExp::Handle(CreateInterpretedRegExp(thread, "a+b", unicode));
+  EXPECT(!TypedData::Handle(Interpret(regexp, str, 0, false)).IsNull());
+  EXPECT(regexp.is_complex());
+}
+
 }  // namespace dart
@@ -0,0 +1,66 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/shared_typed_data.h"
+
+#include "platform/assert.h"
+#include "vm/heap/heap.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+std::atomic<intptr_t> SharedTypedDataStore::live_stores_ = {0};
+
+SharedTypedDataStore* SharedTypedDataStore::New(intptr_t length_in_bytes) {
+  auto data = static_cast<uint8_t*>(
+      calloc(length_in_bytes > 0 ? length_in_bytes : 1, sizeof(uint8_t)));
+  if (data == nullptr) {
+    return nullptr;
+  }
+  live_stores_.fetch_add(1, std::memory_order_relaxed);
+  return new SharedTypedDataStore(data, length_in_bytes);
+}
+
+SharedTypedDataStore* SharedTypedDataStore::Of(
+    ExternalTypedDataPtr typed_data) {
+  // Typed data reaching us from another thread got here along with the store
+  // it refers to, so a store it holds is counted.
+  if (live_stores_.load(std::memory_order_relaxed) == 0) {
+    return nullptr;
+  }
+  return static_cast<SharedTypedDataStore*>(
+      Thread::Current()->heap()->GetSharedTypedDataStore(typed_data));
+}
+
+void SharedTypedDataStore::Attach(ExternalTypedDataPtr typed_data,
+                                  SharedTypedDataStore* store) {
+  ASSERT(store->ref_count_.load(std::memory_order_relaxed) > 0);
+  Thread::Current()->heap()->SetSharedTypedDataStore(typed_data, store);
+}
+
+void SharedTypedDataStore::Finalizer(void* isolate_callback_data, void* peer) {
+  static_cast<SharedTypedDataStore*>(peer)->Release();
+}
+
+void SharedTypedDataStore::Retain() {
+  const intptr_t old_count =
+      ref_count_.fetch_add(1, std::memory_order_relaxed);
+  ASSERT(old_count > 0);
+}
+
+void SharedTypedDataStore::Release() {
+  const intptr_t old_count =
+      ref_count_.fetch_sub(1, std::memory_order_acq_rel);
+  ASSERT(old_count > 0);
+  if (old_count == 1) {
+    delete this;
+  }
+}
+
+SharedTypedDataStore::~SharedTypedDataStore() {
+  free(data_);
+  live_stores_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+}  // namespace dart
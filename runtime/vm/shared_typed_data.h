@@ -0,0 +1,67 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_SHARED_TYPED_DATA_H_
+#define RUNTIME_VM_SHARED_TYPED_DATA_H_
+
+#include <atomic>
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+#include "vm/tagged_pointer.h"
+
+namespace dart {
+
+// The backing store of external typed data created through
+// `SharedTypedData` in dart:concurrent.
+//
+// Messages refer to a shared backing store instead of copying it: each
+// typed data object on it, in whichever isolate, holds a reference that its
+// finalizer drops. The store is freed once the last reference is gone.
+//
+// The objects holding a reference are tagged with the store in the heap, so
+// other external typed data over the same memory, e.g. from
+// Pointer.asTypedList, is still copied.
+class SharedTypedDataStore : public MallocAllocated {
+ public:
+  // Allocates a zero-initialized store holding one reference, or returns
+  // nullptr if out of memory.
+  static SharedTypedDataStore* New(intptr_t length_in_bytes);
+
+  // Returns the store [typed_data] holds a reference to, or nullptr.
+  static SharedTypedDataStore* Of(ExternalTypedDataPtr typed_data);
+
+  // Tags [typed_data], which was created over the memory of [store], as
+  // holding one of the store's references.
+  static void Attach(ExternalTypedDataPtr typed_data,
+                     SharedTypedDataStore* store);
+
+  // A Dart_HandleFinalizer dropping the reference held by [peer].
+  static void Finalizer(void* isolate_callback_data, void* peer);
+
+  uint8_t* data() const { return data_; }
+  intptr_t length_in_bytes() const { return length_in_bytes_; }
+
+  void Retain();
+  void Release();
+
+ private:
+  SharedTypedDataStore(uint8_t* data, intptr_t length_in_bytes)
+      : data_(data), length_in_bytes_(length_in_bytes), ref_count_(1) {}
+  ~SharedTypedDataStore();
+
+  uint8_t* const data_;
+  const intptr_t length_in_bytes_;
+  std::atomic<intptr_t> ref_count_;
+
+  // Number of stores alive, so that sending typed data does not look for a
+  // store while there are none.
+  static std::atomic<intptr_t> live_stores_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedTypedDataStore);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_SHARED_TYPED_DATA_H_
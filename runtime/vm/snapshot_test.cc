@@ -2049,6 +2049,125 @@ VM_UNIT_TEST_CASE(PostCObject) {
   Dart_ExitScope();
 }
 
+ISOLATE_UNIT_TEST_CASE(SerializeLargeTypedDataFromC) {
+  // Large typed data from C is handed over as external typed data.
+  const intptr_t kLength = 128 * KB;
+  uint8_t* data = reinterpret_cast<uint8_t*>(malloc(kLength));
+  for (intptr_t i = 0; i < kLength; i++) {
+    data[i] = i & 0xff;
+  }
+  Dart_CObject root;
+  root.type = Dart_CObject_kTypedData;
+  root.value.as_typed_data.type = Dart_TypedData_kUint8;
+  root.value.as_typed_data.length = kLength;
+  root.value.as_typed_data.values = data;
+
+  {
+    std::unique_ptr<Message> message = WriteApiMessage(
+        thread->zone(), &root, ILLEGAL_PORT, Message::kNormalPriority);
+    ExternalTypedData& serialized = ExternalTypedData::Handle();
+    serialized ^= ReadMessage(thread, message.get());
+    EXPECT_EQ(kLength, serialized.Length());
+    EXPECT(serialized.DataAddr(0) != data);
+    for (intptr_t i = 0; i < kLength; i++) {
+      EXPECT_EQ(i & 0xff, serialized.GetUint8(i));
+    }
+  }
+
+  {
+    ApiNativeScope scope;
+    CheckEncodeDecodeMessage(scope.zone(), &root);
+  }
+  free(data);
+}
+
+ISOLATE_UNIT_TEST_CASE(ApiMessageBuilder) {
+  const char* kLatin1 = "æøå";
+  const char* kUtf16 = "€uro";
+  const intptr_t kLength = 100;
+
+  auto build = [&](ApiMessageBuilder* builder) {
+    intptr_t list = builder->AddArray(9);
+    uint8_t* bytes = nullptr;
+    intptr_t typed_data =
+        builder->AddTypedData(Dart_TypedData_kUint8, kLength, &bytes);
+    for (intptr_t i = 0; i < kLength; i++) {
+      bytes[i] = i;
+    }
+    intptr_t elements[] = {
+        builder->AddNull(),
+        builder->AddBool(true),
+        builder->AddInt64(42),
+        builder->AddInt64(kMaxInt64),
+        builder->AddDouble(3.14),
+        builder->AddString(kLatin1, strlen(kLatin1)),
+        builder->AddString(kUtf16, strlen(kUtf16)),
+        typed_data,
+        list,
+    };
+    for (intptr_t i = 0; i < 9; i++) {
+      EXPECT(builder->SetArrayElement(list, i, elements[i]));
+    }
+    EXPECT(!builder->SetArrayElement(list, 9, elements[0]));
+    EXPECT(!builder->SetArrayElement(typed_data, 0, elements[0]));
+    EXPECT_EQ(ApiMessageBuilder::kIllegalObject,
+              builder->AddString("\xff", 1));
+    EXPECT_EQ(ApiMessageBuilder::kIllegalObject, builder->AddArray(-1));
+    return builder->Finish(list, ILLEGAL_PORT, Message::kNormalPriority);
+  };
+
+  {
+    ApiMessageBuilder builder;
+    std::unique_ptr<Message> message = build(&builder);
+    Array& array = Array::Handle();
+    array ^= ReadMessage(thread, message.get());
+    EXPECT_EQ(9, array.Length());
+    EXPECT(array.At(0) == Object::null());
+    EXPECT(array.At(1) == Bool::True().ptr());
+    EXPECT_EQ(42, Smi::Value(Smi::RawCast(array.At(2))));
+    EXPECT_EQ(kMaxInt64,
+              Integer::Handle(Integer::RawCast(array.At(3))).Value());
+    EXPECT_EQ(3.14, Double::Handle(Double::RawCast(array.At(4))).value());
+    EXPECT(String::Handle(String::RawCast(array.At(5))).Equals(kLatin1));
+    EXPECT(String::Handle(String::RawCast(array.At(6))).Equals(kUtf16));
+    ExternalTypedData& typed_data = ExternalTypedData::Handle();
+    typed_data ^= array.At(7);
+    EXPECT_EQ(kLength, typed_data.Length());
+    for (intptr_t i = 0; i < kLength; i++) {
+      EXPECT_EQ(i, typed_data.GetUint8(i));
+    }
+    EXPECT(array.At(8) == array.ptr());
+  }
+
+  {
+    ApiMessageBuilder builder;
+    std::unique_ptr<Message> message = build(&builder);
+    ApiNativeScope scope;
+    Dart_CObject* root = ReadApiMessage(scope.zone(), message.get());
+    EXPECT_EQ(Dart_CObject_kArray, root->type);
+    EXPECT_EQ(9, root->value.as_array.length);
+    Dart_CObject** values = root->value.as_array.values;
+    EXPECT_EQ(Dart_CObject_kNull, values[0]->type);
+    EXPECT(values[1]->value.as_bool);
+    EXPECT_EQ(42, values[2]->value.as_int32);
+    EXPECT_EQ(kMaxInt64, values[3]->value.as_int64);
+    EXPECT_EQ(3.14, values[4]->value.as_double);
+    EXPECT_STREQ(kLatin1, values[5]->value.as_string);
+    EXPECT_STREQ(kUtf16, values[6]->value.as_string);
+    EXPECT_EQ(Dart_CObject_kTypedData, values[7]->type);
+    EXPECT_EQ(kLength, values[7]->value.as_typed_data.length);
+    EXPECT_EQ(kLength - 1, values[7]->value.as_typed_data.values[kLength - 1]);
+    EXPECT(values[8] == root);
+  }
+
+  // Data allocated by a builder that is never finished is freed with it.
+  ApiMessageBuilder unfinished;
+  uint8_t* bytes = nullptr;
+  unfinished.AddTypedData(Dart_TypedData_kFloat64, kLength, &bytes);
+  EXPECT(unfinished.Finish(kLength, ILLEGAL_PORT, Message::kNormalPriority) ==
+         nullptr);
+}
+
 TEST_CASE(IsKernelNegative) {
   EXPECT(!Dart_IsKernel(nullptr, 0));
 
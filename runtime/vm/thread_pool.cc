@@ -7,6 +7,7 @@
 #include "vm/dart.h"
 #include "vm/flags.h"
 #include "vm/lockers.h"
+#include "vm/os.h"
 
 namespace dart {
 
@@ -15,6 +16,34 @@ DEFINE_FLAG(int,
             5000,
             "Free workers when they have been idle for this amount of time.");
 
+DEFINE_FLAG(int,
+            worker_spin_micros,
+            50,
+            "How long idle workers look for new tasks before they go to sleep "
+            "(0 to sleep right away).");
+
+// After running this many tasks from its own queue a worker looks at the
+// shared queue, so that tasks without affinity are not starved.
+static constexpr intptr_t kMaxLocalTasksInARow = 8;
+
+// Bounds the iterations of a worker spinning for new tasks, in case the clock
+// is coarse. The spin otherwise ends after FLAG_worker_spin_micros.
+static constexpr intptr_t kMaxSpinIterations = 16 * KB;
+// The clock is read once per this many iterations.
+static constexpr intptr_t kSpinIterationsPerClockRead = 16;
+
+// Tells the CPU that the thread is spinning, so that it saves power and
+// leaves execution resources to another hardware thread on the same core.
+static inline void SpinPause() {
+#if defined(HOST_ARCH_IA32) || defined(HOST_ARCH_X64)
+  __builtin_ia32_pause();
+#elif defined(HOST_ARCH_ARM) || defined(HOST_ARCH_ARM64)
+  asm volatile("yield");
+#endif
+}
+
+std::atomic<intptr_t> ThreadPool::Worker::next_id_ = {kNoAffinity + 1};
+
 static int64_t ComputeTimeout(int64_t idle_start) {
   int64_t worker_timeout_micros =
       FLAG_worker_timeout_millis * kMicrosecondsPerMillisecond;
@@ -117,14 +146,16 @@ void ThreadPool::DeleteLastDeadWorker() {
   last_dead_worker_ = nullptr;
 }
 
-bool ThreadPool::RunImpl(std::unique_ptr<Task> task) {
+bool ThreadPool::RunImpl(std::unique_ptr<Task> task,
+                         intptr_t worker_id,
+                         Priority priority) {
   Worker* new_worker = nullptr;
   {
     MutexLocker ml(&pool_mutex_);
     if (shutting_down_) {
       return false;
     }
-    new_worker = ScheduleTaskLocked(std::move(task));
+    new_worker = ScheduleTaskLocked(std::move(task), worker_id, priority);
   }
   if (new_worker != nullptr) {
     new_worker->StartThread();
@@ -138,6 +169,16 @@ bool ThreadPool::CurrentThreadIsWorker() {
   return worker != nullptr && worker->pool_ == this;
 }
 
+intptr_t ThreadPool::CurrentWorkerId() {
+  auto worker =
+      static_cast<Worker*>(OSThread::Current()->owning_thread_pool_worker_);
+  return worker != nullptr ? worker->id_ : kNoAffinity;
+}
+
+bool ThreadPool::HasPendingTasks() {
+  return pending_tasks_.load(std::memory_order_relaxed) > 0;
+}
+
 void ThreadPool::MarkCurrentWorkerAsBlocked() {
   MarkWorkerAsBlocked(OSThread::Current());
 }
@@ -149,6 +190,11 @@ void ThreadPool::MarkWorkerAsBlocked(OSThread* thread) {
     MutexLocker ml(&pool_mutex_);
     ASSERT(!worker->is_blocked_);
     worker->is_blocked_ = true;
+    // Tasks waiting for this worker are up for grabs.
+    while (!worker->local_tasks_.IsEmpty()) {
+      tasks_[kNormalPriority].Append(worker->local_tasks_.RemoveFirst());
+    }
+    worker->local_task_count_ = 0;
     if (max_pool_size_ > 0) {
       ++max_pool_size_;
       // This thread is blocked and therefore no longer usable as a worker.
@@ -183,8 +229,35 @@ void ThreadPool::MarkCurrentWorkerAsUnBlocked() {
   }
 }
 
-std::unique_ptr<ThreadPool::Task> ThreadPool::TakeNextAvailableTaskLocked() {
-  std::unique_ptr<Task> task(tasks_.RemoveFirst());
+std::unique_ptr<ThreadPool::Task> ThreadPool::TakeNextAvailableTaskLocked(
+    Worker* worker) {
+  ASSERT(pending_tasks_ > 0);
+  Task* next = nullptr;
+  // Tasks with affinity are all of normal priority, so tasks of higher
+  // priority go first.
+  for (intptr_t i = 0; i < kNormalPriority; i++) {
+    if (!tasks_[i].IsEmpty()) {
+      next = tasks_[i].RemoveFirst();
+      break;
+    }
+  }
+  TaskList& normal_tasks = tasks_[kNormalPriority];
+  if (next != nullptr) {
+    // Found above.
+  } else if (!worker->local_tasks_.IsEmpty() &&
+             (normal_tasks.IsEmpty() ||
+              worker->local_tasks_in_a_row_ < kMaxLocalTasksInARow)) {
+    next = worker->local_tasks_.RemoveFirst();
+    worker->local_task_count_--;
+    worker->local_tasks_in_a_row_++;
+  } else if (!normal_tasks.IsEmpty()) {
+    next = normal_tasks.RemoveFirst();
+    worker->local_tasks_in_a_row_ = 0;
+  } else {
+    next = StealTaskLocked(worker);
+  }
+  ASSERT(next != nullptr);
+  std::unique_ptr<Task> task(next);
   pending_tasks_--;
   if (pending_tasks_ > 0 && !idle_workers_.IsEmpty()) {
     // Wake up one more worker if more tasks are left.
@@ -193,16 +266,39 @@ std::unique_ptr<ThreadPool::Task> ThreadPool::TakeNextAvailableTaskLocked() {
   return task;
 }
 
+ThreadPool::Task* ThreadPool::StealTaskLocked(Worker* thief) {
+  // Take the oldest task of the worker which has fallen behind the most.
+  Worker* victim = nullptr;
+  for (auto worker : running_workers_) {
+    if (victim == nullptr ||
+        worker->local_task_count_ > victim->local_task_count_) {
+      victim = worker;
+    }
+  }
+  for (auto worker : idle_workers_) {
+    if (victim == nullptr ||
+        worker->local_task_count_ > victim->local_task_count_) {
+      victim = worker;
+    }
+  }
+  if (victim == nullptr || victim->local_tasks_.IsEmpty()) {
+    return nullptr;
+  }
+  ASSERT(victim != thief);
+  victim->local_task_count_--;
+  return victim->local_tasks_.RemoveFirst();
+}
+
 void ThreadPool::WorkerLoop(Worker* worker) {
   Worker* previous_dead_worker = nullptr;
 
   while (true) {
     MutexLocker ml(&pool_mutex_);
 
-    if (!tasks_.IsEmpty()) {
+    if (pending_tasks_ > 0) {
       IdleToRunningLocked(worker);
-      while (!tasks_.IsEmpty()) {
-        auto task = TakeNextAvailableTaskLocked();
+      while (pending_tasks_ > 0) {
+        auto task = TakeNextAvailableTaskLocked(worker);
         MutexUnlocker mls(&ml);
         task->Run();
         ASSERT(Isolate::Current() == nullptr);
@@ -212,9 +308,9 @@ void ThreadPool::WorkerLoop(Worker* worker) {
     }
 
     if (running_workers_.IsEmpty()) {
-      ASSERT(tasks_.IsEmpty());
+      ASSERT(pending_tasks_ == 0);
       OnEnterIdleLocked(&ml, worker);
-      if (!tasks_.IsEmpty()) {
+      if (pending_tasks_ > 0) {
         continue;
       }
     }
@@ -224,6 +320,10 @@ void ThreadPool::WorkerLoop(Worker* worker) {
       break;
     }
 
+    if (SpinForTasksLocked(&ml)) {
+      continue;
+    }
+
     // Sleep until we get a new task, we time out or we're shutdown.
     const int64_t idle_start = OS::GetCurrentMonotonicMicros();
     bool done = false;
@@ -231,7 +331,7 @@ void ThreadPool::WorkerLoop(Worker* worker) {
       const auto result = worker->Sleep(ComputeTimeout(idle_start));
 
       // We have to drain all pending tasks.
-      if (!tasks_.IsEmpty()) break;
+      if (pending_tasks_ > 0) break;
 
       if (shutting_down_ || result == ConditionVariable::kTimedOut) {
         done = true;
@@ -251,6 +351,36 @@ void ThreadPool::WorkerLoop(Worker* worker) {
   JoinDeadWorker(previous_dead_worker);
 }
 
+bool ThreadPool::SpinForTasksLocked(MutexLocker* ml) {
+  ASSERT(!shutting_down_);
+  if (FLAG_worker_spin_micros <= 0) {
+    return false;
+  }
+  // Tasks arriving shortly after the last ones finished are common, e.g.
+  // messages going back and forth between isolates. Waking up a sleeping
+  // worker for them takes longer than watching for them for a bit.
+  count_spinning_++;
+  {
+    // Spin without holding the pool_mutex_, so that tasks can be scheduled.
+    MutexUnlocker mls(ml);
+    const int64_t end =
+        OS::GetCurrentMonotonicMicros() + FLAG_worker_spin_micros;
+    for (intptr_t i = 1; i <= kMaxSpinIterations; i++) {
+      if (pending_tasks_.load(std::memory_order_relaxed) > 0) {
+        break;
+      }
+      SpinPause();
+      if ((i % kSpinIterationsPerClockRead) == 0 &&
+          OS::GetCurrentMonotonicMicros() >= end) {
+        break;
+      }
+    }
+  }
+  count_spinning_--;
+  // Spinning workers are not woken up by shutdown requests either.
+  return pending_tasks_ > 0 || shutting_down_;
+}
+
 void ThreadPool::IdleToRunningLocked(Worker* worker) {
   ASSERT(idle_workers_.ContainsForDebugging(worker));
   idle_workers_.Remove(worker);
@@ -260,7 +390,7 @@ void ThreadPool::IdleToRunningLocked(Worker* worker) {
 }
 
 void ThreadPool::RunningToIdleLocked(Worker* worker) {
-  ASSERT(tasks_.IsEmpty());
+  ASSERT(pending_tasks_ == 0);
 
   ASSERT(running_workers_.ContainsForDebugging(worker));
   running_workers_.Remove(worker);
@@ -270,7 +400,8 @@ void ThreadPool::RunningToIdleLocked(Worker* worker) {
 }
 
 ThreadPool::Worker* ThreadPool::IdleToDeadLocked(Worker* worker) {
-  ASSERT(tasks_.IsEmpty());
+  ASSERT(pending_tasks_ == 0);
+  ASSERT(worker->local_tasks_.IsEmpty());
   Worker* previous_dead = last_dead_worker_;
 
   ASSERT(idle_workers_.ContainsForDebugging(worker));
@@ -297,12 +428,51 @@ void ThreadPool::JoinDeadWorker(Worker* worker) {
   }
 }
 
-ThreadPool::Worker* ThreadPool::ScheduleTaskLocked(std::unique_ptr<Task> task) {
+bool ThreadPool::ScheduleOnWorkerLocked(std::unique_ptr<Task>* task,
+                                        intptr_t worker_id) {
+  for (auto worker : idle_workers_) {
+    if (worker->id_ == worker_id) {
+      worker->local_tasks_.Append(task->release());
+      worker->local_task_count_++;
+      pending_tasks_++;
+      worker->Wakeup();
+      return true;
+    }
+  }
+  // A worker which schedules a task for itself gets to it once its current
+  // task returns. Any other running worker may not get to the task for a long
+  // time, so the task is then scheduled like one without affinity, which also
+  // starts a new worker if needed.
+  auto current =
+      static_cast<Worker*>(OSThread::Current()->owning_thread_pool_worker_);
+  if (current != nullptr && current->pool_ == this &&
+      current->id_ == worker_id && !current->is_blocked_) {
+    current->local_tasks_.Append(task->release());
+    current->local_task_count_++;
+    pending_tasks_++;
+    return true;
+  }
+  return false;
+}
+
+ThreadPool::Worker* ThreadPool::ScheduleTaskLocked(std::unique_ptr<Task> task,
+                                                   intptr_t worker_id,
+                                                   Priority priority) {
+  ASSERT(worker_id == kNoAffinity || priority == kNormalPriority);
+  if (worker_id != kNoAffinity && ScheduleOnWorkerLocked(&task, worker_id)) {
+    return nullptr;
+  }
+
   // Enqueue the new task.
-  tasks_.Append(task.release());
+  tasks_[priority].Append(task.release());
   pending_tasks_++;
   ASSERT(pending_tasks_ >= 1);
 
+  // Spinning workers pick up tasks without being woken up.
+  if (count_spinning_ >= pending_tasks_) {
+    return nullptr;
+  }
+
   // Notify existing idle worker (if available).
   if (count_idle_ >= pending_tasks_) {
     ASSERT(!idle_workers_.IsEmpty());
@@ -331,7 +501,9 @@ ThreadPool::Worker* ThreadPool::ScheduleTaskLocked(std::unique_ptr<Task> task) {
 }
 
 ThreadPool::Worker::Worker(ThreadPool* pool)
-    : pool_(pool), join_id_(OSThread::kInvalidThreadJoinId) {}
+    : pool_(pool),
+      id_(next_id_.fetch_add(1, std::memory_order_relaxed)),
+      join_id_(OSThread::kInvalidThreadJoinId) {}
 
 void ThreadPool::Worker::StartThread() {
   OSThread::Start("DartWorker", &Worker::Main, reinterpret_cast<uword>(this));
@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_THREAD_POOL_H_
 #define RUNTIME_VM_THREAD_POOL_H_
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -35,6 +36,17 @@ class ThreadPool {
     DISALLOW_COPY_AND_ASSIGN(Task);
   };
 
+  // Passed to [RunWithAffinity] when the task may run on any worker.
+  static constexpr intptr_t kNoAffinity = 0;
+
+  // Classes of tasks, in the order in which waiting tasks are started.
+  enum Priority {
+    kGCPriority,        // Helpers of the garbage collector.
+    kCompilerPriority,  // Background compilation.
+    kNormalPriority,    // Message handling and everything else.
+    kNumPriorities,
+  };
+
   explicit ThreadPool(uintptr_t max_pool_size = 0);
 
   // Prevent scheduling of new tasks, wait until all pending tasks are done
@@ -46,7 +58,33 @@ class ThreadPool {
   bool Run(Args&&... args) {
     return RunImpl(std::unique_ptr<Task>(new T(std::forward<Args>(args)...)));
   }
-  bool Run(Task* task) { return RunImpl(std::unique_ptr<Task>(task)); }
+  bool Run(Task* task, Priority priority = kNormalPriority) {
+    return RunImpl(std::unique_ptr<Task>(task), kNoAffinity, priority);
+  }
+
+  // Runs a task on the thread pool, before waiting tasks of lower priority.
+  template <typename T, typename... Args>
+  bool RunWithPriority(Priority priority, Args&&... args) {
+    return RunImpl(std::unique_ptr<Task>(new T(std::forward<Args>(args)...)),
+                   kNoAffinity, priority);
+  }
+
+  // Runs a task on the thread pool, preferably on the worker with the given
+  // id (see [CurrentWorkerId]) whose caches may still hold the task's data.
+  // The task only waits for that worker if it is idle or is the current
+  // thread, and other workers steal it if they run out of work first.
+  template <typename T, typename... Args>
+  bool RunWithAffinity(intptr_t worker_id, Args&&... args) {
+    return RunImpl(std::unique_ptr<Task>(new T(std::forward<Args>(args)...)),
+                   worker_id);
+  }
+
+  // Returns the id of the thread pool worker running on the current thread,
+  // or [kNoAffinity] if the current thread is not a thread pool worker.
+  static intptr_t CurrentWorkerId();
+
+  // Returns `true` if there are tasks waiting for a worker.
+  bool HasPendingTasks();
 
   // Returns `true` if the current thread is running on the [this] thread pool.
   bool CurrentThreadIsWorker();
@@ -79,6 +117,8 @@ class ThreadPool {
   // Exposed for unit test in thread_pool_test.cc
   uint64_t workers_started() const { return count_idle_ + count_running_; }
   // Exposed for unit test in thread_pool_test.cc
+  uint64_t workers_idle() const { return count_idle_; }
+  // Exposed for unit test in thread_pool_test.cc
   bool has_pending_dead_worker() const { return last_dead_worker_ != nullptr; }
 
  protected:
@@ -105,11 +145,21 @@ class ThreadPool {
     // Fields initialized during construction or in start of main function of
     // thread.
     ThreadPool* pool_;
+    const intptr_t id_;
     ThreadJoinId join_id_;
     OSThread* os_thread_ = nullptr;
     bool is_blocked_ = false;
     ConditionVariable wakeup_cv_;
 
+    // Tasks scheduled with an affinity to this worker. Protected by the
+    // pool's mutex.
+    IntrusiveDList<Task> local_tasks_;
+    intptr_t local_task_count_ = 0;
+    // Number of local tasks run since the shared queue was last looked at.
+    intptr_t local_tasks_in_a_row_ = 0;
+
+    static std::atomic<intptr_t> next_id_;
+
     DISALLOW_COPY_AND_ASSIGN(Worker);
   };
 
@@ -123,7 +173,7 @@ class ThreadPool {
   bool ShuttingDownLocked() { return shutting_down_; }
 
   // Whether new tasks are ready to be run.
-  bool TasksWaitingToRunLocked() { return !tasks_.IsEmpty(); }
+  bool TasksWaitingToRunLocked() { return pending_tasks_ > 0; }
 
  private:
   static void WorkerThreadExit(ThreadPool* pool, ThreadPool::Worker* worker);
@@ -131,12 +181,22 @@ class ThreadPool {
   using TaskList = IntrusiveDList<Task>;
   using WorkerList = IntrusiveDList<Worker>;
 
-  bool RunImpl(std::unique_ptr<Task> task);
+  bool RunImpl(std::unique_ptr<Task> task,
+               intptr_t worker_id = kNoAffinity,
+               Priority priority = kNormalPriority);
   void WorkerLoop(Worker* worker);
 
-  Worker* ScheduleTaskLocked(std::unique_ptr<Task> task);
+  // Lets an idle worker wait for new tasks without parking for a short while,
+  // see FLAG_worker_spin_micros. Returns whether there are tasks to run.
+  bool SpinForTasksLocked(MutexLocker* ml);
+
+  Worker* ScheduleTaskLocked(std::unique_ptr<Task> task,
+                             intptr_t worker_id,
+                             Priority priority);
+  bool ScheduleOnWorkerLocked(std::unique_ptr<Task>* task, intptr_t worker_id);
 
-  std::unique_ptr<Task> TakeNextAvailableTaskLocked();
+  std::unique_ptr<Task> TakeNextAvailableTaskLocked(Worker* worker);
+  Task* StealTaskLocked(Worker* thief);
 
   void IdleToRunningLocked(Worker* worker);
   void RunningToIdleLocked(Worker* worker);
@@ -159,8 +219,12 @@ class ThreadPool {
 
   Worker* last_dead_worker_ = nullptr;
 
-  uint64_t pending_tasks_ = 0;
-  TaskList tasks_;
+  // Read without holding the pool_mutex_ by spinning workers.
+  std::atomic<uint64_t> pending_tasks_ = {0};
+  // Tasks without affinity, by priority.
+  TaskList tasks_[kNumPriorities];
+  // Idle workers which are spinning instead of waiting for a wakeup.
+  uint64_t count_spinning_ = 0;
 
   Monitor exit_monitor_;
   std::atomic<bool> all_workers_dead_;
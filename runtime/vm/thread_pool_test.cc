@@ -10,6 +10,7 @@
 namespace dart {
 
 DECLARE_FLAG(int, worker_timeout_millis);
+DECLARE_FLAG(int, worker_spin_micros);
 
 // Some of these tests change VM flags, so they should run without a full VM
 // startup to prevent races on the flag changes. None of the tests require full
@@ -257,4 +258,231 @@ THREAD_POOL_UNIT_TEST_CASE(ThreadPool_RecursiveSpawn) {
   EXPECT_EQ(kTotalTasks, done);
 }
 
+// Records the id of the worker it runs on, then waits for [*blocked] to turn
+// false.
+class WorkerIdTask : public ThreadPool::Task {
+ public:
+  WorkerIdTask(Monitor* sync, intptr_t* worker_id, bool* blocked)
+      : sync_(sync), worker_id_(worker_id), blocked_(blocked) {}
+
+  virtual void Run() {
+    MonitorLocker ml(sync_);
+    *worker_id_ = ThreadPool::CurrentWorkerId();
+    ml.NotifyAll();
+    while (*blocked_) {
+      ml.Wait();
+    }
+  }
+
+ private:
+  Monitor* sync_;
+  intptr_t* worker_id_;
+  bool* blocked_;
+};
+
+static void WaitForWorkerId(Monitor* sync, intptr_t* worker_id) {
+  MonitorLocker ml(sync);
+  while (*worker_id == ThreadPool::kNoAffinity) {
+    ml.Wait();
+  }
+}
+
+static void WaitForIdleWorkers(ThreadPool* thread_pool, uint64_t count) {
+  while (thread_pool->workers_idle() < count) {
+    OS::Sleep(1);
+  }
+  // Let them stop spinning, see --worker_spin_micros.
+  OS::Sleep(1);
+}
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_Affinity) {
+  ThreadPool thread_pool;
+  Monitor sync;
+  const int kWorkers = 3;
+  intptr_t ids[kWorkers];
+  bool blocked = true;
+  for (int i = 0; i < kWorkers; i++) {
+    ids[i] = ThreadPool::kNoAffinity;
+    thread_pool.Run<WorkerIdTask>(&sync, &ids[i], &blocked);
+  }
+  for (int i = 0; i < kWorkers; i++) {
+    WaitForWorkerId(&sync, &ids[i]);
+  }
+  {
+    MonitorLocker ml(&sync);
+    blocked = false;
+    ml.NotifyAll();
+  }
+
+  // Tasks go to the requested worker when it is idle.
+  for (int i = 0; i < 10; i++) {
+    WaitForIdleWorkers(&thread_pool, kWorkers);
+    const intptr_t expected = ids[i % kWorkers];
+    intptr_t id = ThreadPool::kNoAffinity;
+    thread_pool.RunWithAffinity<WorkerIdTask>(expected, &sync, &id, &blocked);
+    WaitForWorkerId(&sync, &id);
+    EXPECT_EQ(expected, id);
+  }
+
+  // Unknown workers are ignored.
+  intptr_t id = ThreadPool::kNoAffinity;
+  thread_pool.RunWithAffinity<WorkerIdTask>(-1, &sync, &id, &blocked);
+  WaitForWorkerId(&sync, &id);
+  EXPECT_NE(ThreadPool::kNoAffinity, id);
+}
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_AffinityBusyWorker) {
+  ThreadPool thread_pool(2);
+  Monitor sync;
+  bool busy_blocked = true;
+  intptr_t busy = ThreadPool::kNoAffinity;
+  thread_pool.Run<WorkerIdTask>(&sync, &busy, &busy_blocked);
+  WaitForWorkerId(&sync, &busy);
+
+  // Tasks for a worker which stays busy run on another one, started for them.
+  bool blocked = false;
+  for (int i = 0; i < 3; i++) {
+    intptr_t id = ThreadPool::kNoAffinity;
+    thread_pool.RunWithAffinity<WorkerIdTask>(busy, &sync, &id, &blocked);
+    WaitForWorkerId(&sync, &id);
+    EXPECT_NE(busy, id);
+  }
+  EXPECT_EQ(2U, thread_pool.workers_started());
+
+  MonitorLocker ml(&sync);
+  busy_blocked = false;
+  ml.NotifyAll();
+}
+
+// Appends [value] to [order] when it runs.
+class OrderTask : public ThreadPool::Task {
+ public:
+  OrderTask(Monitor* sync, MallocGrowableArray<intptr_t>* order, intptr_t value)
+      : sync_(sync), order_(order), value_(value) {}
+
+  virtual void Run() {
+    MonitorLocker ml(sync_);
+    order_->Add(value_);
+    ml.Notify();
+  }
+
+ private:
+  Monitor* sync_;
+  MallocGrowableArray<intptr_t>* order_;
+  intptr_t value_;
+};
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_Priority) {
+  ThreadPool thread_pool(1);
+  Monitor sync;
+  bool blocked = true;
+  intptr_t id = ThreadPool::kNoAffinity;
+  thread_pool.Run<WorkerIdTask>(&sync, &id, &blocked);
+  WaitForWorkerId(&sync, &id);
+
+  // Waiting tasks start in the order of their priority.
+  MallocGrowableArray<intptr_t> order;
+  thread_pool.Run<OrderTask>(&sync, &order, ThreadPool::kNormalPriority);
+  thread_pool.RunWithPriority<OrderTask>(ThreadPool::kCompilerPriority, &sync,
+                                         &order,
+                                         ThreadPool::kCompilerPriority);
+  thread_pool.RunWithPriority<OrderTask>(ThreadPool::kGCPriority, &sync,
+                                         &order, ThreadPool::kGCPriority);
+  thread_pool.RunWithPriority<OrderTask>(ThreadPool::kGCPriority, &sync,
+                                         &order, ThreadPool::kGCPriority);
+  MonitorLocker ml(&sync);
+  blocked = false;
+  ml.NotifyAll();
+  while (order.length() < 4) {
+    ml.Wait();
+  }
+  EXPECT_EQ(ThreadPool::kGCPriority, order[0]);
+  EXPECT_EQ(ThreadPool::kGCPriority, order[1]);
+  EXPECT_EQ(ThreadPool::kCompilerPriority, order[2]);
+  EXPECT_EQ(ThreadPool::kNormalPriority, order[3]);
+}
+
+// Records when it starts running.
+class TimestampTask : public ThreadPool::Task {
+ public:
+  TimestampTask(Monitor* sync, int64_t* start) : sync_(sync), start_(start) {}
+
+  virtual void Run() {
+    MonitorLocker ml(sync_);
+    *start_ = OS::GetCurrentMonotonicMicros();
+    ml.Notify();
+  }
+
+ private:
+  Monitor* sync_;
+  int64_t* start_;
+};
+
+// Counts down and notifies [sync] when reaching zero.
+class CountTask : public ThreadPool::Task {
+ public:
+  CountTask(Monitor* sync, std::atomic<intptr_t>* count)
+      : sync_(sync), count_(count) {}
+
+  virtual void Run() {
+    if (count_->fetch_sub(1) == 1) {
+      MonitorLocker ml(sync_);
+      ml.Notify();
+    }
+  }
+
+ private:
+  Monitor* sync_;
+  std::atomic<intptr_t>* count_;
+};
+
+// Reports how long tasks take to start when the pool is idle, and how many
+// tasks it runs per second, with and without workers spinning before they go
+// to sleep.
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_SchedulingBenchmark) {
+  const int kLatencyRounds = 1000;
+  const intptr_t kThroughputTasks = 100000;
+  const int saved_spin_micros = FLAG_worker_spin_micros;
+  for (const int spin_micros : {0, saved_spin_micros}) {
+    FLAG_worker_spin_micros = spin_micros;
+    ThreadPool thread_pool;
+    Monitor sync;
+
+    int64_t total_latency = 0;
+    int64_t max_latency = 0;
+    for (int i = 0; i < kLatencyRounds; i++) {
+      int64_t start = 0;
+      const int64_t scheduled = OS::GetCurrentMonotonicMicros();
+      thread_pool.Run<TimestampTask>(&sync, &start);
+      MonitorLocker ml(&sync);
+      while (start == 0) {
+        ml.Wait();
+      }
+      total_latency += start - scheduled;
+      max_latency = Utils::Maximum(max_latency, start - scheduled);
+    }
+
+    std::atomic<intptr_t> count = {kThroughputTasks};
+    const int64_t begin = OS::GetCurrentMonotonicMicros();
+    for (intptr_t i = 0; i < kThroughputTasks; i++) {
+      thread_pool.Run<CountTask>(&sync, &count);
+    }
+    {
+      MonitorLocker ml(&sync);
+      while (count > 0) {
+        ml.Wait();
+      }
+    }
+    const int64_t elapsed =
+        Utils::Maximum<int64_t>(1, OS::GetCurrentMonotonicMicros() - begin);
+
+    OS::PrintErr("Spinning %d us: latency avg %" Pd64 " us, max %" Pd64
+                 " us, throughput %" Pd64 " tasks/s\n",
+                 spin_micros, total_latency / kLatencyRounds, max_latency,
+                 kThroughputTasks * kMicrosecondsPerSecond / elapsed);
+    EXPECT_EQ(0, count.load());
+  }
+  FLAG_worker_spin_micros = saved_spin_micros;
+}
+
 }  // namespace dart
@@ -7,6 +7,7 @@ library dart._http;
 import 'dart:_internal'
     show
         checkNotNullable,
+        FileRangeStream,
         Since,
         valueOfNonNullableParamWithDefault,
         HttpStatus;
@@ -1869,6 +1869,14 @@ class _HttpOutgoing implements StreamConsumer<List<int>> {
       }
       return close();
     }
+    if (!chunked && !_gzip && stream is FileRangeStream) {
+      var path = (stream as FileRangeStream).path;
+      if (path != null) return _addFileRange(stream, path);
+    }
+    return _addStreamChunks(stream);
+  }
+
+  Future _addStreamChunks(Stream<List<int>> stream) {
     // Use new stream so we are able to pause (see below listen). The
     // alternative is to use stream.expand, but that won't give us a way of
     // pausing.
@@ -1944,6 +1952,66 @@ class _HttpOutgoing implements StreamConsumer<List<int>> {
         );
   }
 
+  // Passes a file body to the socket unchanged, so that it can be sent without
+  // copying the file through Dart. Instead of counting the bytes of each
+  // chunk, the length of the file range is checked against the content length
+  // up front.
+  Future _addFileRange(Stream<List<int>> stream, String path) {
+    var range = stream as FileRangeStream;
+    return File(path)
+        .length()
+        .then(
+          (fileLength) =>
+              min(range.end ?? fileLength, fileLength) - range.start,
+          onError: (_) => -1,
+        )
+        .then((length) {
+          var contentLength = this.contentLength;
+          if (_socketError ||
+              length < 0 ||
+              (contentLength != null &&
+                  _bytesWritten + length > contentLength)) {
+            // Let the regular path report errors and excess content.
+            return _addStreamChunks(stream);
+          }
+          _bytesWritten += length;
+          return Future.sync(() {
+            if (!headersWritten) return writeHeaders();
+          }).then((_) {
+            // Write out what has been buffered, including the headers.
+            if (_length > 0) {
+              socket.add(
+                Uint8List.view(
+                  _buffer!.buffer,
+                  _buffer!.offsetInBytes,
+                  _length,
+                ),
+              );
+              _buffer = outbound!.bufferOutput
+                  ? Uint8List(_OUTGOING_BUFFER_SIZE)
+                  : null;
+              _length = 0;
+            }
+            // Send exactly the range that was counted. The file growing in
+            // the meantime does not add to it, and the file shrinking fails
+            // the response instead of leaving it short.
+            var body = range.exactRange(range.start, range.start + length);
+            return socket.addStream(body).then(
+              (_) => outbound,
+              onError: (error, stackTrace) {
+                _socketError = true;
+                _doneCompleter.completeError(error, stackTrace);
+                if (_ignoreError(error)) {
+                  return outbound;
+                } else {
+                  throw error;
+                }
+              },
+            );
+          });
+        });
+  }
+
   Future close() {
     // If we are already closed, return that future.
     var closeFuture = _closeFuture;
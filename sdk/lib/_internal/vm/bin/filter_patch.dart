@@ -40,8 +40,18 @@ base class _ZLibDeflateFilter extends _FilterImpl {
     int strategy,
     List<int>? dictionary,
     bool raw,
+    int threads,
   ) {
-    _init(gzip, level, windowBits, memLevel, strategy, dictionary, raw);
+    _init(
+      gzip,
+      level,
+      windowBits,
+      memLevel,
+      strategy,
+      dictionary,
+      raw,
+      threads,
+    );
   }
   @pragma("vm:external-name", "Filter_CreateZLibDeflate")
   external void _init(
@@ -52,6 +62,7 @@ base class _ZLibDeflateFilter extends _FilterImpl {
     int strategy,
     List<int>? dictionary,
     bool raw,
+    int threads,
   );
 }
 
@@ -66,6 +77,7 @@ class RawZLibFilter {
     int strategy,
     List<int>? dictionary,
     bool raw,
+    int threads,
   ) => _ZLibDeflateFilter(
     gzip,
     level,
@@ -74,6 +86,7 @@ class RawZLibFilter {
     strategy,
     dictionary,
     raw,
+    threads,
   );
   @patch
   static RawZLibFilter _makeZLibInflateFilter(
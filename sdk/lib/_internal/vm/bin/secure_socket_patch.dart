@@ -164,6 +164,12 @@ base class _SecureFilterImpl extends NativeFieldWrapperClass1
   @pragma("vm:external-name", "SecureSocket_GetSelectedProtocol")
   external String? selectedProtocol();
 
+  bool enableKernelTls(RawSocket socket) =>
+      socket is _RawSocket && _enableKernelTls(socket._socket);
+
+  @pragma("vm:external-name", "SecureSocket_EnableKernelTLS")
+  external bool _enableKernelTls(_NativeSocket socket);
+
   @pragma("vm:external-name", "SecureSocket_Init")
   external void init();
 
@@ -472,6 +472,9 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
   // eventhandler. COMMAND flags are never received from the
   // eventhandler. Additional flags are used to communicate other
   // information.
+  // Maximum number of buffers passed to a single gather write.
+  static const int _maxGatherBuffers = 32;
+
   static const int readEvent = 0;
   static const int writeEvent = 1;
   static const int errorEvent = 2;
@@ -566,6 +569,11 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
   // Only used for UDP sockets.
   bool _availableDatagram = false;
 
+  // Datagrams received by the last batched receive and not yet returned by
+  // [receive], starting at [_receivedIndex]. Only used for UDP sockets.
+  List<Datagram>? _received;
+  int _receivedIndex = 0;
+
   // The number of incoming connections for Listening socket.
   int connections = 0;
 
@@ -1349,15 +1357,30 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
   Datagram? receive() {
     if (isClosing || isClosed) return null;
     try {
-      Datagram? result = nativeRecvFrom();
+      var received = _received;
+      if (received == null) {
+        // Receive all datagrams queued on the socket, up to a limit, in one
+        // native call and hand them out one at a time.
+        received = nativeRecvFromBatch();
+        if (received == null) {
+          _availableDatagram = nativeAvailableDatagram();
+          return null;
+        }
+        _received = received;
+        _receivedIndex = 0;
+      }
+      Datagram result = received[_receivedIndex++];
+      if (_receivedIndex == received.length) {
+        _received = null;
+      }
       if (!const bool.fromEnvironment("dart.vm.product")) {
         _SocketProfile.collectStatistic(
           nativeGetSocketId(),
           _SocketProfileType.readBytes,
-          result?.data.length,
+          result.data.length,
         );
       }
-      _availableDatagram = nativeAvailableDatagram();
+      _availableDatagram = _hasReceivedDatagram || nativeAvailableDatagram();
       return result;
     } catch (e) {
       reportError(e, StackTrace.current, "Receive failed");
@@ -1365,6 +1388,8 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
     }
   }
 
+  bool get _hasReceivedDatagram => _received != null;
+
   SocketMessage? readMessage([int? count]) {
     if (count != null && count <= 0) {
       throw ArgumentError("Illegal length $count");
@@ -1481,6 +1506,81 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
     }
   }
 
+  // Writes [buffers], skipping the first [offset] bytes of the first one,
+  // with a single gather write. Returns the number of bytes written, like
+  // [write].
+  int writeList(List<List<int>> buffers, int offset) {
+    if (isClosing || isClosed) return 0;
+    // Triples of <buffer, start, length>.
+    final pieces = <Object>[];
+    int bytes = 0;
+    for (int i = 0; i < buffers.length; i++) {
+      if (pieces.length == _maxGatherBuffers * 3) break;
+      final buffer = buffers[i];
+      final start = i == 0 ? offset : 0;
+      final length = buffer.length - start;
+      if (length == 0) continue;
+      _BufferAndStart bufferAndStart = _ensureFastAndSerializableByteData(
+        buffer,
+        start,
+        buffer.length,
+      );
+      // The native acquires all buffers at the same time, which is not
+      // possible if a buffer is passed twice.
+      bool duplicate = false;
+      for (int j = 0; j < pieces.length; j += 3) {
+        if (identical(pieces[j], bufferAndStart.buffer)) duplicate = true;
+      }
+      if (duplicate) break;
+      pieces
+        ..add(bufferAndStart.buffer)
+        ..add(bufferAndStart.start)
+        ..add(length);
+      bytes += length;
+    }
+    if (bytes == 0) return 0;
+    try {
+      if (!const bool.fromEnvironment("dart.vm.product")) {
+        _SocketProfile.collectStatistic(
+          nativeGetSocketId(),
+          _SocketProfileType.writeBytes,
+          bytes,
+        );
+      }
+      int result = nativeWriteGather(pieces);
+      if (result >= 0) {
+        // See [write].
+        writeAvailable = (result == bytes) && !hasPendingWrite();
+      } else {
+        result = -result;
+        writeAvailable = !hasPendingWrite();
+      }
+      return result;
+    } catch (e) {
+      StackTrace st = StackTrace.current;
+      scheduleMicrotask(() => reportError(e, st, "Write failed"));
+      return 0;
+    }
+  }
+
+  // Sends up to [length] bytes of the file [fd] from [offset] without
+  // copying them through Dart. Returns the number of bytes sent, 0 at the
+  // end of the file, or null if the socket cannot take more data. Throws if
+  // the socket is closed or sending fails.
+  int? sendFile(int fd, int offset, int length) {
+    if (isClosing || isClosed) throw const SocketException.closed();
+    int? result = nativeSendFile(fd, offset, length);
+    if (!const bool.fromEnvironment("dart.vm.product")) {
+      _SocketProfile.collectStatistic(
+        nativeGetSocketId(),
+        _SocketProfileType.writeBytes,
+        result ?? 0,
+      );
+    }
+    writeAvailable = result != null;
+    return result;
+  }
+
   int send(
     List<int> buffer,
     int offset,
@@ -1706,7 +1806,8 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
               }
             } else {
               if (isUdp) {
-                _availableDatagram = nativeAvailableDatagram();
+                _availableDatagram =
+                    _hasReceivedDatagram || nativeAvailableDatagram();
               } else {
                 available = nativeAvailable();
               }
@@ -2033,14 +2134,18 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
   external bool nativeAvailableDatagram();
   @pragma("vm:external-name", "Socket_Read")
   external Uint8List? nativeRead(int len);
-  @pragma("vm:external-name", "Socket_RecvFrom")
-  external Datagram? nativeRecvFrom();
+  @pragma("vm:external-name", "Socket_RecvFromBatch")
+  external List<Datagram>? nativeRecvFromBatch();
   @pragma("vm:external-name", "Socket_ReceiveMessage")
   external List<dynamic> nativeReceiveMessage(int len);
   @pragma("vm:external-name", "Socket_WriteList")
   external int nativeWrite(List<int> buffer, int offset, int bytes);
+  @pragma("vm:external-name", "Socket_WriteGather")
+  external int nativeWriteGather(List<Object> buffers);
   @pragma("vm:external-name", "Socket_HasPendingWrite")
   external bool nativeHasPendingWrite();
+  @pragma("vm:external-name", "Socket_SendFile")
+  external int? nativeSendFile(int fd, int offset, int length);
   @pragma("vm:external-name", "Socket_SendTo")
   external int nativeSendTo(
     List<int> buffer,
@@ -2587,12 +2692,32 @@ class Socket {
 }
 
 class _SocketStreamConsumer implements StreamConsumer<List<int>> {
+  // While the socket cannot take more data, buffers from the stream are
+  // queued and then written out together with a single gather write. The
+  // subscription is paused once this many buffers or bytes are queued.
+  static const int _maxQueuedBuffers = 16;
+  static const int _maxQueuedBytes = 64 * 1024;
+  // The maximum number of bytes sent from a file in one call.
+  static const int _maxSendFileBytes = 1 << 30;
+
   StreamSubscription? subscription;
   final _Socket socket;
-  int? offset;
-  List<int>? buffer;
+  // Offset of the first unwritten byte in buffers.first.
+  int offset = 0;
+  final buffers = <List<int>>[];
+  int queuedBytes = 0;
+  // Whether we are waiting for a write event before writing again.
+  bool waitingForWrite = false;
   bool paused = false;
+  // Whether the stream is done but queued buffers are still being written.
+  bool streamDone = false;
   Completer<Socket>? streamCompleter;
+  // The file being sent from a file stream, if any, and the range of it
+  // that remains. A null end sends until the end of the file.
+  _RandomAccessFile? sendFile;
+  int sendFilePosition = 0;
+  int? sendFileEnd;
+  bool sendFileExact = false;
 
   _SocketStreamConsumer(this.socket);
 
@@ -2600,42 +2725,149 @@ class _SocketStreamConsumer implements StreamConsumer<List<int>> {
     socket._ensureRawSocketSubscription();
     final completer = streamCompleter = Completer<Socket>();
     if (socket._raw != null) {
-      subscription = stream.listen(
-        (data) {
-          assert(!paused);
-          assert(buffer == null);
-          buffer = data;
-          offset = 0;
-          try {
-            write();
-          } catch (e) {
-            buffer = null;
-            offset = 0;
-
-            socket.destroy();
-            stop();
-            done(e);
-          }
-        },
-        onError: (error, [stackTrace]) {
-          socket.destroy();
-          done(error, stackTrace);
-        },
-        onDone: () {
-          // Note: stream only delivers done event if subscription is not paused.
-          // so it is crucial to keep subscription paused while writes are
-          // in flight.
-          assert(buffer == null);
-          done();
-        },
-        cancelOnError: true,
-      );
+      if (stream is _FileStream && _canSendFile(stream)) {
+        _sendFileStream(stream);
+      } else {
+        _listen(stream);
+      }
     } else {
       done();
     }
     return completer.future;
   }
 
+  void _listen(Stream<List<int>> stream) {
+    subscription = stream.listen(
+      (data) {
+        assert(!paused);
+        buffers.add(data);
+        queuedBytes += data.length;
+        try {
+          if (waitingForWrite) {
+            _pauseIfFull();
+          } else {
+            _writeQueued();
+          }
+        } catch (e) {
+          buffers.clear();
+          queuedBytes = 0;
+          offset = 0;
+
+          socket.destroy();
+          stop();
+          done(e);
+        }
+      },
+      onError: (error, [stackTrace]) {
+        socket.destroy();
+        done(error, stackTrace);
+      },
+      onDone: () {
+        // Note: stream only delivers done event if subscription is not paused.
+        // Queued buffers are written before completing.
+        if (buffers.isEmpty && !waitingForWrite) {
+          done();
+        } else {
+          streamDone = true;
+        }
+      },
+      cancelOnError: true,
+    );
+  }
+
+  // Whether the file of [stream] can be sent by the kernel straight to the
+  // socket instead of being read into Dart.
+  bool _canSendFile(_FileStream stream) {
+    if (!(Platform.isLinux || Platform.isAndroid || Platform.isMacOS)) {
+      return false;
+    }
+    final end = stream._end;
+    return !stream._listened &&
+        stream._path != null &&
+        (end == null || end >= stream._position) &&
+        socket._plainSocket != null;
+  }
+
+  void _sendFileStream(_FileStream stream) {
+    final path = stream._path!;
+    FileStat.stat(path)
+        .then<RandomAccessFile?>((stat) {
+          // Only regular files can be sent directly.
+          if (stat.type != FileSystemEntityType.file) return null;
+          return File(path).open();
+        })
+        .then<void>(
+          (file) {
+            if (file == null) {
+              _listen(stream);
+            } else if (socket._raw == null) {
+              file.closeSync();
+              done();
+            } else {
+              sendFile = file as _RandomAccessFile;
+              sendFilePosition = stream._position;
+              sendFileEnd = stream._end;
+              sendFileExact = stream._exact;
+              _sendFileQueued();
+            }
+          },
+          // Let the stream report the error.
+          onError: (_) => _listen(stream),
+        )
+        .catchError(_sendFileFailed);
+  }
+
+  void _sendFileQueued() {
+    final file = sendFile!;
+    try {
+      while (true) {
+        final end = sendFileEnd;
+        if (end != null && sendFilePosition >= end) break;
+        final length = end == null
+            ? _maxSendFileBytes
+            : min(end - sendFilePosition, _maxSendFileBytes);
+        final sent = socket._sendFile(file.fd, sendFilePosition, length);
+        if (sent == null) {
+          waitingForWrite = true;
+          socket._enableWriteEvent();
+          return;
+        }
+        if (sent == 0) {
+          // The end of the file was reached, which is only expected before
+          // the end of the range if the stream allows it.
+          if (sendFileExact) {
+            throw FileSystemException(
+              "File ended before the requested range was read",
+              file.path,
+            );
+          }
+          break;
+        }
+        sendFilePosition += sent;
+      }
+    } catch (e, st) {
+      _sendFileFailed(e, st);
+      return;
+    }
+    _closeSendFile();
+    done();
+  }
+
+  void _sendFileFailed(Object error, StackTrace stackTrace) {
+    stop();
+    socket.destroy();
+    done(error, stackTrace);
+  }
+
+  void _closeSendFile() {
+    final file = sendFile;
+    if (file == null) return;
+    sendFile = null;
+    try {
+      file.closeSync();
+    } catch (_) {}
+  }
+
   Future<Socket> close() {
     socket._consumerDone();
     return Future.value(socket);
@@ -2652,34 +2884,59 @@ class _SocketStreamConsumer implements StreamConsumer<List<int>> {
     return true;
   }
 
+  void _pauseIfFull() {
+    final sub = subscription;
+    if (sub == null || paused) return;
+    if (buffers.length >= _maxQueuedBuffers ||
+        queuedBytes >= _maxQueuedBytes) {
+      paused = true;
+      sub.pause();
+    }
+  }
+
+  // Called when the socket can take more data.
   void write() {
+    waitingForWrite = false;
+    if (sendFile != null) {
+      _sendFileQueued();
+    } else {
+      _writeQueued();
+    }
+  }
+
+  void _writeQueued() {
     final sub = subscription;
     if (sub == null) return;
 
     // We have something to write out.
-    if (offset! < buffer!.length) {
-      offset =
-          offset! + socket._write(buffer!, offset!, buffer!.length - offset!);
+    if (buffers.isNotEmpty) {
+      offset += socket._writeList(buffers, offset);
+      while (buffers.isNotEmpty && offset >= buffers.first.length) {
+        final buffer = buffers.removeAt(0);
+        offset -= buffer.length;
+        queuedBytes -= buffer.length;
+      }
     }
 
-    if (offset! < buffer!.length || !_previousWriteHasCompleted) {
+    if (buffers.isNotEmpty || !_previousWriteHasCompleted) {
       // On Windows we might have written the whole buffer out but we are
-      // still waiting for the write to complete. We should not resume the
-      // subscription until the pending write finishes and we receive a
+      // still waiting for the write to complete. We should not write the
+      // next chunk until the pending write finishes and we receive a
       // writeEvent signaling that we can write the next chunk or that we
       // can consider all data flushed from our side into kernel buffers.
-      if (!paused) {
-        paused = true;
-        sub.pause();
-      }
+      waitingForWrite = true;
+      _pauseIfFull();
       socket._enableWriteEvent();
     } else {
       // Write fully completed.
-      buffer = null;
       if (paused) {
         paused = false;
         sub.resume();
       }
+      if (streamDone) {
+        streamDone = false;
+        done();
+      }
     }
   }
 
@@ -2696,11 +2953,17 @@ class _SocketStreamConsumer implements StreamConsumer<List<int>> {
   }
 
   void stop() {
+    if (sendFile != null) {
+      _closeSendFile();
+      waitingForWrite = false;
+      socket._disableWriteEvent();
+    }
     final sub = subscription;
     if (sub == null) return;
     sub.cancel();
     subscription = null;
     paused = false;
+    waitingForWrite = false;
     socket._disableWriteEvent();
   }
 }
@@ -2850,7 +3113,7 @@ class _Socket extends Stream<Uint8List> implements Socket {
     _detachReady = completer;
     _sink.close();
     return completer.future.then((_) {
-      assert(_consumer.buffer == null);
+      assert(_consumer.buffers.isEmpty);
       var raw = _raw;
       _raw = null;
       return [raw, _subscription];
@@ -2933,14 +3196,36 @@ class _Socket extends Stream<Uint8List> implements Socket {
     _consumer.done(error, stackTrace);
   }
 
-  int _write(List<int> data, int offset, int length) {
+  int _writeList(List<List<int>> buffers, int offset) {
     final raw = _raw;
+    if (raw is _RawSocket) {
+      return raw._socket.writeList(buffers, offset);
+    }
     if (raw != null) {
-      return raw.write(data, offset, length);
+      final first = buffers.first;
+      return raw.write(first, offset, first.length - offset);
     }
     return 0;
   }
 
+  // The socket that data written to this socket reaches unchanged. Secure
+  // sockets only have one while the kernel encrypts their writes.
+  _RawSocket? get _plainSocket {
+    final raw = _raw;
+    if (raw is _RawSocket) return raw;
+    if (raw is _RawSecureSocket) {
+      final socket = raw._kernelTlsSocket;
+      if (socket is _RawSocket) return socket;
+    }
+    return null;
+  }
+
+  int? _sendFile(int fd, int offset, int length) {
+    final plainSocket = _plainSocket;
+    if (plainSocket == null) throw const SocketException.closed();
+    return plainSocket._socket.sendFile(fd, offset, length);
+  }
+
   void _enableWriteEvent() {
     _raw?.writeEventsEnabled = true;
   }
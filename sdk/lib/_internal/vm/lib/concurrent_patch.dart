@@ -3,8 +3,9 @@
 // BSD-style license that can be found in the LICENSE file.
 
 import "dart:_internal" show patch;
-import "dart:ffi" show Handle, Void, Native;
+import "dart:ffi" show Handle, IntPtr, Native, Void;
 import "dart:nativewrappers" show NativeFieldWrapperClass1;
+import "dart:typed_data";
 
 @patch
 @pragma("vm:entry-point")
@@ -56,3 +57,48 @@ base class _ConditionVariableImpl extends NativeFieldWrapperClass1
   @Native<Void Function(Handle)>(symbol: "ConditionVariable_NotifyAll")
   external void notifyAll();
 }
+
+@patch
+abstract final class SharedTypedData {
+  // Values of Dart_TypedData_Type.
+  static const int _kUint8 = 2;
+  static const int _kInt32 = 6;
+  static const int _kInt64 = 8;
+  static const int _kFloat32 = 10;
+  static const int _kFloat64 = 11;
+
+  @patch
+  static Uint8List uint8List(int length) =>
+      _allocate(_kUint8, length) as Uint8List;
+
+  @patch
+  static Int32List int32List(int length) =>
+      _allocate(_kInt32, length) as Int32List;
+
+  @patch
+  static Int64List int64List(int length) =>
+      _allocate(_kInt64, length) as Int64List;
+
+  @patch
+  static Float32List float32List(int length) =>
+      _allocate(_kFloat32, length) as Float32List;
+
+  @patch
+  static Float64List float64List(int length) =>
+      _allocate(_kFloat64, length) as Float64List;
+
+  static TypedData _allocate(int type, int length) {
+    RangeError.checkNotNegative(length, "length");
+    final result = _allocateNative(type, length);
+    // The native returns `null` if [length] is too large for typed data and
+    // `false` if the memory cannot be allocated.
+    if (result == null) {
+      throw RangeError.value(length, "length", "Too large");
+    }
+    if (result is! TypedData) throw OutOfMemoryError();
+    return result;
+  }
+
+  @Native<Handle Function(IntPtr, IntPtr)>(symbol: "SharedTypedData_Allocate")
+  external static Object? _allocateNative(int type, int length);
+}
@@ -183,6 +183,11 @@ abstract class VMInternalsForTesting {
   @pragma("vm:external-name", "Internal_deoptimizeFunctionsOnStack")
   external static void deoptimizeFunctionsOnStack();
 
+  // Returns how many isolates the current isolate group has spawned from its
+  // pool of idle isolates, see --isolate-pool-size.
+  @pragma("vm:external-name", "Internal_isolatePoolHits")
+  external static int isolatePoolHits();
+
   // Used to verify that PC addresses in stubs can be named using DWARF info
   // by returning the start offset into the isolate instructions that
   // corresponds to a known stub.
@@ -718,6 +718,7 @@ class RawZLibFilter {
     int strategy,
     List<int>? dictionary,
     bool raw,
+    int threads,
   ) {
     throw UnsupportedError("_newZLibDeflateFilter");
   }
@@ -8,6 +8,8 @@
 /// {@nodoc}
 library dart.concurrent;
 
+import "dart:typed_data";
+
 /// A *mutex* synchronization primitive.
 ///
 /// Mutex can be used to synchronize access to a native resource shared between
@@ -54,3 +56,30 @@ abstract interface class ConditionVariable {
   /// Wake up all threads waiting on this condition variable.
   external void notifyAll();
 }
+
+/// Typed data lists whose contents are shared by isolates instead of copied.
+///
+/// Sending a list created here, or a view on one, to another isolate gives
+/// the receiver a list backed by the same memory. Writes made by one isolate
+/// are visible to all others, so access should be synchronized, for example
+/// with a [Mutex] and a [ConditionVariable].
+///
+/// The memory is released once no isolate refers to it anymore.
+abstract final class SharedTypedData {
+  /// Creates a zero-initialized shared list of [length] bytes.
+  external static Uint8List uint8List(int length);
+
+  /// Creates a zero-initialized shared list of [length] 32-bit integers.
+  external static Int32List int32List(int length);
+
+  /// Creates a zero-initialized shared list of [length] 64-bit integers.
+  external static Int64List int64List(int length);
+
+  /// Creates a zero-initialized shared list of [length] single precision
+  /// floating point numbers.
+  external static Float32List float32List(int length);
+
+  /// Creates a zero-initialized shared list of [length] double precision
+  /// floating point numbers.
+  external static Float64List float64List(int length);
+}
@@ -1034,6 +1034,29 @@ abstract class HttpStatus {
   static const int NETWORK_CONNECT_TIMEOUT_ERROR = networkConnectTimeoutError;
 }
 
+/// A stream of the bytes of a range of a file, as returned by `File.openRead`.
+///
+/// Lets `dart:_http` recognize file bodies and pass them to the socket
+/// unchanged, so that `dart:io` can send them without copying the bytes
+/// through Dart.
+abstract interface class FileRangeStream {
+  /// The path of the file, or `null` if the stream does not read a path.
+  String? get path;
+
+  /// The offset of the first byte of the range.
+  int get start;
+
+  /// The offset after the last byte of the range, or `null` to read until the
+  /// end of the file.
+  int? get end;
+
+  /// A stream of exactly the bytes from [start] to [end] of the same file.
+  ///
+  /// Unlike a regular file stream, the stream fails if the file ends before
+  /// [end]. Requires [path] to be non-`null`.
+  Stream<List<int>> exactRange(int start, int end);
+}
+
 // Class moved here from dart:collection
 // to allow another, more important, class to implement the interface
 // without having to match the private members.
@@ -38,6 +38,10 @@ abstract final class ZLibOption {
   /// Default value for [ZLibCodec.memLevel] and [ZLibEncoder.memLevel].
   static const int defaultMemLevel = 8;
 
+  /// Maximal value for [ZLibCodec.threads], [GZipCodec.threads] and
+  /// [ZLibEncoder.threads].
+  static const int maxThreads = 64;
+
   /// Recommended strategy for data produced by a filter (or predictor)
   static const int strategyFiltered = 1;
 
@@ -106,6 +110,16 @@ final class ZLibCodec extends Codec<List<int>, List<int>> {
   /// than with the default empty dictionary.
   final List<int>? dictionary;
 
+  /// The number of threads used to compress data, in the range
+  /// `1..ZLibOption.maxThreads`.
+  ///
+  /// With more than one thread, the input is split into blocks that are
+  /// compressed in parallel, and the blocks are joined into a single `ZLib`,
+  /// `GZip` or raw stream. The result is slightly larger than with one thread.
+  /// When a [dictionary] is used for `ZLib` data, that is, neither [gzip] nor
+  /// [raw] is set, compression always uses one thread.
+  final int threads;
+
   ZLibCodec({
     this.level = ZLibOption.defaultLevel,
     this.windowBits = ZLibOption.defaultWindowBits,
@@ -114,8 +128,10 @@ final class ZLibCodec extends Codec<List<int>, List<int>> {
     this.dictionary,
     this.raw = false,
     this.gzip = false,
+    this.threads = 1,
   }) {
     _validateZLibeLevel(level);
+    _validateZLibThreads(threads);
     _validateZLibMemLevel(memLevel);
     _validateZLibStrategy(strategy);
     _validateZLibWindowBits(windowBits);
@@ -128,7 +144,8 @@ final class ZLibCodec extends Codec<List<int>, List<int>> {
       strategy = ZLibOption.strategyDefault,
       raw = false,
       gzip = false,
-      dictionary = null;
+      dictionary = null,
+      threads = 1;
 
   /// Get a [ZLibEncoder] for encoding to `ZLib` compressed data.
   ZLibEncoder get encoder => ZLibEncoder(
@@ -139,6 +156,7 @@ final class ZLibCodec extends Codec<List<int>, List<int>> {
     strategy: strategy,
     dictionary: dictionary,
     raw: raw,
+    threads: threads,
   );
 
   /// Get a [ZLibDecoder] for decoding `ZLib` compressed data.
@@ -199,6 +217,14 @@ final class GZipCodec extends Codec<List<int>, List<int>> {
   /// will not compute an adler32 check value
   final bool raw;
 
+  /// The number of threads used to compress data, in the range
+  /// `1..ZLibOption.maxThreads`.
+  ///
+  /// With more than one thread, the input is split into blocks that are
+  /// compressed in parallel, and the blocks are joined into a single `GZip`
+  /// member. The result is slightly larger than with one thread.
+  final int threads;
+
   GZipCodec({
     this.level = ZLibOption.defaultLevel,
     this.windowBits = ZLibOption.defaultWindowBits,
@@ -207,8 +233,10 @@ final class GZipCodec extends Codec<List<int>, List<int>> {
     this.dictionary,
     this.raw = false,
     this.gzip = true,
+    this.threads = 1,
   }) {
     _validateZLibeLevel(level);
+    _validateZLibThreads(threads);
     _validateZLibMemLevel(memLevel);
     _validateZLibStrategy(strategy);
     _validateZLibWindowBits(windowBits);
@@ -221,7 +249,8 @@ final class GZipCodec extends Codec<List<int>, List<int>> {
       strategy = ZLibOption.strategyDefault,
       raw = false,
       gzip = true,
-      dictionary = null;
+      dictionary = null,
+      threads = 1;
 
   /// Get a [ZLibEncoder] for encoding to `GZip` compressed data.
   ZLibEncoder get encoder => ZLibEncoder(
@@ -232,6 +261,7 @@ final class GZipCodec extends Codec<List<int>, List<int>> {
     strategy: strategy,
     dictionary: dictionary,
     raw: raw,
+    threads: threads,
   );
 
   /// Get a [ZLibDecoder] for decoding `GZip` compressed data.
@@ -293,6 +323,16 @@ final class ZLibEncoder extends Converter<List<int>, List<int>> {
   /// will not compute an adler32 check value
   final bool raw;
 
+  /// The number of threads used by the encoder, in the range
+  /// `1..ZLibOption.maxThreads`.
+  ///
+  /// With more than one thread, the input is split into blocks that are
+  /// compressed in parallel, and the blocks are joined into a single stream
+  /// of the format selected by [gzip] and [raw]. The result is slightly
+  /// larger than with one thread. Encoding `ZLib` data with a [dictionary]
+  /// always uses one thread.
+  final int threads;
+
   ZLibEncoder({
     this.gzip = false,
     this.level = ZLibOption.defaultLevel,
@@ -301,8 +341,10 @@ final class ZLibEncoder extends Converter<List<int>, List<int>> {
     this.strategy = ZLibOption.strategyDefault,
     this.dictionary,
     this.raw = false,
+    this.threads = 1,
   }) {
     _validateZLibeLevel(level);
+    _validateZLibThreads(threads);
     _validateZLibMemLevel(memLevel);
     _validateZLibStrategy(strategy);
     _validateZLibWindowBits(windowBits);
@@ -337,6 +379,7 @@ final class ZLibEncoder extends Converter<List<int>, List<int>> {
       strategy,
       dictionary,
       raw,
+      threads,
     );
   }
 }
@@ -410,7 +453,9 @@ abstract interface class RawZLibFilter {
     int strategy = ZLibOption.strategyDefault,
     List<int>? dictionary,
     bool raw = false,
+    int threads = 1,
   }) {
+    _validateZLibThreads(threads);
     return _makeZLibDeflateFilter(
       gzip,
       level,
@@ -419,6 +464,7 @@ abstract interface class RawZLibFilter {
       strategy,
       dictionary,
       raw,
+      threads,
     );
   }
 
@@ -457,6 +503,7 @@ abstract interface class RawZLibFilter {
     int strategy,
     List<int>? dictionary,
     bool raw,
+    int threads,
   );
 
   external static RawZLibFilter _makeZLibInflateFilter(
@@ -498,6 +545,7 @@ class _ZLibEncoderSink extends _FilterSink {
     int strategy,
     List<int>? dictionary,
     bool raw,
+    int threads,
   ) : super(
         sink,
         RawZLibFilter._makeZLibDeflateFilter(
@@ -508,6 +556,7 @@ class _ZLibEncoderSink extends _FilterSink {
           strategy,
           dictionary,
           raw,
+          threads,
         ),
       );
 }
@@ -614,6 +663,12 @@ void _validateZLibMemLevel(int memLevel) {
   }
 }
 
+void _validateZLibThreads(int threads) {
+  if (1 > threads || ZLibOption.maxThreads < threads) {
+    throw RangeError.range(threads, 1, ZLibOption.maxThreads, "threads");
+  }
+}
+
 void _validateZLibStrategy(int strategy) {
   const strategies = <int>[
     ZLibOption.strategyFiltered,
@@ -24,13 +24,16 @@ const int _blockSize = 64 * 1024;
 // A bigger value reduces the number of system calls.
 const int _maxReadSize = 16 * 1024 * 1024; // 16MB.
 
-class _FileStream extends Stream<List<int>> {
+class _FileStream extends Stream<List<int>> implements FileRangeStream {
   // Stream controller.
   late StreamController<Uint8List> _controller;
 
   // Information about the underlying file.
   String? _path;
   RandomAccessFile? _openedFile;
+  // The file opened from [_path], which is read at [_position] instead of at
+  // its file position.
+  _RandomAccessFile? _positionalFile;
   int _position;
   int? _end;
   final Completer _closeCompleter = new Completer();
@@ -44,8 +47,22 @@ class _FileStream extends Stream<List<int>> {
 
   bool _atEnd = false;
 
+  // Whether the stream has been listened to. A socket can only send the file
+  // directly before that.
+  bool _listened = false;
+
+  // Whether the file ending before [_end] is an error instead of the end of
+  // the stream.
+  bool _exact = false;
+
   _FileStream(this._path, int? position, this._end) : _position = position ?? 0;
 
+  _FileStream._exact(String path, int start, int end)
+    : _path = path,
+      _position = start,
+      _end = end,
+      _exact = true;
+
   _FileStream.forStdin() : _position = 0;
 
   _FileStream.forRandomAccessFile(RandomAccessFile f)
@@ -58,6 +75,7 @@ class _FileStream extends Stream<List<int>> {
     void onDone()?,
     bool? cancelOnError,
   }) {
+    _listened = true;
     _controller = new StreamController<Uint8List>(
       sync: true,
       onListen: _start,
@@ -75,6 +93,15 @@ class _FileStream extends Stream<List<int>> {
     );
   }
 
+  String? get path => _path;
+
+  int get start => _position;
+
+  int? get end => _end;
+
+  Stream<List<int>> exactRange(int start, int end) =>
+      _FileStream._exact(_path!, start, end);
+
   Future _closeFile() {
     if (_readInProgress || _closed) {
       return _closeCompleter.future;
@@ -112,8 +139,11 @@ class _FileStream extends Stream<List<int>> {
         return;
       }
     }
-    _openedFile!
-        .read(readBytes)
+    final positionalFile = _positionalFile;
+    final Future<Uint8List> read = positionalFile != null
+        ? positionalFile._readAt(_position, readBytes)
+        : _openedFile!.read(readBytes);
+    read
         .then((block) {
           _readInProgress = false;
           if (_unsubscribed) {
@@ -121,6 +151,17 @@ class _FileStream extends Stream<List<int>> {
             return;
           }
           _position += block.length;
+          if (block.length == 0 && _exact && _position != _end) {
+            _controller.addError(
+              new FileSystemException(
+                "File ended before the requested range was read",
+                _path,
+              ),
+            );
+            _closeFile();
+            _unsubscribed = true;
+            return;
+          }
           // read() may return less than `readBytes` if `_openFile` is a pipe or
           // terminal or if a signal is received. Only a empty return indicates
           // that the write side of the pipe is closed or that we are at the end
@@ -190,9 +231,15 @@ class _FileStream extends Stream<List<int>> {
     if (openedFile != null) {
       onOpenFile(openedFile);
     } else if (path != null) {
-      new File(
-        path,
-      ).open(mode: FileMode.read).then(onOpenFile, onError: openFailed);
+      new File(path).open(mode: FileMode.read).then((file) {
+        if (file is _RandomAccessFile) {
+          // No need to set the file position before reading.
+          _positionalFile = file;
+          onReady(file);
+        } else {
+          onOpenFile(file);
+        }
+      }, onError: openFailed);
     } else {
       try {
         onOpenFile(_File._openStdioSync(0));
@@ -601,7 +648,36 @@ class _File extends FileSystemEntity implements File {
     return new IOSink(consumer, encoding: encoding);
   }
 
+  static final _IOServiceBatch _readFilesBatch = new _IOServiceBatch(
+    _IOService.fileReadFiles,
+  );
+
+  // Indexed by the step that failed. Must be kept in sync with
+  // ReadFilesStage in runtime/bin/file.cc.
+  static const List<String> _readFilesErrorMessages = [
+    "Cannot open file",
+    "Cannot retrieve length of file",
+    "readInto failed",
+  ];
+
   Future<Uint8List> readAsBytes() {
+    // Files read at about the same time are opened and read together, in a
+    // single request.
+    return _readFilesBatch.dispatch(_rawPath).then((response) {
+      if (response is Uint8List) return response;
+      if (response is List<Object?>) {
+        _checkForErrorResponse(
+          response[1],
+          _readFilesErrorMessages[response[0] as int],
+          path,
+        );
+      }
+      // The length of the file is not known in advance.
+      return _readAsBytesInChunks();
+    });
+  }
+
+  Future<Uint8List> _readAsBytesInChunks() {
     Future<Uint8List> readUnsized(RandomAccessFile file) {
       var builder = new BytesBuilder(copy: false);
       var completer = new Completer<Uint8List>();
@@ -903,6 +979,19 @@ class _RandomAccessFile implements RandomAccessFile {
     });
   }
 
+  // Reads at most [bytes] bytes at [position] in the file. Unlike [read], it
+  // does not use the file position, and does not move it except on Windows.
+  Future<Uint8List> _readAt(int position, int bytes) {
+    return _dispatch(_IOService.fileReadAt, [null, position, bytes]).then((
+      response,
+    ) {
+      _checkForErrorResponse(response, "read failed", path);
+      var result = (response as List<Object?>)[1] as Uint8List;
+      _resourceInfo.addRead(result.length);
+      return result;
+    });
+  }
+
   Uint8List readSync(int bytes) {
     // TODO(40614): Remove once non-nullability is sound.
     ArgumentError.checkNotNull(bytes, "bytes");
@@ -164,25 +164,26 @@ interface class FileStat {
     if (Platform.isWindows) {
       path = FileSystemEntity._trimTrailingPathSeparators(path);
     }
-    return _File._dispatchWithNamespace(_IOService.fileStat, [null, path]).then(
-      (response) {
-        if (response is List<Object?> && response[0] != _successResponse) {
-          return FileStat._notFound;
-        }
-        // Unwrap the real list from the "I'm not an error" wrapper.
-        var data = (response as List)[1] as List<Object?>;
-        return FileStat._internal(
-          DateTime.fromMillisecondsSinceEpoch(data[_changedTime] as int),
-          DateTime.fromMillisecondsSinceEpoch(data[_modifiedTime] as int),
-          DateTime.fromMillisecondsSinceEpoch(data[_accessedTime] as int),
-          FileSystemEntityType._lookup(data[_type] as int),
-          data[_mode] as int,
-          data[_size] as int,
-        );
-      },
-    );
+    // Paths stat'ed at about the same time are stat'ed together, in a single
+    // request.
+    return _statFilesBatch.dispatch(path).then((response) {
+      if (response == null) return FileStat._notFound;
+      var data = response as List<Object?>;
+      return FileStat._internal(
+        DateTime.fromMillisecondsSinceEpoch(data[_changedTime] as int),
+        DateTime.fromMillisecondsSinceEpoch(data[_modifiedTime] as int),
+        DateTime.fromMillisecondsSinceEpoch(data[_accessedTime] as int),
+        FileSystemEntityType._lookup(data[_type] as int),
+        data[_mode] as int,
+        data[_size] as int,
+      );
+    });
   }
 
+  static final _IOServiceBatch _statFilesBatch = new _IOServiceBatch(
+    _IOService.fileStatFiles,
+  );
+
   String toString() => """
 FileStat: type $type
           changed $changed
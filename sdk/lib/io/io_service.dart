@@ -50,6 +50,64 @@ class _IOService {
   static const int directoryListStop = 41;
   static const int directoryRename = 42;
   static const int sslProcessFilter = 43;
+  static const int fileReadAt = 44;
+  static const int fileReadFiles = 45;
+  static const int fileStatFiles = 46;
 
   external static Future<Object?> _dispatch(int request, List data);
 }
+
+/// Sends the requests of one kind made during a microtask to the IOService
+/// together, as a single request.
+///
+/// The request is dispatched with the namespace followed by one argument per
+/// caller, and its response is a list with the result for each argument.
+class _IOServiceBatch {
+  static const int _maxLength = 64;
+
+  final int _request;
+  List<Object?>? _arguments;
+  List<Completer<Object?>>? _completers;
+
+  _IOServiceBatch(this._request);
+
+  Future<Object?> dispatch(Object argument) {
+    var arguments = _arguments;
+    var completers = _completers;
+    if (arguments == null || completers == null) {
+      arguments = _arguments = <Object?>[null];
+      completers = _completers = <Completer<Object?>>[];
+      scheduleMicrotask(_send);
+    }
+    var completer = new Completer<Object?>();
+    arguments.add(argument);
+    completers.add(completer);
+    if (completers.length == _maxLength) _send();
+    return completer.future;
+  }
+
+  void _send() {
+    var arguments = _arguments;
+    var completers = _completers;
+    if (arguments == null || completers == null) return;
+    _arguments = null;
+    _completers = null;
+    _File._dispatchWithNamespace(_request, arguments).then(
+      (response) {
+        if (response is! List<Object?> ||
+            response.length != completers.length) {
+          throw new StateError("Unexpected response to request $_request");
+        }
+        for (int i = 0; i < completers.length; i++) {
+          completers[i].complete(response[i]);
+        }
+      },
+    ).catchError((Object error, StackTrace stackTrace) {
+      for (var completer in completers) {
+        if (!completer.isCompleted) {
+          completer.completeError(error, stackTrace);
+        }
+      }
+    });
+  }
+}
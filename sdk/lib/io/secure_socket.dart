@@ -588,6 +588,9 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   bool _connectPending = true;
   bool _filterPending = false;
   bool _filterActive = false;
+  // Whether the kernel encrypts the data written to [_socket].
+  bool _kernelTls = false;
+  bool _kernelTlsTried = false;
 
   _SecureFilter? _secureFilter = _SecureFilter._();
   String? _selectedProtocol;
@@ -837,7 +840,13 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   void set writeEventsEnabled(bool value) {
     _writeEventsEnabled = value;
     if (value) {
-      Timer.run(() => _sendWriteEvent());
+      if (_kernelTls) {
+        // Writes go straight to the network socket, so wait until it can
+        // take more data.
+        _socket.writeEventsEnabled = true;
+      } else {
+        Timer.run(() => _sendWriteEvent());
+      }
     }
   }
 
@@ -892,6 +901,13 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
     if (_status != connectedStatus) return 0;
     bytes ??= data.length - offset;
 
+    if (_kernelTls) {
+      int written = _socket.write(data, offset, bytes);
+      if (written < bytes) {
+        _socket.writeEventsEnabled = true;
+      }
+      return written;
+    }
     int written = _secureFilter!.buffers![writePlaintextId].write(
       data,
       offset,
@@ -956,6 +972,9 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   void _writeHandler() {
     _writeSocket();
     _scheduleFilter();
+    if (_kernelTls) {
+      _sendWriteEvent();
+    }
   }
 
   void _doneHandler() {
@@ -1121,6 +1140,12 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
         if (_status == closedStatus) {
           return;
         }
+        if (!_kernelTlsTried &&
+            _status == connectedStatus &&
+            _filterStatus.writeEmpty) {
+          _kernelTlsTried = true;
+          _kernelTls = _secureFilter!.enableKernelTls(_socket);
+        }
         if (_filterStatus.progress) {
           _filterPending = true;
           if (_filterStatus.writeEncryptedNoLongerEmpty) {
@@ -1180,6 +1205,17 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   void _writeSocket() {
     if (_socketClosedWrite) return;
     var buffer = _secureFilter!.buffers![writeEncryptedId];
+    if (_kernelTls) {
+      // Records produced by BoringSSL after the switch, like alerts or key
+      // updates, would be encrypted a second time by the kernel.
+      if (!buffer.isEmpty) {
+        _reportError(
+          TlsException("Cannot send TLS records on a kernel TLS socket"),
+          StackTrace.current,
+        );
+      }
+      return;
+    }
     if (buffer.readToSocket(_socket)) {
       // Returns true if blocked
       _socket.writeEventsEnabled = true;
@@ -1222,6 +1258,10 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
     }
   }
 
+  // The network socket that plaintext can be written to directly, because
+  // the kernel encrypts it.
+  RawSocket? get _kernelTlsSocket => _kernelTls ? _socket : null;
+
   Future<_FilterStatus> _pushAllFilterStages() async {
     bool wasInHandshake = _status != connectedStatus;
     List args = List<dynamic>.filled(2 + bufferCount * 2, null);
@@ -1449,6 +1489,10 @@ abstract class _SecureFilter {
   void registerHandshakeCompleteCallback(Function handshakeCompleteHandler);
   void registerKeyLogPort(SendPort port);
 
+  // Lets the kernel encrypt the data written to [socket] from now on.
+  // Returns false if it cannot, and the filter keeps encrypting.
+  bool enableKernelTls(RawSocket socket);
+
   // This call may cause a reference counted pointer in the native
   // implementation to be retained. It should only be called when the resulting
   // value is passed to the IO service through a call to dispatch().
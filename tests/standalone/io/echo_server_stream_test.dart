@@ -8,6 +8,8 @@
 // VMOptions=--short_socket_read
 // VMOptions=--short_socket_write
 // VMOptions=--short_socket_read --short_socket_write
+// VMOptions=--io_uring
+// VMOptions=--event_handler_threads=4
 
 library ServerTest;
 
@@ -0,0 +1,111 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--io_uring
+//
+// Tests that files read and stat'ed at the same time, which are handled
+// together in single requests, each get their own result.
+
+import "dart:async";
+import "dart:io";
+import "dart:math";
+import "dart:typed_data";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int numberOfFiles = 150;
+
+Uint8List makeContent(int index) {
+  final length = (index * 997) % 20000;
+  final content = Uint8List(length);
+  for (int i = 0; i < length; i++) {
+    content[i] = (i + index) & 0xff;
+  }
+  return content;
+}
+
+Future<void> testReadAsBytes(Directory directory) async {
+  final files = <File>[];
+  for (int i = 0; i < numberOfFiles; i++) {
+    files.add(File("${directory.path}/$i")..writeAsBytesSync(makeContent(i)));
+  }
+  final contents = await Future.wait([
+    for (final file in files) file.readAsBytes(),
+  ]);
+  for (int i = 0; i < numberOfFiles; i++) {
+    Expect.listEquals(makeContent(i), contents[i]);
+  }
+
+  // Failures only affect the file that failed.
+  final missing = File("${directory.path}/missing").readAsBytes();
+  final isDirectory = File(directory.path).readAsBytes();
+  final present = files[7].readAsBytes();
+  final error = await asyncExpectThrows<FileSystemException>(missing);
+  Expect.equals("Cannot open file", error.message);
+  await asyncExpectThrows<FileSystemException>(isDirectory);
+  Expect.listEquals(makeContent(7), await present);
+}
+
+Future<void> testReadUnknownLength() async {
+  if (!Platform.isLinux) return;
+  // Files in /proc report a length of zero.
+  final results = await Future.wait([
+    File("/proc/self/status").readAsString(),
+    File("/proc/self/stat").readAsString(),
+  ]);
+  Expect.isTrue(results[0].contains("Name:"));
+  Expect.isTrue(results[1].isNotEmpty);
+}
+
+Future<void> testStat(Directory directory) async {
+  final stats = await Future.wait([
+    for (int i = 0; i < numberOfFiles; i++)
+      FileStat.stat("${directory.path}/$i"),
+    FileStat.stat("${directory.path}/missing"),
+    FileStat.stat(directory.path),
+  ]);
+  for (int i = 0; i < numberOfFiles; i++) {
+    Expect.equals(FileSystemEntityType.file, stats[i].type);
+    Expect.equals(makeContent(i).length, stats[i].size);
+  }
+  Expect.equals(FileSystemEntityType.notFound, stats[numberOfFiles].type);
+  Expect.equals(FileSystemEntityType.directory, stats[numberOfFiles + 1].type);
+}
+
+Future<void> testOpenRead(Directory directory) async {
+  final content = Uint8List(300000);
+  for (int i = 0; i < content.length; i++) {
+    content[i] = (i * 7) & 0xff;
+  }
+  final file = File("${directory.path}/large")..writeAsBytesSync(content);
+  for (final (start, end) in [
+    (null, null),
+    (1000, null),
+    (70000, 200000),
+    (content.length - 10, content.length + 100),
+    (content.length + 10, null),
+  ]) {
+    final builder = BytesBuilder();
+    await file.openRead(start, end).forEach(builder.add);
+    final from = min(start ?? 0, content.length);
+    final to = min(end ?? content.length, content.length);
+    Expect.listEquals(content.sublist(from, to), builder.takeBytes());
+  }
+}
+
+main() async {
+  asyncStart();
+  final directory = Directory.systemTemp.createTempSync("file_read_batch");
+  try {
+    await testReadAsBytes(directory);
+    await testReadUnknownLength();
+    await testStat(directory);
+    await testOpenRead(directory);
+  } finally {
+    directory.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests that attached processes, which are started with posix_spawn on Linux,
+// report their exit codes even when many of them are started at once and
+// exit right away, and that setup errors are reported.
+
+import "dart:async";
+import "dart:io";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+import "process_test_util.dart";
+
+Future<void> testManyExitCodes() async {
+  final futures = <Future<void>>[];
+  for (int i = 0; i < 64; i++) {
+    futures.add(
+      Process.start(getProcessTestFileName(), ["0", "0", "$i", "0"]).then((
+        process,
+      ) async {
+        process.stdout.drain();
+        process.stderr.drain();
+        Expect.equals(i, await process.exitCode);
+      }),
+    );
+  }
+  await Future.wait(futures);
+}
+
+Future<void> testOutputAndWorkingDirectory() async {
+  final directory = Directory.systemTemp.createTempSync("process_spawn");
+  try {
+    final result = await Process.run(
+      getProcessTestFileName(),
+      const ["0", "3", "7", "0"],
+      workingDirectory: directory.path,
+    );
+    Expect.equals(7, result.exitCode);
+    Expect.equals("", result.stderr);
+  } finally {
+    directory.deleteSync();
+  }
+}
+
+Future<void> testInheritStdio() async {
+  final process = await Process.start(
+    getProcessTestFileName(),
+    const ["0", "0", "3", "0"],
+    mode: ProcessStartMode.inheritStdio,
+  );
+  Expect.equals(3, await process.exitCode);
+}
+
+Future<void> testStartErrors() async {
+  await asyncExpectThrows<ProcessException>(
+    Process.start("${getProcessTestFileName()}_does_not_exist", []),
+  );
+  await asyncExpectThrows<ProcessException>(
+    Process.start(
+      getProcessTestFileName(),
+      const ["0", "0", "0", "0"],
+      workingDirectory: "/does/not/exist",
+    ),
+  );
+  // Processes started after failed ones are still counted.
+  await testManyExitCodes();
+}
+
+main() async {
+  asyncStart();
+  await testManyExitCodes();
+  await testOutputAndWorkingDirectory();
+  await testInheritStdio();
+  await testStartErrors();
+  asyncEnd();
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests that a burst of datagrams queued on a socket, which are received in
+// batches, are all delivered in order with their sender.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int count = 50;
+
+main() async {
+  asyncStart();
+  var address = InternetAddress.loopbackIPv4;
+  var sender = await RawDatagramSocket.bind(address, 0);
+  var receiver = await RawDatagramSocket.bind(address, 0);
+
+  // Queue all datagrams before listening so they are read in batches.
+  receiver.readEventsEnabled = false;
+  for (int i = 0; i < count; i++) {
+    // Include empty datagrams, which are never returned by receive.
+    var length = i % 10 == 0 ? 0 : i;
+    Expect.equals(
+      length,
+      sender.send(
+        Uint8List(length)..fillRange(0, length, i),
+        address,
+        receiver.port,
+      ),
+    );
+  }
+  await Future.delayed(const Duration(milliseconds: 100));
+
+  int expected = 1;
+  receiver.readEventsEnabled = true;
+  receiver.listen((event) {
+    if (event != RawSocketEvent.read) return;
+    Datagram? datagram;
+    while ((datagram = receiver.receive()) != null) {
+      Expect.equals(expected, datagram!.data.length);
+      Expect.isTrue(datagram.data.every((byte) => byte == expected));
+      Expect.equals(sender.port, datagram.port);
+      Expect.equals(address, datagram.address);
+      expected++;
+      if (expected % 10 == 0) expected++;
+    }
+    if (expected >= count) {
+      sender.close();
+      receiver.close();
+      asyncEnd();
+    }
+  });
+}
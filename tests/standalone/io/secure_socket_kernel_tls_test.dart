@@ -0,0 +1,125 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--kernel_tls
+// VMOptions=--kernel_tls --short_socket_write
+// OtherResources=certificates/server_chain.pem
+// OtherResources=certificates/server_key.pem
+// OtherResources=certificates/trusted_certs.pem
+//
+// Tests that data written to secure sockets arrives complete when the kernel
+// takes over encryption, and when it cannot. Where the kernel reports its TLS
+// statistics, also checks that it was used exactly when enabled.
+
+import "dart:async";
+import "dart:io";
+import "dart:math";
+import "dart:typed_data";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+String localFile(path) => Platform.script.resolve(path).toFilePath();
+
+SecurityContext serverContext = SecurityContext()
+  ..useCertificateChain(localFile('certificates/server_chain.pem'))
+  ..usePrivateKey(
+    localFile('certificates/server_key.pem'),
+    password: 'dartdart',
+  );
+
+SecurityContext clientContext = SecurityContext()
+  ..setTrustedCertificates(localFile('certificates/trusted_certs.pem'));
+
+Uint8List makeContent(int length) {
+  final content = Uint8List(length);
+  for (int i = 0; i < content.length; i++) {
+    content[i] = (i * 17) & 0xff;
+  }
+  return content;
+}
+
+Future<void> testEcho(Uint8List content) async {
+  final server = await SecureServerSocket.bind("localhost", 0, serverContext);
+  server.listen((socket) {
+    socket.listen(socket.add, onDone: socket.close);
+  });
+
+  final socket = await SecureSocket.connect(
+    "localhost",
+    server.port,
+    context: clientContext,
+  );
+  final received = BytesBuilder();
+  final done = socket.forEach(received.add);
+  // Writes before and after the handshake completes.
+  for (int i = 0; i < content.length; i += 10000) {
+    socket.add(content.sublist(i, min(i + 10000, content.length)));
+    if (i % 100000 == 0) await Future.delayed(Duration.zero);
+  }
+  await socket.close();
+  await done;
+  await server.close();
+  Expect.listEquals(content, received.takeBytes());
+}
+
+Future<void> testHttpsFile(Uint8List content) async {
+  final directory = Directory.systemTemp.createTempSync("kernel_tls");
+  final file = File("${directory.path}/data")..writeAsBytesSync(content);
+  final server = await HttpServer.bindSecure("localhost", 0, serverContext);
+  server.listen((request) async {
+    request.response.contentLength = content.length;
+    await request.response.addStream(file.openRead());
+    await request.response.close();
+  });
+
+  final client = HttpClient(context: clientContext);
+  try {
+    for (int i = 0; i < 3; i++) {
+      final request = await client.get("localhost", server.port, "/");
+      final response = await request.close();
+      final builder = BytesBuilder();
+      await response.forEach(builder.add);
+      Expect.listEquals(content, builder.takeBytes());
+    }
+  } finally {
+    client.close(force: true);
+    await server.close(force: true);
+    directory.deleteSync(recursive: true);
+  }
+}
+
+// The number of sockets the kernel has encrypted writes for since boot, or
+// null if it does not report it.
+int? kernelTlsTxCount() {
+  final stats = File("/proc/net/tls_stat");
+  if (!Platform.isLinux || !stats.existsSync()) return null;
+  int count = 0;
+  for (final line in stats.readAsLinesSync()) {
+    final fields = line.split(RegExp(r"\s+"));
+    if (fields.length == 2 &&
+        (fields[0] == "TlsTxSw" || fields[0] == "TlsTxDevice")) {
+      count += int.parse(fields[1]);
+    }
+  }
+  return count;
+}
+
+main() async {
+  asyncStart();
+  final enabled = Platform.executableArguments.contains("--kernel_tls");
+  final before = kernelTlsTxCount();
+  final content = makeContent(1 << 20);
+  await testEcho(content);
+  await testHttpsFile(content);
+  final after = kernelTlsTxCount();
+  // The statistics only exist once the kernel TLS module is loaded, which
+  // may happen on first use. Without it, the sockets keep encrypting in user
+  // space, which the transfers above already cover.
+  if (enabled && after != null) {
+    Expect.isTrue(after > (before ?? 0), "kernel TLS was not engaged");
+  }
+  asyncEnd();
+}
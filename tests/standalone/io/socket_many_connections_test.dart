@@ -1,6 +1,10 @@
 // Copyright (c) 2012, the Dart project authors.  Please see the AUTHORS file
 // for details. All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--io_uring
+// VMOptions=--event_handler_threads=4
 
 // Test creating a large number of socket connections.
 library ServerTest;
@@ -0,0 +1,119 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--short_socket_write
+//
+// Tests that file streams added to sockets and HTTP responses, which are sent
+// directly from the file where supported, arrive complete.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+Future<Uint8List> sendOverSocket(Stream<List<int>> stream) async {
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  final received = server.first.then((socket) async {
+    final builder = BytesBuilder();
+    await socket.forEach(builder.add);
+    socket.destroy();
+    return builder.takeBytes();
+  });
+  final client = await Socket.connect(
+    InternetAddress.loopbackIPv4,
+    server.port,
+  );
+  client.add([1, 2, 3]);
+  await client.addStream(stream);
+  client.add([4, 5, 6]);
+  await client.close();
+  client.destroy();
+  await server.close();
+  return received;
+}
+
+// The data sent by [sendOverSocket] around the stream.
+List<int> framed(List<int> data) => [1, 2, 3, ...data, 4, 5, 6];
+
+Future<void> testSocket(File file, Uint8List content) async {
+  Expect.listEquals(
+    framed(content),
+    await sendOverSocket(file.openRead()),
+  );
+  Expect.listEquals(
+    framed(content.sublist(1000, 200000)),
+    await sendOverSocket(file.openRead(1000, 200000)),
+  );
+  // A range past the end of the file stops at the end of the file.
+  final start = content.length - 10;
+  Expect.listEquals(
+    framed(content.sublist(start)),
+    await sendOverSocket(file.openRead(start, 1 << 40)),
+  );
+}
+
+Future<void> testHttp(File file, Uint8List content) async {
+  final server = await HttpServer.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((request) async {
+    final response = request.response;
+    var stream = file.openRead();
+    if (request.uri.path == "/short") {
+      // The file is longer than the content length.
+      response.contentLength = 10;
+    } else if (request.uri.path == "/range") {
+      response.contentLength = 199000;
+      stream = file.openRead(1000, 200000);
+    } else {
+      response.contentLength = content.length;
+    }
+    try {
+      await response.addStream(stream);
+    } catch (_) {}
+    await response.close().catchError((_) {});
+  });
+
+  final client = HttpClient();
+  for (int i = 0; i < 3; i++) {
+    final request = await client.get("127.0.0.1", server.port, "/");
+    final response = await request.close();
+    final builder = BytesBuilder();
+    await response.forEach(builder.add);
+    Expect.listEquals(content, builder.takeBytes());
+  }
+
+  final rangeRequest = await client.get("127.0.0.1", server.port, "/range");
+  final rangeResponse = await rangeRequest.close();
+  final rangeBuilder = BytesBuilder();
+  await rangeResponse.forEach(rangeBuilder.add);
+  Expect.listEquals(content.sublist(1000, 200000), rangeBuilder.takeBytes());
+
+  final request = await client.get("127.0.0.1", server.port, "/short");
+  final response = await request.close();
+  final builder = BytesBuilder();
+  await response.forEach(builder.add).catchError((_) {});
+  Expect.isTrue(builder.length <= 10);
+
+  client.close(force: true);
+  await server.close(force: true);
+}
+
+main() async {
+  asyncStart();
+  final directory = Directory.systemTemp.createTempSync("socket_send_file");
+  try {
+    final content = Uint8List(1 << 20);
+    for (int i = 0; i < content.length; i++) {
+      content[i] = (i * 31) & 0xff;
+    }
+    final file = File("${directory.path}/data")..writeAsBytesSync(content);
+    await testSocket(file, content);
+    await testHttp(file, content);
+  } finally {
+    directory.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}
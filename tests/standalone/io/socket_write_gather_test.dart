@@ -0,0 +1,81 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--short_socket_read
+// VMOptions=--short_socket_write
+// VMOptions=--short_socket_read --short_socket_write
+//
+// Tests that buffers queued on a socket while it cannot take more data are
+// written out completely and in order.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+Future<void> testWriteGather() async {
+  final expected = <int>[];
+  final chunks = <List<int>>[];
+  void addChunk(List<int> chunk) {
+    chunks.add(chunk);
+    expected.addAll(chunk);
+  }
+
+  final shared = Uint8List.fromList(List.generate(100, (i) => i));
+  for (int i = 0; i < 2000; i++) {
+    switch (i % 5) {
+      case 0:
+        addChunk(Uint8List(i * 7)..fillRange(0, i * 7, i & 0xff));
+      case 1:
+        // The same buffer several times in a row.
+        addChunk(shared);
+      case 2:
+        addChunk(const <int>[]);
+      case 3:
+        // A view on a larger buffer.
+        final backing = Uint8List.fromList(List.generate(256, (j) => j ^ i));
+        addChunk(Uint8List.sublistView(backing, 16, 16 + i % 200));
+      case 4:
+        addChunk(List<int>.generate(i % 300, (j) => (i + j) & 0xff));
+    }
+  }
+
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  final received = BytesBuilder();
+  final serverDone = Completer<void>();
+  server.listen((socket) {
+    // Read slowly so that the writer has to queue buffers.
+    late StreamSubscription<Uint8List> subscription;
+    subscription = socket.listen(
+      (data) {
+        received.add(data);
+        subscription.pause(Future.delayed(const Duration(milliseconds: 1)));
+      },
+      onDone: () {
+        socket.destroy();
+        serverDone.complete();
+      },
+    );
+  });
+
+  final client = await Socket.connect(InternetAddress.loopbackIPv4, server.port);
+  for (final chunk in chunks) {
+    client.add(chunk);
+  }
+  await client.close();
+  await serverDone.future;
+  await server.close();
+  client.destroy();
+
+  Expect.listEquals(expected, received.takeBytes());
+}
+
+main() async {
+  asyncStart();
+  await testWriteGather();
+  asyncEnd();
+}
@@ -3,6 +3,7 @@
 // BSD-style license that can be found in the LICENSE file.
 
 import 'dart:async';
+import 'dart:convert';
 import 'dart:io';
 import 'dart:typed_data';
 
@@ -250,6 +251,51 @@ void testRoundTripLarge() {
   }
 }
 
+void testParallelRoundTrip() {
+  final data = new Uint8List(1000000);
+  for (var i = 0; i < data.length; i++) {
+    data[i] = (i % 1000 < 500) ? i % 13 : (i * 7919) % 251;
+  }
+  for (var gzip in [true, false]) {
+    for (var raw in [true, false]) {
+      for (var level in [-1, 1, 9]) {
+        final encoder =
+            new ZLibEncoder(gzip: gzip, raw: raw, level: level, threads: 4);
+        final decoder = new ZLibDecoder(gzip: gzip, raw: raw);
+        Expect.listEquals(data, decoder.convert(encoder.convert(data)));
+        Expect.listEquals([], decoder.convert(encoder.convert([])));
+
+        // Input arriving in small chunks.
+        final compressed = <int>[];
+        final sink = encoder.startChunkedConversion(
+            new ChunkedConversionSink<List<int>>.withCallback(
+                (chunks) => chunks.forEach(compressed.addAll)));
+        for (var i = 0; i < data.length; i += 3000) {
+          sink.add(new Uint8List.sublistView(
+              data, i, i + 3000 < data.length ? i + 3000 : data.length));
+        }
+        sink.close();
+        Expect.listEquals(data, decoder.convert(compressed));
+      }
+    }
+  }
+  // GZipCodec.decode takes concatenated members.
+  final codec = new GZipCodec(threads: 3);
+  Expect.listEquals(
+      [...data, ...data], codec.decode(codec.encode(data) + gzip.encode(data)));
+  Expect.throwsRangeError(() => new GZipCodec(threads: 0));
+  Expect.throwsRangeError(
+      () => new GZipCodec(threads: ZLibOption.maxThreads + 1));
+
+  // The gzip header matches the one zlib writes, including the operating
+  // system.
+  for (var level in [1, 6, 9]) {
+    Expect.listEquals(
+        new GZipCodec(level: level).encode(data).sublist(0, 10),
+        new GZipCodec(level: level, threads: 2).encode(data).sublist(0, 10));
+  }
+}
+
 void testZlibWithDictionary() {
   var dict = [102, 111, 111, 98, 97, 114];
   var data = [98, 97, 114, 102, 111, 111];
@@ -353,6 +399,7 @@ void main() {
   testZlibInflateThrowsWithSmallerWindow();
   testZlibInflateWithLargerWindow();
   testRoundTripLarge();
+  testParallelRoundTrip();
   testZlibWithDictionary();
   testConcatenatedBlocksGZip();
   testConcatenatedBlocksZLib();